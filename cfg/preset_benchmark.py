@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Measure the speed / BD-rate trade-off of the encoder speed presets.
+
+Every preset is run at four QPs on each sequence. The BD-rate (luma PSNR) and the
+encoding speed are reported relative to the "slow" preset, which is the shipped
+configuration without any override.
+
+Examples:
+  preset_benchmark.py --encoder ../bin/EncoderApp --input-dir /data/origCfP --sequences FourPeople Johnny --frames 64
+  preset_benchmark.py --encoder ../bin/EncoderApp --input lobby.yuv traffic.yuv --width 416 --height 240 --fps 30 --frames 17
+"""
+
+import argparse
+import math
+import os
+import re
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+PRESETS = ["placebo", "slow", "medium", "fast", "faster", "veryfast", "ultrafast"]
+ANCHOR = "slow"
+CFG_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def parse_log(log):
+    """Returns (kbps, Y-PSNR, seconds) of an encoder log."""
+    lines = log.splitlines()
+    for i, line in enumerate(lines):
+        if "Total Frames" in line:
+            fields = lines[i + 1].split()
+            kbps, psnr = float(fields[2]), float(fields[3])
+            break
+    else:
+        raise RuntimeError("no summary in encoder log")
+    secs = float(re.search(r"Total Time:\s+([\d.]+) sec", log).group(1))
+    return kbps, psnr, secs
+
+
+def fit_cubic(xs, ys):
+    """Least-squares cubic polynomial through the points, coefficients in increasing order."""
+    n = 4
+    ata = [[sum(x ** (i + j) for x in xs) for j in range(n)] for i in range(n)]
+    aty = [sum(y * x ** i for x, y in zip(xs, ys)) for i in range(n)]
+    # Gaussian elimination with partial pivoting
+    for c in range(n):
+        p = max(range(c, n), key=lambda r: abs(ata[r][c]))
+        ata[c], ata[p] = ata[p], ata[c]
+        aty[c], aty[p] = aty[p], aty[c]
+        for r in range(c + 1, n):
+            f = ata[r][c] / ata[c][c]
+            for k in range(c, n):
+                ata[r][k] -= f * ata[c][k]
+            aty[r] -= f * aty[c]
+    coef = [0.0] * n
+    for r in reversed(range(n)):
+        coef[r] = (aty[r] - sum(ata[r][k] * coef[k] for k in range(r + 1, n))) / ata[r][r]
+    return coef
+
+
+def integrate(coef, lo, hi):
+    prim = lambda x: sum(c * x ** (i + 1) / (i + 1) for i, c in enumerate(coef))
+    return prim(hi) - prim(lo)
+
+
+def bd_rate(anchor, test):
+    """Bjontegaard delta rate in percent, points are (kbps, psnr) tuples."""
+    pa, ra = [p for _, p in anchor], [math.log(r) for r, _ in anchor]
+    pt, rt = [p for _, p in test], [math.log(r) for r, _ in test]
+    lo, hi = max(min(pa), min(pt)), min(max(pa), max(pt))
+    if hi <= lo:
+        return float("nan")
+    diff = (integrate(fit_cubic(pt, rt), lo, hi) - integrate(fit_cubic(pa, ra), lo, hi)) / (hi - lo)
+    return (math.exp(diff) - 1) * 100
+
+
+def sequence_args(args, name):
+    """Encoder arguments selecting the input of a sequence."""
+    if args.input:
+        return ["-i", args.inputs[name], "-wdt", str(args.width), "-hgt", str(args.height), "-fr", str(args.fps)]
+    seq_cfg = os.path.join(CFG_DIR, "per-sequence", name + ".cfg")
+    seq_args = ["-c", seq_cfg]
+    if args.input_dir:
+        with open(seq_cfg) as f:
+            m = re.search(r"^InputFile\s*:\s*(\S+)", f.read(), re.M)
+        seq_args += ["-i", os.path.join(args.input_dir, os.path.basename(m.group(1)))]
+    return seq_args
+
+
+def encode(args, name, preset, qp):
+    tag = "%s_%s_%s_q%d" % (name, os.path.splitext(os.path.basename(args.cfg))[0], preset, qp)
+    cmd = [args.encoder, "-c", os.path.join(CFG_DIR, args.cfg)] + sequence_args(args, name)
+    cmd += ["-f", str(args.frames), "-q", str(qp), "--Preset=" + preset,
+            "-b", os.path.join(args.outdir, tag + ".bin"), "-o", ""]
+    log = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True).stdout
+    with open(os.path.join(args.outdir, tag + ".log"), "w") as f:
+        f.write(log)
+    return parse_log(log)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--encoder", required=True, help="EncoderApp binary")
+    parser.add_argument("--cfg", default="encoder_lowdelay_vtm.cfg", help="main configuration file in cfg/")
+    parser.add_argument("--sequences", nargs="+", default=["FourPeople", "Johnny", "KristenAndSara"],
+                        help="sequences from cfg/per-sequence")
+    parser.add_argument("--input-dir", help="directory holding the sequences (default: InputFile of the per-sequence cfg)")
+    parser.add_argument("--input", nargs="+", help="encode these YUV files instead of the per-sequence configurations")
+    parser.add_argument("--width", type=int, default=416)
+    parser.add_argument("--height", type=int, default=240)
+    parser.add_argument("--fps", type=int, default=30)
+    parser.add_argument("--frames", type=int, default=32, help="frames to be encoded per run")
+    parser.add_argument("--qps", type=int, nargs="+", default=[22, 27, 32, 37])
+    parser.add_argument("--presets", nargs="+", default=PRESETS, choices=PRESETS)
+    parser.add_argument("--jobs", type=int, default=1, help="encoder runs in parallel")
+    parser.add_argument("--outdir", default="preset_benchmark", help="directory for bitstreams and logs")
+    args = parser.parse_args()
+
+    presets = args.presets if ANCHOR in args.presets else [ANCHOR] + args.presets
+    args.inputs = {os.path.splitext(os.path.basename(f))[0]: f for f in args.input or []}
+    sequences = list(args.inputs) if args.input else args.sequences
+    os.makedirs(args.outdir, exist_ok=True)
+
+    runs = [(s, p, q) for s in sequences for p in presets for q in args.qps]
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        results = dict(zip(runs, pool.map(lambda r: encode(args, *r), runs)))
+
+    print("%-10s %12s %12s %10s" % ("preset", "BD-rate Y", "time [s]", "speed-up"))
+    for p in presets:
+        bd, secs, anchor_secs = [], 0.0, 0.0
+        for s in sequences:
+            bd.append(bd_rate([results[(s, ANCHOR, q)][:2] for q in args.qps], [results[(s, p, q)][:2] for q in args.qps]))
+            secs += sum(results[(s, p, q)][2] for q in args.qps)
+            anchor_secs += sum(results[(s, ANCHOR, q)][2] for q in args.qps)
+        print("%-10s %11.2f%% %12.1f %9.2fx" % (p, sum(bd) / len(bd), secs, anchor_secs / secs))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
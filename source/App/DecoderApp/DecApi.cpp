@@ -0,0 +1,172 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecApi.cpp
+    \brief    In-process decoder interface
+*/
+
+#include <string>
+#include <vector>
+
+#include "DecApi.h"
+#include "DecoderLib/NALread.h"
+#include "CommonLib/DiagLog.h"
+
+//! \ingroup DecoderApp
+//! \{
+
+DecApi::DecApi()
+  : m_initialized( false )
+  , m_flushed    ( false )
+{
+}
+
+DecApi::~DecApi()
+{
+  destroy();
+}
+
+Bool DecApi::init( Int argc, TChar* argv[], PictureCallback pictureCallback )
+{
+  CHECK( m_initialized, "Decoder already initialized" );
+
+  // the NAL units are pushed by the caller, the option only has to be set
+  std::vector<std::string> args( argv, argv + argc );
+  if( args.empty() )
+  {
+    args.push_back( "DecoderApi" );
+  }
+  args.insert( args.begin() + 1, "--BitstreamFile=-" );
+
+  std::vector<TChar*> cfgArgv;
+  for( auto &arg : args )
+  {
+    cfgArgv.push_back( &arg[0] );
+  }
+
+  if( !parseCfg( Int( cfgArgv.size() ), cfgArgv.data() ) )
+  {
+    return false;
+  }
+
+  // pictures and SEI messages are not written to files
+  m_reconFileName.clear();
+  m_outputDecodedSEIMessagesFilename.clear();
+  m_pictureCallback = pictureCallback;
+
+  xCreateDecLib();
+
+  m_iPOCLastDisplay = -MAX_INT + m_iSkipFrame;
+  m_pcListPic       = NULL;
+  m_openedReconFile = false;
+  m_loopFiltered    = false;
+  m_writeOutput     = true;
+
+  xCreateBgPictures();
+
+  m_flushed     = false;
+  m_initialized = true;
+  return true;
+}
+
+Void DecApi::destroy()
+{
+  if( !m_initialized )
+  {
+    return;
+  }
+
+  m_cDecLib.deletePicBuffer();
+  xDestroyBgPictures();
+  xDestroyDecLib();
+  destroyROM();
+  DiagLog::flush();
+
+  m_initialized = false;
+}
+
+Void DecApi::pushNalUnit( const UChar* data, size_t size )
+{
+  CHECK( !m_initialized || m_flushed, "The decoder does not accept NAL units" );
+
+  if( size == 0 )
+  {
+    msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n" );
+    return;
+  }
+
+  // the first slice of a new picture is decoded again once the previous picture is finished
+  Bool bNewPicture;
+  do
+  {
+    InputNALUnit nalu;
+    read( nalu, data, size );
+
+    bNewPicture = xDecodeNalu( nalu );
+    xOutputPictures( nalu, bNewPicture, false );
+  }
+  while( bNewPicture );
+}
+
+Void DecApi::flush()
+{
+  if( !m_initialized || m_flushed )
+  {
+    return;
+  }
+
+  InputNALUnit nalu;
+  nalu.m_nalUnitType = NAL_UNIT_INVALID;
+
+  xOutputPictures( nalu, false, true );
+  xFlushOutput( m_pcListPic );
+  m_flushed = true;
+}
+
+Void DecApi::xWriteRecon( const Picture& pic, const Window& conf, const Window& defDisp )
+{
+  Window crop;
+  crop.setWindow( conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(), conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                  conf.getWindowTopOffset()  + defDisp.getWindowTopOffset(),  conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset() );
+
+  m_pictureCallback( pic, crop );
+}
+
+Void DecApi::xWriteRecon( const Picture& picTop, const Picture& picBottom, const Window& conf, const Window& defDisp, Bool isTff )
+{
+  xWriteRecon( isTff ? picTop : picBottom, conf, defDisp );
+  xWriteRecon( isTff ? picBottom : picTop, conf, defDisp );
+}
+
+//! \}
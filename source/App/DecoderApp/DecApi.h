@@ -0,0 +1,88 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecApi.h
+    \brief    In-process decoder interface (header)
+*/
+
+#ifndef __DECAPI__
+#define __DECAPI__
+
+#include <functional>
+
+#include "DecApp.h"
+
+//! \ingroup DecoderApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+  In-process decoder: NAL units are pushed from memory and every output picture is handed to a
+  callback in output order, without any file I/O. The decoder is configured with the same options
+  as the decoder application; the file options are ignored. The background pictures and the
+  related state are owned by the decoder.
+ */
+class DecApi : private DecApp
+{
+public:
+  /// receives an output picture, which is only valid during the call; crop combines the conformance
+  /// and (if enabled) the default display window, in luma samples
+  typedef std::function<Void( const Picture& pic, const Window& crop )> PictureCallback;
+
+  DecApi();
+  virtual ~DecApi();
+
+  Bool  init                     ( Int argc, TChar* argv[], PictureCallback pictureCallback ); ///< configure and create the decoder, false on configuration errors
+  Void  destroy                  ();
+
+  Void  pushNalUnit              ( const UChar* data, size_t size ); ///< decode a NAL unit, given without start code prefix
+  Void  flush                    ();                                 ///< end of the bitstream, outputs all remaining pictures
+
+  UInt  getNumberOfChecksumErrors() const { return m_cDecLib.getNumberOfChecksumErrorsDetected(); }
+
+private:
+  virtual Void xWriteRecon       ( const Picture& pic, const Window& conf, const Window& defDisp );
+  virtual Void xWriteRecon       ( const Picture& picTop, const Picture& picBottom, const Window& conf, const Window& defDisp, Bool isTff );
+
+  PictureCallback m_pictureCallback;
+  Bool            m_initialized;
+  Bool            m_flushed;
+};
+
+//! \}
+
+#endif // __DECAPI__
@@ -0,0 +1,147 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecApiC.cpp
+    \brief    C interface of the in-process decoder
+*/
+
+#include "DecApiC.h"
+#include "DecApi.h"
+
+struct DecApiDecoder
+{
+  DecApi decoder;
+};
+
+static Void xPictureCallback( DecApiPictureCallback pictureCallback, void* userData, const Picture& pic, const Window& crop )
+{
+  const CPelUnitBuf buf       = pic.getRecoBuf();
+  const BitDepths&  bitDepths = pic.cs->sps->getBitDepths();
+
+  DecApiPicture out;
+  for( UInt comp = 0; comp < 3; comp++ )
+  {
+    out.planes [comp] = NULL;
+    out.strides[comp] = 0;
+  }
+  for( UInt comp = 0; comp < getNumberValidComponents( pic.chromaFormat ); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    const UInt        scaleX = getComponentScaleX( compID, pic.chromaFormat );
+    const UInt        scaleY = getComponentScaleY( compID, pic.chromaFormat );
+    const CPelBuf&    plane  = buf.get( compID );
+
+    out.planes [comp] = plane.bufAt( crop.getWindowLeftOffset() >> scaleX, crop.getWindowTopOffset() >> scaleY );
+    out.strides[comp] = plane.stride;
+  }
+  out.width          = buf.Y().width  - crop.getWindowLeftOffset() - crop.getWindowRightOffset();
+  out.height         = buf.Y().height - crop.getWindowTopOffset()  - crop.getWindowBottomOffset();
+  out.chromaFormat   = pic.chromaFormat;
+  out.bitDepthLuma   = bitDepths.recon[CHANNEL_TYPE_LUMA];
+  out.bitDepthChroma = bitDepths.recon[CHANNEL_TYPE_CHROMA];
+  out.bytesPerSample = sizeof( Pel );
+  out.poc            = pic.getPOC();
+
+  pictureCallback( userData, &out );
+}
+
+DecApiDecoder* decapi_create( int argc, char* argv[], DecApiPictureCallback pictureCallback, void* userData )
+{
+  DecApiDecoder* dec = NULL;
+  try
+  {
+    dec = new DecApiDecoder;
+    if( !dec->decoder.init( argc, argv, [=]( const Picture& pic, const Window& crop ) { xPictureCallback( pictureCallback, userData, pic, crop ); } ) )
+    {
+      delete dec;
+      dec = NULL;
+    }
+  }
+  catch( ... )
+  {
+    delete dec;
+    dec = NULL;
+  }
+  return dec;
+}
+
+void decapi_destroy( DecApiDecoder* dec )
+{
+  try
+  {
+    delete dec;
+  }
+  catch( ... )
+  {
+  }
+}
+
+int decapi_push_nal_unit( DecApiDecoder* dec, const unsigned char* data, size_t size )
+{
+  if( !dec )
+  {
+    return -1;
+  }
+  try
+  {
+    dec->decoder.pushNalUnit( data, size );
+  }
+  catch( ... )
+  {
+    return -1;
+  }
+  return 0;
+}
+
+int decapi_flush( DecApiDecoder* dec )
+{
+  if( !dec )
+  {
+    return -1;
+  }
+  try
+  {
+    dec->decoder.flush();
+  }
+  catch( ... )
+  {
+    return -1;
+  }
+  return 0;
+}
+
+unsigned int decapi_get_checksum_errors( const DecApiDecoder* dec )
+{
+  return dec ? dec->decoder.getNumberOfChecksumErrors() : 0;
+}
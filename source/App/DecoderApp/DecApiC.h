@@ -0,0 +1,84 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DecApiC.h
+    \brief    C interface of the in-process decoder
+*/
+
+#ifndef __DECAPIC__
+#define __DECAPIC__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DecApiDecoder DecApiDecoder;
+
+/// output picture, cropped to the conformance (and default display) window; strides are in samples
+typedef struct DecApiPicture
+{
+  const void* planes[3];
+  int         strides[3];
+  int         width;          ///< luma width
+  int         height;         ///< luma height
+  int         chromaFormat;   ///< 0: 400, 1: 420, 2: 422, 3: 444
+  int         bitDepthLuma;
+  int         bitDepthChroma;
+  int         bytesPerSample;
+  int         poc;
+} DecApiPicture;
+
+/// receives an output picture in output order, the samples are only valid during the call
+typedef void (*DecApiPictureCallback)( void* userData, const DecApiPicture* pic );
+
+/// create a decoder configured with the options of the decoder application, NULL on errors
+DecApiDecoder* decapi_create                ( int argc, char* argv[], DecApiPictureCallback pictureCallback, void* userData );
+void           decapi_destroy               ( DecApiDecoder* dec );
+
+/// decode a NAL unit, given without start code prefix
+int            decapi_push_nal_unit         ( DecApiDecoder* dec, const unsigned char* data, size_t size );
+
+/// end of the bitstream, outputs all remaining pictures
+int            decapi_flush                 ( DecApiDecoder* dec );
+
+/// number of pictures whose decoded picture hash did not match
+unsigned int   decapi_get_checksum_errors   ( const DecApiDecoder* dec );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DECAPIC__
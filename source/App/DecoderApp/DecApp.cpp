@@ -43,6 +43,8 @@
 #include "DecApp.h"
 #include "DecoderLib/AnnexBread.h"
 #include "DecoderLib/NALread.h"
+#include "CommonLib/BufferPool.h"
+#include "CommonLib/DiagLog.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
@@ -58,7 +60,14 @@
 
 DecApp::DecApp()
 : m_iPOCLastDisplay(-MAX_INT)
+, m_pcListPic(NULL)
+, m_loopFiltered(false)
+, m_openedReconFile(false)
+, m_writeOutput(false)
 {
+#if BG_REFERENCE_SUBSTITUTION
+  rcPicYuvTemp = NULL;
+#endif
 }
 
 // ====================================================================================================================
@@ -75,13 +84,22 @@ DecApp::DecApp()
  */
 UInt DecApp::decode()
 {
-  Int                 poc;
-  PicList* pcListPic = NULL;
-
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  ifstream             bitstreamFile;
+  MappedInputByteStream mappedBitstream;
+  if (m_memoryMappedInput)
   {
-    EXIT( "failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+    if (!mappedBitstream.open(m_bitstreamFileName))
+    {
+      EXIT( "failed to map bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+    }
+  }
+  else
+  {
+    bitstreamFile.open(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
+    if (!bitstreamFile)
+    {
+      EXIT( "failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+    }
   }
 
   InputByteStream bytestream(bitstreamFile);
@@ -110,11 +128,166 @@ UInt DecApp::decode()
     }
   }
 
+  if (!m_reconFileName.empty())
+  {
+    m_reconWriter.start( m_asyncOutputFrames );
+  }
+
   // main decoder loop
-  Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
-  Bool loopFiltered = false;
-  /*================================================*/
+  m_pcListPic       = NULL;
+  m_openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
+  m_loopFiltered    = false;
+  m_writeOutput     = !m_reconFileName.empty();
+
+  xCreateBgPictures();
+
+  while (m_memoryMappedInput ? !mappedBitstream.eof() : !!bitstreamFile)
+  {
+    /* location serves to work around a design fault in the decoder, whereby
+     * the process of reading a new slice that is the first slice of a new frame
+     * requires the DecApp::decode() method to be called again with the same
+     * nal unit. */
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
+    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
+#else
+    streampos location = bitstreamFile.tellg();
+#endif
+    std::size_t mappedLocation = mappedBitstream.getPosition();
+    AnnexBStats stats = AnnexBStats();
 
+    InputNALUnit   nalu;
+    const uint8_t* nalUnitData = nullptr;
+    std::size_t    nalUnitSize = 0;
+    if (m_memoryMappedInput)
+    {
+      // the NAL unit stays in the mapping, it is only copied when converting it to the RBSP
+      byteStreamNALUnit(mappedBitstream, nalUnitData, nalUnitSize, stats);
+    }
+    else
+    {
+      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+      nalUnitSize = nalu.getBitstream().getFifo().size();
+    }
+
+    // call actual decoding function
+    Bool bNewPicture = false;
+    if (nalUnitSize == 0)
+    {
+      /* this can happen if the following occur:
+       *  - empty input file
+       *  - two back-to-back start_code_prefixes
+       *  - start_code_prefix immediately followed by EOF
+       */
+      msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
+    }
+    else
+    {
+      if (m_memoryMappedInput)
+      {
+        read(nalu, nalUnitData, nalUnitSize);
+      }
+      else
+      {
+        read(nalu);
+      }
+
+      bNewPicture = xDecodeNalu( nalu );
+      if (bNewPicture && m_memoryMappedInput)
+      {
+        mappedBitstream.setPosition(mappedLocation);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+        CodingStatistics::SetStatistics(*backupStats);
+#endif
+      }
+      else if (bNewPicture)
+      {
+        bitstreamFile.clear();
+        /* location points to the current nalunit payload[1] due to the
+         * need for the annexB parser to read three extra bytes.
+         * [1] except for the first NAL unit in the file
+         *     (but bNewPicture doesn't happen then) */
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+        bitstreamFile.seekg(location);
+        bytestream.reset();
+        CodingStatistics::SetStatistics(*backupStats);
+#else
+        bitstreamFile.seekg(location-streamoff(3));
+        bytestream.reset();
+#endif
+      }
+    }
+
+    const Bool endOfBitstream = m_memoryMappedInput ? mappedBitstream.eof() : !bitstreamFile;
+
+    xOutputPictures( nalu, bNewPicture, endOfBitstream );
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    delete backupStats;
+#endif
+  }
+
+  xFlushOutput( m_pcListPic );
+  m_reconWriter.stop();
+  DiagLog::flush();
+
+  // get the number of checksum errors
+  UInt nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
+
+  // delete buffers
+  m_cDecLib.deletePicBuffer();
+  xDestroyBgPictures();
+
+  // destroy internal classes
+  xDestroyDecLib();
+
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  CodingStatistics::DestroyInstance();
+#endif
+
+  destroyROM();
+
+  return nRet;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Void DecApp::xCreateDecLib()
+{
+  initROM();
+
+  // the picture buffer pool is shared by all decoders and encoders of the process
+  PicBufferPool::getInstance().setUseHugePages( m_picBufferHugePages );
+  PicBufferPool::getInstance().setMaxCachedBytes( size_t( m_picBufferCacheSize ) << 20 );
+
+  // create decoder class
+  m_cDecLib.create();
+
+  // initialize decoder class
+  m_cDecLib.init();
+  m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  if (!m_outputDecodedSEIMessagesFilename.empty())
+  {
+    std::ostream &os=m_seiMessageFileStream.is_open() ? m_seiMessageFileStream : std::cout;
+    m_cDecLib.setDecodedSEIMessageOutputStream(&os);
+  }
+}
+
+Void DecApp::xDestroyDecLib()
+{
+  if ( !m_reconFileName.empty() )
+  {
+    m_cVideoIOYuvReconFile.close();
+  }
+
+  // destroy decoder class
+  m_cDecLib.destroy();
+}
+
+/// create the background pictures used by the decoder
+Void DecApp::xCreateBgPictures()
+{
   const UInt uiWidth = 1280;//m_cDecLib.getpcPic()->getOrigBuf().Y().width;   //1280;
   const UInt uiHeight = 720;// m_cDecLib.getpcPic()->getOrigBuf().Y().height;
 
@@ -162,7 +335,7 @@ UInt DecApp::decode()
 #endif
 
 #if BG_REFERENCE_SUBSTITUTION
-  Picture* rcPicYuvTemp = new Picture;
+  rcPicYuvTemp = new Picture;
 
   rcPicYuvTemp->create(m_chromaFormatConstraint, Size(uiWidth, uiHeight), MAX_CU_SIZE, MAX_CU_SIZE + 16, false);
 
@@ -170,155 +343,12 @@ UInt DecApp::decode()
 #endif
 
 #if ENCODE_BGPIC
-  Bool isF;
-  isF = true;
-  Bool isO;   
-  isO = true;
+  m_bgPicPending = true;
 #endif
+}
 
-  while (!!bitstreamFile)
-  {
-    /* location serves to work around a design fault in the decoder, whereby
-     * the process of reading a new slice that is the first slice of a new frame
-     * requires the DecApp::decode() method to be called again with the same
-     * nal unit. */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
-#endif
-    AnnexBStats stats = AnnexBStats();
-
-    InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
-
-    // call actual decoding function
-    Bool bNewPicture = false;
-    if (nalu.getBitstream().getFifo().empty())
-    {
-      /* this can happen if the following occur:
-       *  - empty input file
-       *  - two back-to-back start_code_prefixes
-       *  - start_code_prefix immediately followed by EOF
-       */
-      msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
-    }
-    else
-    {
-      read(nalu);
-
-      if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
-      {
-        bNewPicture = false;
-      }
-      else
-      {
-        bNewPicture = m_cDecLib.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay
-#if ENCODE_BGPIC
-		,isO
-#endif
-		);
-        if (bNewPicture)
-        {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
-          CodingStatistics::SetStatistics(*backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
-#endif
-        }
-      }
-    }
-
-
-
-    if( ( bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_cDecLib.getFirstSliceInSequence() )
-    {
-      if (!loopFiltered || bitstreamFile)
-      {
-        m_cDecLib.executeLoopFilters();
-        m_cDecLib.finishPicture( poc, pcListPic );
-      }
-      loopFiltered = (nalu.m_nalUnitType == NAL_UNIT_EOS);
-      if (nalu.m_nalUnitType == NAL_UNIT_EOS)
-      {
-        m_cDecLib.setFirstSliceInSequence(true);
-      }
-
-    }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
-              m_cDecLib.getFirstSliceInSequence () )
-    {
-      m_cDecLib.setFirstSliceInPicture (true);
-    }
-
-    if( pcListPic )
-    {
-      if ( (!m_reconFileName.empty()) && (!openedReconFile) )
-      {
-        const BitDepths &bitDepths=pcListPic->front()->cs->sps->getBitDepths(); // use bit depths of first reconstructed picture.
-        for( UInt channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++ )
-        {
-            if( m_outputBitDepth[channelType] == 0 )
-            {
-                m_outputBitDepth[channelType] = bitDepths.recon[channelType];
-            }
-        }
-
-        m_cVideoIOYuvReconFile.open( m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
-        openedReconFile = true;
-      }
-      // write reconstruction to file
-      if( bNewPicture )
-      {
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-      }
-      if ( (bNewPicture || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) && m_cDecLib.getNoOutputPriorPicsFlag() )
-      {
-        m_cDecLib.checkNoOutputPriorPics( pcListPic );
-        m_cDecLib.setNoOutputPriorPicsFlag (false);
-      }
-      if ( bNewPicture &&
-           (   nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_N_LP
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_RADL
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_LP ) )
-      {
-        xFlushOutput( pcListPic );
-      }
-      if (nalu.m_nalUnitType == NAL_UNIT_EOS)
-      {
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-        m_cDecLib.setFirstSliceInPicture (false);
-      }
-      // write reconstruction to file -- for additional bumping as defined in C.5.2.3
-      if(!bNewPicture && nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL_N && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL31)
-      {
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-      }
-    }
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    delete backupStats;
-#endif
-  }
-
-  xFlushOutput( pcListPic );
-
-  // get the number of checksum errors
-  UInt nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
-
-  // delete buffers
-  m_cDecLib.deletePicBuffer();
-  
+Void DecApp::xDestroyBgPictures()
+{
 #if GENERATE_BG_PIC
   bg_NewPicYuvRec->destroy();
   delete bg_NewPicYuvRec;
@@ -356,49 +386,99 @@ UInt DecApp::decode()
 	  rcPicYuvTemp = NULL;
   }
 #endif
- 
-  // destroy internal classes
-  xDestroyDecLib();
-
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  CodingStatistics::DestroyInstance();
-#endif
+}
 
-  destroyROM();
+/** \param nalu NAL unit to decode
+    \returns true if the NAL unit starts a new picture, it has to be decoded again after the current picture is finished
+ */
+Bool DecApp::xDecodeNalu( InputNALUnit& nalu )
+{
+  if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
+  {
+    return false;
+  }
 
-  return nRet;
+  return m_cDecLib.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay
+#if ENCODE_BGPIC
+                          , m_bgPicPending
+#endif
+                          );
 }
 
-// ====================================================================================================================
-// Protected member functions
-// ====================================================================================================================
-
-Void DecApp::xCreateDecLib()
+/** \param nalu            last decoded NAL unit
+    \param bNewPicture     the NAL unit starts a new picture
+    \param endOfBitstream  no more NAL units follow
+ */
+Void DecApp::xOutputPictures( const InputNALUnit& nalu, Bool bNewPicture, Bool endOfBitstream )
 {
-  initROM();
+  Int poc;
 
-  // create decoder class
-  m_cDecLib.create();
+  if( ( bNewPicture || endOfBitstream || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_cDecLib.getFirstSliceInSequence() )
+  {
+    if (!m_loopFiltered || !endOfBitstream)
+    {
+      m_cDecLib.executeLoopFilters();
+      m_cDecLib.finishPicture( poc, m_pcListPic );
+    }
+    m_loopFiltered = (nalu.m_nalUnitType == NAL_UNIT_EOS);
+    if (nalu.m_nalUnitType == NAL_UNIT_EOS)
+    {
+      m_cDecLib.setFirstSliceInSequence(true);
+    }
 
-  // initialize decoder class
-  m_cDecLib.init();
-  m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
-  if (!m_outputDecodedSEIMessagesFilename.empty())
+  }
+  else if ( (bNewPicture || endOfBitstream || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+            m_cDecLib.getFirstSliceInSequence () )
   {
-    std::ostream &os=m_seiMessageFileStream.is_open() ? m_seiMessageFileStream : std::cout;
-    m_cDecLib.setDecodedSEIMessageOutputStream(&os);
+    m_cDecLib.setFirstSliceInPicture (true);
   }
-}
 
-Void DecApp::xDestroyDecLib()
-{
-  if ( !m_reconFileName.empty() )
+  if( m_pcListPic )
   {
-    m_cVideoIOYuvReconFile.close();
-  }
+    if ( (!m_reconFileName.empty()) && (!m_openedReconFile) )
+    {
+      const BitDepths &bitDepths=m_pcListPic->front()->cs->sps->getBitDepths(); // use bit depths of first reconstructed picture.
+      for( UInt channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++ )
+      {
+          if( m_outputBitDepth[channelType] == 0 )
+          {
+              m_outputBitDepth[channelType] = bitDepths.recon[channelType];
+          }
+      }
 
-  // destroy decoder class
-  m_cDecLib.destroy();
+      m_cVideoIOYuvReconFile.open( m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
+      m_openedReconFile = true;
+    }
+    // write reconstruction to file
+    if( bNewPicture )
+    {
+      xWriteOutput( m_pcListPic, nalu.m_temporalId );
+    }
+    if ( (bNewPicture || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) && m_cDecLib.getNoOutputPriorPicsFlag() )
+    {
+      m_cDecLib.checkNoOutputPriorPics( m_pcListPic );
+      m_cDecLib.setNoOutputPriorPicsFlag (false);
+    }
+    if ( bNewPicture &&
+         (   nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL
+          || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP
+          || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_N_LP
+          || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_RADL
+          || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_LP ) )
+    {
+      xFlushOutput( m_pcListPic );
+    }
+    if (nalu.m_nalUnitType == NAL_UNIT_EOS)
+    {
+      xWriteOutput( m_pcListPic, nalu.m_temporalId );
+      m_cDecLib.setFirstSliceInPicture (false);
+    }
+    // write reconstruction to file -- for additional bumping as defined in C.5.2.3
+    if(!bNewPicture && nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL_N && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL31)
+    {
+      xWriteOutput( m_pcListPic, nalu.m_temporalId );
+    }
+  }
 }
 
 
@@ -472,7 +552,7 @@ Void DecApp::xWriteOutput( PicList* pcListPic, UInt tId )
       {
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
-        if ( !m_reconFileName.empty() )
+        if ( m_writeOutput )
         {
           const Window &conf = pcPicTop->cs->sps->getConformanceWindow();
           const Window  defDisp = (m_respectDefDispWindow && pcPicTop->cs->sps->getVuiParametersPresentFlag()) ? pcPicTop->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
@@ -491,12 +571,7 @@ Void DecApp::xWriteOutput( PicList* pcListPic, UInt tId )
 
           if (display)
           {
-            m_cVideoIOYuvReconFile.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                           m_outputColourSpaceConvert,
-                                           conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                           conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                           conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                           conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
+            xWriteRecon( *pcPicTop, *pcPicBottom, conf, defDisp, isTff );
           }
         }
 
@@ -536,18 +611,12 @@ Void DecApp::xWriteOutput( PicList* pcListPic, UInt tId )
         }
 
 
-        if (!m_reconFileName.empty())
+        if (m_writeOutput)
         {
           const Window &conf    = pcPic->cs->sps->getConformanceWindow();
           const Window  defDisp = (m_respectDefDispWindow && pcPic->cs->sps->getVuiParametersPresentFlag()) ? pcPic->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
 
-          m_cVideoIOYuvReconFile.write( pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          xWriteRecon( *pcPic, conf, defDisp );
         }
 
         if (m_seiMessageFileStream.is_open())
@@ -571,6 +640,42 @@ Void DecApp::xWriteOutput( PicList* pcListPic, UInt tId )
   }
 }
 
+/** \param pic      reconstructed frame
+    \param conf     conformance window
+    \param defDisp  default display window
+ */
+Void DecApp::xWriteRecon( const Picture& pic, const Window& conf, const Window& defDisp )
+{
+  const Int confLeft   = conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset();
+  const Int confRight  = conf.getWindowRightOffset()  + defDisp.getWindowRightOffset();
+  const Int confTop    = conf.getWindowTopOffset()    + defDisp.getWindowTopOffset();
+  const Int confBottom = conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset();
+
+  m_reconWriter.write( pic.getRecoBuf(), [=]( const CPelUnitBuf& picOut, const CPelUnitBuf& )
+  {
+    m_cVideoIOYuvReconFile.write( picOut, m_outputColourSpaceConvert, confLeft, confRight, confTop, confBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+  } );
+}
+
+/** \param picTop     reconstructed top field
+    \param picBottom  reconstructed bottom field
+    \param conf       conformance window
+    \param defDisp    default display window
+    \param isTff      top field first
+ */
+Void DecApp::xWriteRecon( const Picture& picTop, const Picture& picBottom, const Window& conf, const Window& defDisp, Bool isTff )
+{
+  const Int confLeft   = conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset();
+  const Int confRight  = conf.getWindowRightOffset()  + defDisp.getWindowRightOffset();
+  const Int confTop    = conf.getWindowTopOffset()    + defDisp.getWindowTopOffset();
+  const Int confBottom = conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset();
+
+  m_reconWriter.write( picTop.getRecoBuf(), picBottom.getRecoBuf(), [=]( const CPelUnitBuf& picTopOut, const CPelUnitBuf& picBottomOut )
+  {
+    m_cVideoIOYuvReconFile.write( picTopOut, picBottomOut, m_outputColourSpaceConvert, confLeft, confRight, confTop, confBottom, NUM_CHROMA_FORMAT, isTff );
+  } );
+}
+
 /** \param pcListPic list of pictures to be written to file
  */
 Void DecApp::xFlushOutput( PicList* pcListPic )
@@ -598,17 +703,12 @@ Void DecApp::xFlushOutput( PicList* pcListPic )
       if ( pcPicTop->neededForOutput && pcPicBottom->neededForOutput && !(pcPicTop->getPOC()%2) && (pcPicBottom->getPOC() == pcPicTop->getPOC()+1) )
       {
         // write to file
-        if ( !m_reconFileName.empty() )
+        if ( m_writeOutput )
         {
           const Window &conf = pcPicTop->cs->sps->getConformanceWindow();
           const Window  defDisp = (m_respectDefDispWindow && pcPicTop->cs->sps->getVuiParametersPresentFlag()) ? pcPicTop->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
           const Bool isTff = pcPicTop->topField;
-          m_cVideoIOYuvReconFile.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
+          xWriteRecon( *pcPicTop, *pcPicBottom, conf, defDisp, isTff );
         }
 
         // update POC of display order
@@ -651,18 +751,12 @@ Void DecApp::xFlushOutput( PicList* pcListPic )
       {
         // write to file
 
-        if (!m_reconFileName.empty())
+        if (m_writeOutput)
         {
           const Window &conf    = pcPic->cs->sps->getConformanceWindow();
           const Window  defDisp = (m_respectDefDispWindow && pcPic->cs->sps->getVuiParametersPresentFlag()) ? pcPic->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
 
-          m_cVideoIOYuvReconFile.write( pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          xWriteRecon( *pcPic, conf, defDisp );
         }
 
         if (m_seiMessageFileStream.is_open())
@@ -43,6 +43,7 @@
 #endif // _MSC_VER > 1000
 
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsync.h"
 #include "Utilities/ColourRemapping.h"
 #include "CommonLib/Picture.h"
 #include "DecoderLib/DecLib.h"
@@ -58,10 +59,11 @@
 /// decoder application class
 class DecApp : public DecAppCfg
 {
-private:
+protected:
   // class interface
   DecLib          m_cDecLib;                     ///< decoder class
   VideoIOYuv      m_cVideoIOYuvReconFile;        ///< reconstruction YUV class
+  VideoIOYuvAsyncWriter m_reconWriter;           ///< writes the reconstruction, on a separate thread if enabled
 
 #if PRINT_PRE_FLAG
   TVideoIOYuv                     m_cTVideoIOYuvPrediFile;		  ///<prediction yuv class
@@ -94,8 +96,20 @@ private:
   Picture* bg_NewPicYuvReco;
 #endif
 
+#if BG_REFERENCE_SUBSTITUTION
+  Picture* rcPicYuvTemp;
+#endif
+
+#if ENCODE_BGPIC
+  Bool            m_bgPicPending;                 ///< the background picture has not been decoded yet
+#endif
+
   // for output control
   Int             m_iPOCLastDisplay;              ///< last POC in display order
+  PicList*        m_pcListPic;                    ///< decoded pictures, set once the first picture is finished
+  Bool            m_loopFiltered;                 ///< the current picture was already finished at an end of sequence NAL unit
+  Bool            m_openedReconFile;              ///< reconstruction file opened (after the SPS is seen)
+  Bool            m_writeOutput;                  ///< output pictures are passed to xWriteRecon
   std::ofstream   m_seiMessageFileStream;         ///< Used for outputing SEI messages.
   ColourRemapping m_cColourRemapping;             ///< colour remapping handler
 
@@ -106,11 +120,17 @@ public:
 
   UInt  decode            (); ///< main decoding function
 
-private:
+protected:
   Void  xCreateDecLib     (); ///< create internal classes
   Void  xDestroyDecLib    (); ///< destroy internal classes
+  Void  xCreateBgPictures (); ///< create the background pictures and hand them to the decoder
+  Void  xDestroyBgPictures();
+  Bool  xDecodeNalu       ( InputNALUnit& nalu ); ///< decode a NAL unit, true if it has to be decoded again
+  Void  xOutputPictures   ( const InputNALUnit& nalu, Bool bNewPicture, Bool endOfBitstream ); ///< finish the current picture and output the pictures that are due
   Void  xWriteOutput      ( PicList* pcListPic , UInt tId); ///< write YUV to file
   Void  xFlushOutput      ( PicList* pcListPic ); ///< flush all remaining decoded pictures to file
+  virtual Void xWriteRecon( const Picture& pic, const Window& conf, const Window& defDisp ); ///< write a frame through the output writer
+  virtual Void xWriteRecon( const Picture& picTop, const Picture& picBottom, const Window& conf, const Window& defDisp, Bool isTff ); ///< write a pair of fields through the output writer
   Bool  isNaluWithinTargetDecLayerIdSet ( InputNALUnit* nalu ); ///< check whether given Nalu is within targetDecLayerIdSet
 };
 
@@ -40,6 +40,7 @@
 #include <string>
 #include "DecAppCfg.h"
 #include "Utilities/program_options_lite.h"
+#include "Utilities/VideoIOYuv.h"
 #include "CommonLib/ChromaFormat.h"
 #include "CommonLib/dtrace_next.h"
 
@@ -62,6 +63,7 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
   string cfg_TargetDecLayerIdSetFile;
   string outputColourSpaceConvert;
   Int warnUnknowParameter = 0;
+  Int verbosity = 0;
 #if ENABLE_TRACING
   string sTracingRule;
   string sTracingFile;
@@ -75,7 +77,11 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
 
   ("help",                      do_help,                               false,      "this help text")
   ("BitstreamFile,b",           m_bitstreamFileName,                   string(""), "bitstream input file name")
+  ("MemoryMappedInput",         m_memoryMappedInput,                   false,      "memory map the bitstream file and locate NAL units in place instead of reading it through a stream")
   ("ReconFile,o",               m_reconFileName,                       string(""), "reconstructed YUV output file name\n")
+  ("AsyncOutputFrames",         m_asyncOutputFrames,                   0,          "number of output pictures queued for a separate output thread (0: synchronous writing)")
+  ("PicBufferHugePages",        m_picBufferHugePages,                  false,      "back large picture buffers by transparent huge pages where supported")
+  ("PicBufferCacheSize",        m_picBufferCacheSize,                  0,          "maximum size in MiB of released picture buffers kept for reuse (0: unlimited)")
 
 #if ENABLE_SIMD_OPT
   ("SIMD",                      ignore,                                string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
@@ -96,6 +102,7 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("SEIColourRemappingInfoFilename",  m_colourRemapSEIFileName,        string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
   ("ClipOutputVideoToRec709Range",      m_bClipOutputVideoToRec709Range,  false,   "If true then clip output video to the Rec. 709 Range on saving")
+  ("Verbosity,v",               verbosity,                             (Int)VERBOSE, "Specifies the level of the verboseness")
 #if ENABLE_TRACING
   ("TraceChannelsList",         bTracingChannelsList,                        false, "List all available tracing channels" )
   ("TraceRule",                 sTracingRule,                         string( "" ), "Tracing rule (ex: \"D_CABAC:poc==8\" or \"D_REC_CB_LUMA:poc==8\")" )
@@ -127,6 +134,8 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
     }
   }
 
+  g_verbosity = MsgLevel( verbosity );
+
 #if ENABLE_TRACING
   g_trace_ctx = tracing_init( sTracingFile, sTracingRule );
   if( bTracingChannelsList && g_trace_ctx )
@@ -156,6 +165,24 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
+  if (m_asyncOutputFrames < 0)
+  {
+    msg( ERROR, "Number of asynchronously written output pictures cannot be negative\n");
+    return false;
+  }
+
+  if (m_picBufferCacheSize < 0)
+  {
+    msg( ERROR, "The picture buffer cache size cannot be negative\n");
+    return false;
+  }
+
+  // writing the reconstruction to the null device is skipped entirely
+  if (VideoIOYuv::isNullDevice(m_reconFileName))
+  {
+    m_reconFileName.clear();
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
@@ -205,7 +232,11 @@ Bool DecAppCfg::parseCfg( Int argc, TChar* argv[] )
 
 DecAppCfg::DecAppCfg()
 : m_bitstreamFileName()
+, m_memoryMappedInput(false)
 , m_reconFileName()
+, m_asyncOutputFrames(0)
+, m_picBufferHugePages(false)
+, m_picBufferCacheSize(0)
 , m_iSkipFrame(0)
 // m_outputBitDepth array initialised below
 , m_outputColourSpaceConvert(IPCOLOURSPACE_UNCHANGED)
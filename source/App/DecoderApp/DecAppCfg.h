@@ -57,7 +57,11 @@ class DecAppCfg
 {
 protected:
   std::string   m_bitstreamFileName;                    ///< input bitstream file name
+  Bool          m_memoryMappedInput;                    ///< memory map the bitstream file instead of reading it through a stream
   std::string   m_reconFileName;                        ///< output reconstruction file name
+  Int           m_asyncOutputFrames;                    ///< number of output pictures queued for the output thread (0: synchronous writing)
+  Bool          m_picBufferHugePages;                   ///< back large picture buffers by huge pages
+  Int           m_picBufferCacheSize;                   ///< maximum size in MiB of released picture buffers kept for reuse (0: unlimited)
   Int           m_iSkipFrame;                           ///< counter for frames prior to the random access point to skip
   Int           m_outputBitDepth[MAX_NUM_CHANNEL_TYPE]; ///< bit depth used for writing output
   InputColourSpaceConversion m_outputColourSpaceConvert;
@@ -0,0 +1,214 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncApi.cpp
+    \brief    In-process encoder interface
+*/
+
+#include "EncApi.h"
+#include "EncoderLib/AnnexBwrite.h"
+#include "CommonLib/DiagLog.h"
+
+//! \ingroup EncoderApp
+//! \{
+
+EncApi::EncApi()
+  : m_pendingQP  ( 0 )
+  , m_qpPending  ( false )
+  , m_initialized( false )
+  , m_flushed    ( false )
+{
+}
+
+EncApi::~EncApi()
+{
+  destroy();
+}
+
+Bool EncApi::init( Int argc, TChar* argv[], AUCallback auCallback )
+{
+  CHECK( m_initialized, "Encoder already initialized" );
+
+  // the bitstream is delivered through the callback, the option only has to be set
+  std::vector<std::string> args( argv, argv + argc );
+  args.insert( args.begin() + std::min<Int>( argc, 1 ), "--BitstreamFile=-" );
+
+  std::vector<TChar*> cfgArgv;
+  for( auto &arg : args )
+  {
+    cfgArgv.push_back( &arg[0] );
+  }
+
+  create();
+  if( !parseCfg( Int( cfgArgv.size() ), cfgArgv.data() ) )
+  {
+    EncAppCfg::destroy();
+    return false;
+  }
+  if( m_isField || m_numSegmentJobs > 0 )
+  {
+    msg( ERROR, "Field coding and segment-parallel encoding are not supported by the encoder interface\n" );
+    EncAppCfg::destroy();
+    return false;
+  }
+
+  m_auCallback = auCallback;
+
+  xInitLibCfg();
+  m_cEncLib.create();
+  for( Int i = 0; i < m_iGOPSize + 1; i++ )
+  {
+    m_recBufList.push_back( new PelUnitBuf );
+  }
+  xInitLib( false );
+  xCreateBgPictures();
+  xStartProfiling();
+
+  m_orgPic.create( getFrameArea() );
+
+  m_iFrameRcvd  = 0;
+  m_qpPending   = false;
+  m_flushed     = false;
+  m_initialized = true;
+  return true;
+}
+
+Void EncApi::destroy()
+{
+  if( !m_initialized )
+  {
+    return;
+  }
+
+  xFinishProfiling();
+  DiagLog::flush();
+  xDestroyBgPictures();
+  m_cEncLib.deletePicBuffer();
+  for( auto &p : m_recBufList )
+  {
+    delete p;
+  }
+  m_recBufList.clear();
+  m_orgPic.destroy();
+
+  xDestroyLib();
+  EncAppCfg::destroy();
+
+  m_initialized = false;
+}
+
+UnitArea EncApi::getFrameArea() const
+{
+  return UnitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, m_iSourceHeight ) );
+}
+
+PelUnitBuf EncApi::getFrameBuffer()
+{
+  return m_orgPic;
+}
+
+Void EncApi::pushFrame( const CPelUnitBuf& frame )
+{
+  CHECK( !m_initialized || m_flushed, "The encoder does not accept frames" );
+
+  if( frame.Y().buf != m_orgPic.Y().buf )
+  {
+    CHECK( frame.chromaFormat != m_orgPic.chromaFormat || frame.Y().width != m_orgPic.Y().width || frame.Y().height != m_orgPic.Y().height, "Frame does not match the configured format" );
+    m_orgPic.copyFrom( frame );
+  }
+
+  m_iFrameRcvd++;
+  const Bool eos = m_iFrameRcvd == m_framesToBeEncoded;
+
+  // the frame buffer is swapped into the picture of the encoder, the true original is not used for frame coding
+  Int numEncoded = 0;
+  m_cEncLib.encode( eos, &m_orgPic, &m_orgPic, IPCOLOURSPACE_UNCHANGED, m_recBufList, numEncoded );
+
+  if( numEncoded > 0 )
+  {
+    xApplyPendingConfig();
+  }
+  m_flushed = eos;
+}
+
+Void EncApi::flush()
+{
+  if( !m_initialized || m_flushed )
+  {
+    return;
+  }
+
+  m_cEncLib.setFramesToBeEncoded( m_iFrameRcvd );
+
+  Int numEncoded = 0;
+  m_cEncLib.encode( true, NULL, NULL, IPCOLOURSPACE_UNCHANGED, m_recBufList, numEncoded );
+  m_flushed = true;
+}
+
+Void EncApi::setBaseQP( Int qp )
+{
+  CHECK( qp < -( 6 * ( m_internalBitDepth[CHANNEL_TYPE_LUMA] - 8 ) ) || qp > MAX_QP, "Base QP out of range" );
+
+  m_pendingQP = qp;
+  m_qpPending = true;
+  if( m_iFrameRcvd == 0 )
+  {
+    xApplyPendingConfig();
+  }
+}
+
+/// the encoder has no pictures buffered at a GOP boundary, so the configuration can be changed
+Void EncApi::xApplyPendingConfig()
+{
+  if( m_qpPending )
+  {
+    m_cEncLib.setBaseQP( m_pendingQP );
+    m_iQP       = m_pendingQP;
+    m_qpPending = false;
+  }
+}
+
+void EncApi::outputAU( const AccessUnit& au )
+{
+  m_auStream.str( std::string() );
+  m_auStream.clear();
+
+  const std::vector<UInt>& stats = writeAnnexB( m_auStream, au );
+  rateStatsAccum( au, stats );
+
+  const std::string data = m_auStream.str();
+  m_auCallback( reinterpret_cast<const UChar*>( data.data() ), data.size() );
+}
+
+//! \}
@@ -0,0 +1,100 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncApi.h
+    \brief    In-process encoder interface (header)
+*/
+
+#ifndef __ENCAPI__
+#define __ENCAPI__
+
+#include <functional>
+#include <list>
+#include <sstream>
+#include <string>
+
+#include "EncApp.h"
+
+//! \ingroup EncoderApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+  In-process encoder: frames are pushed from memory and the coded access units are delivered
+  through a callback, without any file I/O. The encoder is configured with the same options as
+  the encoder application; the file options are ignored. FramesToBeEncoded limits the sequence,
+  the sequence can be ended earlier with flush().
+
+  Frames are in the internal format: getFrameArea() gives the size including the padding and
+  the chroma format, the samples are at the internal bit depth.
+ */
+class EncApi : private EncApp
+{
+public:
+  typedef std::function<Void( const UChar* data, size_t size )> AUCallback;  ///< receives one Annex-B access unit
+
+  EncApi();
+  virtual ~EncApi();
+
+  Bool        init           ( Int argc, TChar* argv[], AUCallback auCallback ); ///< configure and create the encoder, false on configuration errors
+  Void        destroy        ();
+
+  UnitArea    getFrameArea   () const;
+  Int         getBitDepth    ( const ChannelType chType ) const { return m_internalBitDepth[chType]; }
+  PelUnitBuf  getFrameBuffer ();                               ///< buffer of the next frame, filling it in place avoids the copy in pushFrame
+  Void        pushFrame      ( const CPelUnitBuf& frame );     ///< encode a frame, access units are delivered as soon as their GOP is coded
+  Void        flush          ();                               ///< encode all pending frames and end the sequence
+
+  Void        setBaseQP      ( Int qp );                       ///< reconfigure the base QP, applied from the next GOP on
+
+private:
+  virtual void outputAU      ( const AccessUnit& au );
+  Void        xApplyPendingConfig();
+
+  AUCallback             m_auCallback;
+  std::list<PelUnitBuf*> m_recBufList;
+  PelStorage             m_orgPic;
+  std::stringstream      m_auStream;
+  Int                    m_pendingQP;                          ///< base QP to apply at the next GOP boundary
+  Bool                   m_qpPending;
+  Bool                   m_initialized;
+  Bool                   m_flushed;
+};
+
+//! \}
+
+#endif // __ENCAPI__
@@ -0,0 +1,152 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncApiC.cpp
+    \brief    C interface of the in-process encoder
+*/
+
+#include "EncApiC.h"
+#include "EncApi.h"
+
+struct EncApiEncoder
+{
+  EncApi encoder;
+};
+
+EncApiEncoder* encapi_create( int argc, char* argv[], EncApiAUCallback auCallback, void* userData )
+{
+  EncApiEncoder* enc = NULL;
+  try
+  {
+    enc = new EncApiEncoder;
+    if( !enc->encoder.init( argc, argv, [=]( const UChar* data, size_t size ) { auCallback( userData, data, size ); } ) )
+    {
+      delete enc;
+      enc = NULL;
+    }
+  }
+  catch( ... )
+  {
+    delete enc;
+    enc = NULL;
+  }
+  return enc;
+}
+
+void encapi_destroy( EncApiEncoder* enc )
+{
+  try
+  {
+    delete enc;
+  }
+  catch( ... )
+  {
+  }
+}
+
+int encapi_get_frame_format( const EncApiEncoder* enc, int* width, int* height, int* chromaFormat, int* bitDepthLuma, int* bitDepthChroma, int* bytesPerSample )
+{
+  if( !enc )
+  {
+    return -1;
+  }
+  const UnitArea area = enc->encoder.getFrameArea();
+  *width          = area.lumaSize().width;
+  *height         = area.lumaSize().height;
+  *chromaFormat   = area.chromaFormat;
+  *bitDepthLuma   = enc->encoder.getBitDepth( CHANNEL_TYPE_LUMA );
+  *bitDepthChroma = enc->encoder.getBitDepth( CHANNEL_TYPE_CHROMA );
+  *bytesPerSample = sizeof( Pel );
+  return 0;
+}
+
+int encapi_push_frame( EncApiEncoder* enc, const void* const planes[3], const int strides[3] )
+{
+  if( !enc )
+  {
+    return -1;
+  }
+  try
+  {
+    const UnitArea area = enc->encoder.getFrameArea();
+    CPelUnitBuf    frame;
+    frame.chromaFormat = area.chromaFormat;
+    for( UInt comp = 0; comp < getNumberValidComponents( area.chromaFormat ); comp++ )
+    {
+      const ComponentID compID = ComponentID( comp );
+      const CompArea&   block  = area.block( compID );
+      frame.bufs.push_back( CPelBuf( static_cast<const Pel*>( planes[comp] ), strides[comp], block.width, block.height ) );
+    }
+    enc->encoder.pushFrame( frame );
+  }
+  catch( ... )
+  {
+    return -1;
+  }
+  return 0;
+}
+
+int encapi_flush( EncApiEncoder* enc )
+{
+  if( !enc )
+  {
+    return -1;
+  }
+  try
+  {
+    enc->encoder.flush();
+  }
+  catch( ... )
+  {
+    return -1;
+  }
+  return 0;
+}
+
+int encapi_set_base_qp( EncApiEncoder* enc, int qp )
+{
+  if( !enc )
+  {
+    return -1;
+  }
+  try
+  {
+    enc->encoder.setBaseQP( qp );
+  }
+  catch( ... )
+  {
+    return -1;
+  }
+  return 0;
+}
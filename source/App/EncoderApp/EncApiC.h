@@ -0,0 +1,73 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncApiC.h
+    \brief    C interface of the in-process encoder
+*/
+
+#ifndef __ENCAPIC__
+#define __ENCAPIC__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct EncApiEncoder EncApiEncoder;
+
+/// receives one Annex-B access unit, the data is only valid during the call
+typedef void (*EncApiAUCallback)( void* userData, const unsigned char* data, size_t size );
+
+/// create an encoder configured with the options of the encoder application, NULL on errors
+EncApiEncoder* encapi_create           ( int argc, char* argv[], EncApiAUCallback auCallback, void* userData );
+void           encapi_destroy          ( EncApiEncoder* enc );
+
+/// frame size including the padding, chroma format (0: 400, 1: 420, 2: 422, 3: 444), internal bit depths and size of a sample
+int            encapi_get_frame_format ( const EncApiEncoder* enc, int* width, int* height, int* chromaFormat, int* bitDepthLuma, int* bitDepthChroma, int* bytesPerSample );
+
+/// encode a frame at the internal bit depth, strides are in samples; unused planes of 4:0:0 frames may be NULL
+int            encapi_push_frame       ( EncApiEncoder* enc, const void* const planes[3], const int strides[3] );
+
+/// encode all pending frames and end the sequence
+int            encapi_flush            ( EncApiEncoder* enc );
+
+/// change the base QP, applied from the next GOP on
+int            encapi_set_base_qp      ( EncApiEncoder* enc, int qp );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ENCAPIC__
@@ -41,9 +41,20 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <iomanip>
+#include <thread>
+#include <atomic>
+#include <exception>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
+#include "CommonLib/BufferPool.h"
+#include "CommonLib/Profiler.h"
+#include "CommonLib/DiagLog.h"
 
 using namespace std;
 
@@ -54,11 +65,31 @@ using namespace std;
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
 
+/// stream buffer writing to a stdio file, used to write the bitstream to the reserved stdout
+class StdioOutputBuf : public std::streambuf
+{
+public:
+  StdioOutputBuf( FILE* file ) : m_file( file ) {}
+
+protected:
+  virtual int_type        overflow( int_type c )                      { return traits_type::eq_int_type( c, traits_type::eof() ) || fputc( c, m_file ) != EOF ? traits_type::not_eof( c ) : traits_type::eof(); }
+  virtual std::streamsize xsputn  ( const char* s, std::streamsize n ) { return std::streamsize( fwrite( s, 1, size_t( n ), m_file ) ); }
+  virtual int             sync    ()                                  { return fflush( m_file ) == 0 ? 0 : -1; }
+
+private:
+  FILE* m_file;
+};
+
+FILE* EncApp::s_stdoutBitstream = NULL;
+
 EncApp::EncApp()
 {
   m_iFrameRcvd = 0;
   m_totalBytes = 0;
   m_essentialBytes = 0;
+  m_bitstreamPipe = NULL;
+  m_segmentIdx = -1;
+  m_segmentHeaderDone = false;
 }
 
 EncApp::~EncApp()
@@ -67,6 +98,10 @@ EncApp::~EncApp()
 
 Void EncApp::xInitLibCfg()
 {
+  // the picture buffer pool is shared by all encoders and decoders of the process
+  PicBufferPool::getInstance().setUseHugePages( m_picBufferHugePages );
+  PicBufferPool::getInstance().setMaxCachedBytes( size_t( m_picBufferCacheSize ) << 20 );
+
 #if HEVC_VPS
   VPS vps;
 
@@ -98,6 +133,7 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setPrintMSEBasedSequencePSNR                         ( m_printMSEBasedSequencePSNR);
   m_cEncLib.setPrintFrameMSE                                     ( m_printFrameMSE);
   m_cEncLib.setPrintSequenceMSE                                  ( m_printSequenceMSE);
+  m_cEncLib.setAsyncMetrics                                      ( m_asyncMetrics );
   m_cEncLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
 
   m_cEncLib.setFrameRate                                         ( m_iFrameRate );
@@ -154,6 +190,7 @@ Void EncApp::xInitLibCfg()
 
   //====== Motion search ========
   m_cEncLib.setDisableIntraPUsInInterSlices                      ( m_bDisableIntraPUsInInterSlices );
+  m_cEncLib.setBgSkipIntra                                       ( m_bgSkipIntra );
   m_cEncLib.setMotionEstimationSearchMethod                      ( m_motionEstimationSearchMethod  );
   m_cEncLib.setSearchRange                                       ( m_iSearchRange );
   m_cEncLib.setBipredSearchRange                                 ( m_bipredSearchRange );
@@ -161,6 +198,7 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
   m_cEncLib.setMinSearchWindow                                   ( m_minSearchWindow );
   m_cEncLib.setRestrictMESampling                                ( m_bRestrictMESampling );
+  m_cEncLib.setUseHierarchicalME                                 ( m_useHierarchicalME );
 
   //====== Quality control ========
   m_cEncLib.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
@@ -204,6 +242,7 @@ Void EncApp::xInitLibCfg()
 #if T0196_SELECTIVE_RDOQ
   m_cEncLib.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
 #endif
+  m_cEncLib.setFastRDOQ                                          ( m_fastRDOQ );
   m_cEncLib.setRDpenalty                                         ( m_rdPenalty );
   m_cEncLib.setQTBT                                              ( m_QTBT );
   m_cEncLib.setCTUSize                                           ( m_uiCTUSize );
@@ -232,8 +271,11 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setUseFastDecisionForMerge                           ( m_useFastDecisionForMerge  );
   m_cEncLib.setUseCbfFastMode                                    ( m_bUseCbfFastMode  );
   m_cEncLib.setUseEarlySkipDetection                             ( m_useEarlySkipDetection );
+  m_cEncLib.setUseSpeedGovernor                                  ( m_useSpeedGovernor );
+  m_cEncLib.setSpeedGovernorFps                                  ( m_speedGovernorFps );
   m_cEncLib.setUseFastMerge                                      ( m_useFastMrg );
   m_cEncLib.setUsePbIntraFast                                    ( m_usePbIntraFast );
+  m_cEncLib.setUseFastIntraGradient                              ( m_useFastIntraGradient );
   m_cEncLib.setUseAMaxBT                                         ( m_useAMaxBT );
   m_cEncLib.setUseSaveLoadEncInfo                                ( m_useSaveLoadEncInfo );
   m_cEncLib.setUseSaveLoadSplitDecision                          ( m_useSaveLoadSplitDecision );
@@ -469,6 +511,7 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setSummaryOutFilename                                ( m_summaryOutFilename );
   m_cEncLib.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
   m_cEncLib.setSummaryVerboseness                                ( m_summaryVerboseness );
+  m_cEncLib.setCtuStatsFileName                                  ( m_ctuStatsFileName );
   m_cEncLib.setDecodeBitstream                                   ( 0, m_decodeBitstreams[0] );
   m_cEncLib.setDecodeBitstream                                   ( 1, m_decodeBitstreams[1] );
   m_cEncLib.setSwitchPOC                                         ( m_switchPOC );
@@ -493,7 +536,7 @@ Void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList
                         )
 {
   // Video I/O
-  m_cVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
+  m_cVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth, m_memoryMappedInput );  // read  mode
   m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
 
   if (!m_reconFileName.empty())
@@ -526,39 +569,9 @@ Void EncApp::xInitLib(Bool isFieldCoding)
   m_cEncLib.init(isFieldCoding, this );
 }
 
-// ====================================================================================================================
-// Public member functions
-// ====================================================================================================================
-
-/**
- - create internal class
- - initialize internal variable
- - until the end of input YUV file, call encoding function in EncLib class
- - delete allocated buffers
- - destroy internal class
- .
- */
-Void EncApp::encode()
+/// create the background pictures used by the encoder
+Void EncApp::xCreateBgPictures()
 {
-  m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
-  if (!m_bitstream)
-  {
-    EXIT( "failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
-  }
-
-  std::list<PelUnitBuf*> recBufList;
-  // initialize internal class & member variables
-  xInitLibCfg();
-  xCreateLib( recBufList
-             );
-  xInitLib(m_isField);
-
-  printChromaFormat();
-
-  // main encoder loop
-  Int   iNumEncoded = 0;
-  Bool  bEos = false;
-
 #if BLOCK_GEN
   bg_NewBlocksOrg = new Picture;
   bg_NewBlocksOrg->create(m_chromaFormatConstraint, Size(m_iSourceWidth, m_iSourceHeight), m_uiMaxCUWidth, m_uiMaxCUWidth + 16, false);
@@ -625,66 +638,10 @@ Void EncApp::encode()
   rcPicYuvTemp->create(m_chromaFormatConstraint, Size(m_iSourceWidth, m_iSourceHeight), m_uiMaxCUWidth, m_uiMaxCUWidth + 16, false);
   m_cEncLib.setPicYuvTemp(rcPicYuvTemp);
 #endif
+}
 
-  const InputColourSpaceConversion ipCSC  =  m_inputColourSpaceConvert;
-  const InputColourSpaceConversion snrCSC = (!m_snrInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
-
-  PelStorage trueOrgPic;
-  PelStorage orgPic;
-  const Int sourceHeight = m_isField ? m_iSourceHeightOrg : m_iSourceHeight;
-  UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, sourceHeight ) );
-
-  orgPic.create( unitArea );
-  trueOrgPic.create( unitArea );
-
-  while ( !bEos )
-  {
-    // read input YUV file
-    m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
-
-    // increase number of received frames
-    m_iFrameRcvd++;
-
-    bEos = (m_isField && (m_iFrameRcvd == (m_framesToBeEncoded >> 1) )) || ( !m_isField && (m_iFrameRcvd == m_framesToBeEncoded) );
-
-    Bool flush = 0;
-    // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-    if (m_cVideoIOYuvInputFile.isEof())
-    {
-      flush = true;
-      bEos = true;
-      m_iFrameRcvd--;
-      m_cEncLib.setFramesToBeEncoded(m_iFrameRcvd);
-    }
-
-    // call encoding function for one frame
-    if ( m_isField )
-    {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
-                        iNumEncoded, m_isTopFieldFirst );
-    }
-    else
-    {
-      m_cEncLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, recBufList,
-                        iNumEncoded );
-    }
-
-    // write bistream to file if necessary
-    if ( iNumEncoded > 0 )
-    {
-      xWriteOutput( iNumEncoded, recBufList
-      );
-    }
-    // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
-    {
-      m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
-    }
-  }
-
-  m_cEncLib.printSummary(m_isField);
-
-
+Void EncApp::xDestroyBgPictures()
+{
 #if BLOCK_GEN
   if (bg_NewBlocksOrg)
   {
@@ -784,6 +741,157 @@ Void EncApp::encode()
 	  rcPicYuvTemp = NULL;
   }
 #endif
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ - create internal class
+ - initialize internal variable
+ - until the end of input YUV file, call encoding function in EncLib class
+ - delete allocated buffers
+ - destroy internal class
+ .
+ */
+Void EncApp::encode()
+{
+  if( m_segmentIdx < 0 )
+  {
+    xOpenBitstream();
+    xStartProfiling();
+
+    if( m_numSegmentJobs > 0 )
+    {
+      xEncodeSegments();
+      return;
+    }
+  }
+
+  std::list<PelUnitBuf*> recBufList;
+  // initialize internal class & member variables
+  xInitLibCfg();
+  xCreateLib( recBufList
+             );
+  xInitLib(m_isField);
+
+  if( !m_reconFileName.empty() )
+  {
+    m_reconWriter.start( m_asyncOutputFrames );
+  }
+
+  printChromaFormat();
+
+  // main encoder loop
+  Int   iNumEncoded = 0;
+  Bool  bEos = false;
+
+  xCreateBgPictures();
+
+  const InputColourSpaceConversion ipCSC  =  m_inputColourSpaceConvert;
+  const InputColourSpaceConversion snrCSC = (!m_snrInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+
+  PelStorage trueOrgPic;
+  PelStorage orgPic;
+  const Int sourceHeight = m_isField ? m_iSourceHeightOrg : m_iSourceHeight;
+  UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, sourceHeight ) );
+
+  // the input thread reads ahead into its own ring of buffers, the file is then only accessed by that thread
+  VideoIOYuvAsyncReader asyncReader;
+  const Bool asyncInput = m_asyncInputFrames > 0;
+  if( asyncInput )
+  {
+    const Int numFrames = m_isField ? ( m_framesToBeEncoded >> 1 ) : m_framesToBeEncoded;
+    asyncReader.start( unitArea, m_asyncInputFrames + 1, numFrames, [&]( PelStorage& pic, PelStorage& picTrueOrg )
+    {
+      m_cVideoIOYuvInputFile.read( pic, picTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      if( m_cVideoIOYuvInputFile.isEof() )
+      {
+        return false;
+      }
+      // temporally skip frames
+      if( m_temporalSubsampleRatio > 1 )
+      {
+        m_cVideoIOYuvInputFile.skipFrames( m_temporalSubsampleRatio-1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+      }
+      return true;
+    } );
+  }
+  else
+  {
+    orgPic.create( unitArea );
+    trueOrgPic.create( unitArea );
+  }
+
+  while ( !bEos )
+  {
+    PelStorage* curOrgPic     = &orgPic;
+    PelStorage* curTrueOrgPic = &trueOrgPic;
+    Bool        inputEof      = false;
+
+    // read input YUV file
+    if( asyncInput )
+    {
+      inputEof = !asyncReader.acquire( curOrgPic, curTrueOrgPic );
+    }
+    else
+    {
+      m_cVideoIOYuvInputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      inputEof = m_cVideoIOYuvInputFile.isEof();
+    }
+
+    // increase number of received frames
+    m_iFrameRcvd++;
+
+    bEos = (m_isField && (m_iFrameRcvd == (m_framesToBeEncoded >> 1) )) || ( !m_isField && (m_iFrameRcvd == m_framesToBeEncoded) );
+
+    Bool flush = 0;
+    // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
+    if (inputEof)
+    {
+      flush = true;
+      bEos = true;
+      m_iFrameRcvd--;
+      m_cEncLib.setFramesToBeEncoded(m_iFrameRcvd);
+    }
+
+    // call encoding function for one frame
+    if ( m_isField )
+    {
+      m_cEncLib.encode( bEos, flush ? 0 : curOrgPic, flush ? 0 : curTrueOrgPic, snrCSC, recBufList,
+                        iNumEncoded, m_isTopFieldFirst );
+    }
+    else
+    {
+      m_cEncLib.encode( bEos, flush ? 0 : curOrgPic, flush ? 0 : curTrueOrgPic, snrCSC, recBufList,
+                        iNumEncoded );
+    }
+
+    if( asyncInput )
+    {
+      asyncReader.release();
+    }
+
+    // write bistream to file if necessary
+    if ( iNumEncoded > 0 )
+    {
+      xWriteOutput( iNumEncoded, recBufList
+      );
+    }
+    // temporally skip frames
+    if( !asyncInput && m_temporalSubsampleRatio > 1 )
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
+    }
+  }
+  asyncReader.stop();
+  m_reconWriter.stop();
+
+  m_cEncLib.printSummary(m_isField);
+
+
+  xDestroyBgPictures();
 
 
 
@@ -797,14 +905,234 @@ Void EncApp::encode()
   recBufList.clear();
 
   xDestroyLib();
+  DiagLog::flush();
 
-  m_bitstream.close();
+  if( m_segmentIdx < 0 )
+  {
+    xCloseBitstream();
 
-  printRateSummary();
+    printRateSummary();
+    xFinishProfiling();
+  }
 
   return;
 }
 
+/**
+  Segment-parallel encoding: the input is split into segments aligned to the intra period
+  (or SegmentLength), each segment is encoded by its own encoder instance starting with an IDR
+  picture and a fresh background, and up to SegmentParallel segments are encoded concurrently.
+  Since the POC is reset by the IDR picture of every segment, the segments are concatenated as
+  done by parcat, i.e. only the parameter sets of the first segment are kept.
+ */
+Void EncApp::xEncodeSegments()
+{
+  const Int segmentLength = m_segmentLength > 0 ? m_segmentLength : m_iIntraPeriod;
+  const Int numSegments   = ( m_framesToBeEncoded + segmentLength - 1 ) / segmentLength;
+  const Int numJobs       = std::min( m_numSegmentJobs, numSegments );
+
+  std::vector<EncApp*> segments( numSegments, nullptr );
+
+  // the segment encoders are configured with the same command line, restricted to their frame range
+  const MsgLevel verbosity = g_verbosity;
+
+  for( Int s = 0; s < numSegments; s++ )
+  {
+    const Int numFrames = std::min( segmentLength, m_framesToBeEncoded - s * segmentLength );
+
+    std::vector<std::string> args = m_cmdLineArgs;
+    args.push_back( "--SegmentParallel=0" );
+    args.push_back( "--Verbosity=" + std::to_string( (Int) WARNING ) );
+    args.push_back( "--FrameSkip=" + std::to_string( m_FrameSkip + s * segmentLength * m_temporalSubsampleRatio ) );
+    args.push_back( "--FramesToBeEncoded=" + std::to_string( numFrames * m_temporalSubsampleRatio ) );
+    if( !m_reconFileName.empty() )
+    {
+      args.push_back( "--ReconFile=" + m_reconFileName + ".seg" + std::to_string( s ) );
+    }
+
+    std::vector<TChar*> argv;
+    for( auto &arg : args )
+    {
+      argv.push_back( &arg[0] );
+    }
+
+    segments[s] = new EncApp;
+    segments[s]->create();
+    if( !segments[s]->parseCfg( Int( argv.size() ), argv.data() ) )
+    {
+      EXIT( "failed to configure encoder for segment " << s );
+    }
+    segments[s]->m_segmentIdx = s;
+  }
+
+  g_verbosity = verbosity;
+
+  msg( INFO, "\nSegment-parallel encoding: %d segments of %d frames, %d jobs\n", numSegments, segmentLength, numJobs );
+
+  std::atomic<Int>                nextSegment( 0 );
+  std::vector<std::exception_ptr> errors( numJobs );
+  std::vector<std::thread>        jobs;
+
+  for( Int j = 0; j < numJobs; j++ )
+  {
+    jobs.push_back( std::thread( [&, j]()
+    {
+      try
+      {
+        for( Int s = nextSegment++; s < numSegments; s = nextSegment++ )
+        {
+          segments[s]->encode();
+        }
+      }
+      catch( ... )
+      {
+        errors[j] = std::current_exception();
+      }
+    } ) );
+  }
+
+  for( auto &job : jobs )
+  {
+    job.join();
+  }
+
+  for( auto &error : errors )
+  {
+    if( error )
+    {
+      std::rethrow_exception( error );
+    }
+  }
+
+  // concatenate the segments
+  ofstream reconFile;
+  if( !m_reconFileName.empty() )
+  {
+    reconFile.open( m_reconFileName.c_str(), fstream::binary | fstream::out );
+  }
+
+  for( Int s = 0; s < numSegments; s++ )
+  {
+    EncApp* segment = segments[s];
+
+    m_bitstream << segment->m_segmentBitstream.rdbuf();
+
+    if( reconFile.is_open() )
+    {
+      const std::string segmentReconFileName = segment->m_reconFileName;
+      {
+        ifstream segmentRecon( segmentReconFileName.c_str(), fstream::binary | fstream::in );
+        reconFile << segmentRecon.rdbuf();
+      }
+      std::remove( segmentReconFileName.c_str() );
+    }
+
+    m_iFrameRcvd     += segment->m_iFrameRcvd;
+    m_totalBytes     += segment->m_totalBytes;
+    m_essentialBytes += segment->m_essentialBytes;
+
+    segment->destroy();
+    delete segment;
+  }
+
+  xCloseBitstream();
+  DiagLog::flush();
+
+  printRateSummary();
+  xFinishProfiling();
+}
+
+/**
+  The profiler is shared by all encoder instances of the process, it is controlled by the
+  top-level encoder only, so the scopes of the segment encoders are included in its profile.
+ */
+Void EncApp::xStartProfiling()
+{
+#if ENABLE_PROFILING
+  if( m_profiling || !m_profilingTraceFile.empty() )
+  {
+    Profiler::setTraceLevel( m_profilingTraceFile.empty() ? -1 : m_profilingTraceLevel );
+    Profiler::start();
+  }
+#endif
+}
+
+Void EncApp::xFinishProfiling()
+{
+#if ENABLE_PROFILING
+  if( !Profiler::isEnabled() )
+  {
+    return;
+  }
+
+  Profiler::stop();
+
+  if( m_profiling )
+  {
+    Profiler::printSummary();
+  }
+  if( !m_profilingTraceFile.empty() && !Profiler::writeTrace( m_profilingTraceFile ) )
+  {
+    msg( WARNING, "\nUnable to write the profile trace to %s\n", m_profilingTraceFile.c_str() );
+  }
+#endif
+}
+
+/**
+  Reserve stdout for writing the bitstream to a pipe. This has to be done before anything is
+  printed: the original stdout is kept for the bitstream and the standard output is redirected
+  to stderr, so the console output of the application and the libraries does not end up in the
+  bitstream.
+ */
+Void EncApp::reserveStdout()
+{
+  fflush( stdout );
+#ifdef _WIN32
+  const int fd = _dup( _fileno( stdout ) );
+  _dup2( _fileno( stderr ), _fileno( stdout ) );
+  _setmode( fd, _O_BINARY );
+  s_stdoutBitstream = fd < 0 ? NULL : _fdopen( fd, "wb" );
+#else
+  const int fd = dup( fileno( stdout ) );
+  dup2( fileno( stderr ), fileno( stdout ) );
+  s_stdoutBitstream = fd < 0 ? NULL : fdopen( fd, "wb" );
+#endif
+}
+
+Void EncApp::xOpenBitstream()
+{
+  if( m_bitstreamFileName == "-" )
+  {
+    if( !s_stdoutBitstream )
+    {
+      EXIT( "stdout has not been reserved for writing the bitstream\n" );
+    }
+    m_bitstreamPipe = new StdioOutputBuf( s_stdoutBitstream );
+    static_cast<std::ios&>( m_bitstream ).rdbuf( m_bitstreamPipe );
+    return;
+  }
+
+  m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
+  if (!m_bitstream)
+  {
+    EXIT( "failed to open bitstream file " << m_bitstreamFileName.c_str() << " for writing\n");
+  }
+}
+
+Void EncApp::xCloseBitstream()
+{
+  if( m_bitstreamPipe )
+  {
+    m_bitstream.flush();
+    static_cast<std::ios&>( m_bitstream ).rdbuf( m_bitstream.rdbuf() );
+    delete m_bitstreamPipe;
+    m_bitstreamPipe = NULL;
+    return;
+  }
+
+  m_bitstream.close();
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -837,7 +1165,10 @@ Void EncApp::xWriteOutput( Int iNumEncoded, std::list<PelUnitBuf*>& recBufList
 
       if (!m_reconFileName.empty())
       {
-        m_cVideoIOYuvReconFile.write( *pcPicYuvRecTop, *pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        m_reconWriter.write( *pcPicYuvRecTop, *pcPicYuvRecBottom, [this, ipCSC]( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom )
+        {
+          m_cVideoIOYuvReconFile.write( picTop, picBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        } );
       }
     }
   }
@@ -848,8 +1179,10 @@ Void EncApp::xWriteOutput( Int iNumEncoded, std::list<PelUnitBuf*>& recBufList
       const PelUnitBuf* pcPicYuvRec = *(iterPicYuvRec++);
       if (!m_reconFileName.empty())
       {
-        m_cVideoIOYuvReconFile.write( *pcPicYuvRec,
-                                      ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+        m_reconWriter.write( *pcPicYuvRec, [this, ipCSC]( const CPelUnitBuf& pic, const CPelUnitBuf& )
+        {
+          m_cVideoIOYuvReconFile.write( pic, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+        } );
       }
     }
   }
@@ -858,6 +1191,32 @@ Void EncApp::xWriteOutput( Int iNumEncoded, std::list<PelUnitBuf*>& recBufList
 
 void EncApp::outputAU( const AccessUnit& au )
 {
+  if( m_segmentIdx >= 0 )
+  {
+    // all segments use the same parameter sets, only the ones of the first segment are kept
+    AccessUnit segmentAU;
+    for( auto nalu : au )
+    {
+      const Bool isParameterSet = nalu->m_nalUnitType == NAL_UNIT_SPS || nalu->m_nalUnitType == NAL_UNIT_PPS
+#if HEVC_VPS
+                               || nalu->m_nalUnitType == NAL_UNIT_VPS
+#endif
+                               ;
+      if( m_segmentIdx == 0 || m_segmentHeaderDone || !isParameterSet )
+      {
+        segmentAU.push_back( nalu );
+      }
+    }
+    m_segmentHeaderDone = true;
+
+    const vector<UInt>& stats = writeAnnexB( m_segmentBitstream, segmentAU );
+    rateStatsAccum( segmentAU, stats );
+
+    // the NAL units are owned by au
+    segmentAU.clear();
+    return;
+  }
+
   const vector<UInt>& stats = writeAnnexB(m_bitstream, au);
   rateStatsAccum(au, stats);
   m_bitstream.flush();
@@ -40,9 +40,11 @@
 
 #include <list>
 #include <ostream>
+#include <sstream>
 
 #include "EncoderLib/EncLib.h"
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsync.h"
 #include "CommonLib/NAL.h"
 #include "EncAppCfg.h"
 
@@ -56,25 +58,42 @@
 /// encoder application class
 class EncApp : public EncAppCfg, public AUWriterIf
 {
-private:
+protected:
   // class interface
   EncLib            m_cEncLib;                    ///< encoder class
   VideoIOYuv        m_cVideoIOYuvInputFile;       ///< input YUV file
   VideoIOYuv        m_cVideoIOYuvReconFile;       ///< output reconstruction file
+  VideoIOYuvAsyncWriter m_reconWriter;            ///< writes the reconstruction, on a separate thread if enabled
   Int               m_iFrameRcvd;                 ///< number of received frames
   UInt              m_essentialBytes;
   UInt              m_totalBytes;
   fstream           m_bitstream;
+  std::streambuf*   m_bitstreamPipe;              ///< writes the bitstream to the reserved stdout if BitstreamFile is "-"
+  static FILE*      s_stdoutBitstream;            ///< original stdout, reserved for the bitstream
+  Int               m_segmentIdx;                 ///< segment encoded by this instance in segment-parallel mode (-1: whole sequence)
+  Bool              m_segmentHeaderDone;          ///< parameter sets of the segment have been handled
+  std::stringstream m_segmentBitstream;           ///< access units of the segment, concatenated after all segments are encoded
 
-private:
+protected:
   // initialization
   Void xCreateLib  ( std::list<PelUnitBuf*>& recBufList
                     );                           ///< create files & encoder class
   Void xInitLibCfg ();                           ///< initialize internal variables
   Void xInitLib    (Bool isFieldCoding);         ///< initialize encoder class
   Void xDestroyLib ();                           ///< destroy encoder class
+  Void xCreateBgPictures ();                     ///< create the background pictures and hand them to the encoder
+  Void xDestroyBgPictures();
+
+  // segment-parallel encoding
+  Void xEncodeSegments();                        ///< encode independent segments concurrently and concatenate them
+
+  // profiling
+  Void xStartProfiling ();                       ///< start the profiler if requested
+  Void xFinishProfiling();                       ///< print the profile and write the trace
 
   // file I/O
+  Void xOpenBitstream   ();                      ///< open the bitstream file or the reserved stdout
+  Void xCloseBitstream  ();
   Void xWriteOutput     ( Int iNumEncoded, std::list<PelUnitBuf*>& recBufList
                          );                      ///< write bitstream to file
   Void rateStatsAccum   ( const AccessUnit& au, const std::vector<UInt>& stats);
@@ -127,6 +146,8 @@ public:
 
   Void  encode();                               ///< main encoding function
 
+  static Void reserveStdout();                  ///< keep stdout for the bitstream, console output is moved to stderr
+
   void  outputAU( const AccessUnit& au );
 
 };// END CLASS DEFINITION EncApp
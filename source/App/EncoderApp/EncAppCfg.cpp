@@ -45,6 +45,7 @@
 #include <limits>
 
 #include "Utilities/program_options_lite.h"
+#include "Utilities/VideoIOYuv.h"
 #include "CommonLib/Rom.h"
 #include "EncoderLib/RateCtrl.h"
 
@@ -353,6 +354,87 @@ strToScalingListMode[] =
 };
 #endif
 
+// Speed presets, from the slowest to the fastest. Each preset overrides the configuration files with a combination
+// of the fast-decision tools; "slow" keeps the shipped configuration. Options given on the command line take precedence.
+static const struct MapStrToPreset
+{
+  const TChar* str;
+  const TChar* options;
+}
+strToPreset[] =
+{
+  {"placebo",   "--FDM=0 --ECU=0 --CFM=0 --ESD=0 --LCTUFast=0 --FastMrg=0 --PBIntraFast=0 --SaveLoadEncInfo=0 --SaveLoadSplitDecision=0 "
+                "--TransformSkipFast=0 --ContentBasedFastQtbt=0 --E0023FastEnc=0 --FastUDIUseMPMEnabled=0 --FastMEForGenBLowDelayEnabled=0" },
+  {"slow",      "" },
+  {"medium",    "--ESD=1 --ContentBasedFastQtbt=1 --SaveLoadSplitDecision=1" },
+  {"fast",      "--ESD=1 --ContentBasedFastQtbt=1 --SaveLoadSplitDecision=1 --ECU=1 --CFM=1 --FastDeltaQP=1 --RDOQTS=0 "
+                "--SearchRange=64 --MinSearchWindow=16" },
+  {"faster",    "--ESD=1 --ContentBasedFastQtbt=1 --SaveLoadSplitDecision=1 --ECU=1 --CFM=1 --FastDeltaQP=1 --RDOQTS=0 "
+                "--SearchRange=32 --MinSearchWindow=8 --MaxBTDepth=2 --MaxBTDepthISliceL=2 --MaxBTDepthISliceC=2 --SelectiveRDOQ=1 --BgSkipIntra=1" },
+  {"veryfast",  "--ESD=1 --ContentBasedFastQtbt=1 --SaveLoadSplitDecision=1 --ECU=1 --CFM=1 --FastDeltaQP=1 --RDOQTS=0 "
+                "--SearchRange=16 --MinSearchWindow=8 --MaxBTDepth=1 --MaxBTDepthISliceL=2 --MaxBTDepthISliceC=2 --MTT=0 --SelectiveRDOQ=1 --BgSkipIntra=1" },
+  {"ultrafast", "--ESD=1 --ContentBasedFastQtbt=1 --SaveLoadSplitDecision=1 --ECU=1 --CFM=1 --FastDeltaQP=1 --RDOQTS=0 "
+                "--SearchRange=8 --MinSearchWindow=4 --MaxBTDepth=0 --MaxBTDepthISliceL=1 --MaxBTDepthISliceC=1 --MTT=0 --RDOQ=0 --HadamardME=0 --SAO=0 --BgSkipIntra=1" },
+};
+
+/** applies the options of the named speed preset on top of the parsed configuration and re-applies the command line,
+ *  so that options given explicitly on the command line still override the preset
+ */
+static Bool applyPreset( po::Options& opts, const std::string& preset, Int argc, TChar* argv[] )
+{
+  const MapStrToPreset* entry = nullptr;
+  for( const auto& p : strToPreset )
+  {
+    if( preset == p.str )
+    {
+      entry = &p;
+    }
+  }
+  if( !entry )
+  {
+    msg( ERROR, "Unknown preset `%s' (placebo, slow, medium, fast, faster, veryfast, ultrafast)\n", preset.c_str() );
+    return false;
+  }
+
+  std::vector<std::string> presetArgs;
+  std::istringstream       iss( entry->options );
+  std::string              option;
+  while( iss >> option )
+  {
+    presetArgs.push_back( option );
+  }
+
+  std::vector<const TChar*> presetArgv( 1, argv[0] );
+  for( const auto& arg : presetArgs )
+  {
+    presetArgv.push_back( arg.c_str() );
+  }
+  po::ErrorReporter err;
+  po::scanArgv( opts, Int( presetArgv.size() ), &presetArgv[0], err );
+  if( err.is_errored )
+  {
+    return false;
+  }
+
+  // the configuration files have been read already and are left out when re-applying the command line
+  std::vector<const TChar*> cmdArgv( 1, argv[0] );
+  for( Int i = 1; i < argc; i++ )
+  {
+    if( !strcmp( argv[i], "-c" ) )
+    {
+      i++;
+    }
+    else if( strncmp( argv[i], "--c=", 4 ) )
+    {
+      cmdArgv.push_back( argv[i] );
+    }
+  }
+  po::SilentReporter silent;
+  po::scanArgv( opts, Int( cmdArgv.size() ), &cmdArgv[0], silent );
+
+  return true;
+}
+
 template<typename T, typename P>
 static std::string enumToString(P map[], UInt mapLen, const T val)
 {
@@ -711,14 +793,15 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   opts.addOptions()
   ("help",                                            do_help,                                          false, "this help text")
   ("c",    po::parseConfigFile, "configuration file name")
+  ("Preset",                                          m_preset,                                    string(""), "Speed preset applied on top of the configuration files (placebo, slow, medium, fast, faster, veryfast, ultrafast)")
   ("WarnUnknowParameter,w",                           warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
   ("isSDR",                                           sdr,                                              false, "compatibility")
 #if ENABLE_SIMD_OPT
   ("SIMD",                                            ignore,                                      string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
 #endif
   // File, I/O and source parameters
-  ("InputFile,i",                                     m_inputFileName,                             string(""), "Original YUV input file name")
-  ("BitstreamFile,b",                                 m_bitstreamFileName,                         string(""), "Bitstream output file name")
+  ("InputFile,i",                                     m_inputFileName,                             string(""), "Original YUV input file name (-: read from stdin)")
+  ("BitstreamFile,b",                                 m_bitstreamFileName,                         string(""), "Bitstream output file name (-: write to stdout, console output goes to stderr)")
   ("ReconFile,o",                                     m_reconFileName,                             string(""), "Reconstructed YUV output file name")
   ("SourceWidth,-wdt",                                m_iSourceWidth,                                       0, "Source picture width")
   ("SourceHeight,-hgt",                               m_iSourceHeight,                                      0, "Source picture height")
@@ -739,6 +822,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("MSEBasedSequencePSNR",                            m_printMSEBasedSequencePSNR,                      false, "0 (default) emit sequence PSNR only as a linear average of the frame PSNRs, 1 = also emit a sequence PSNR based on an average of the frame MSEs")
   ("PrintFrameMSE",                                   m_printFrameMSE,                                  false, "0 (default) emit only bit count and PSNRs for each frame, 1 = also emit MSE values")
   ("PrintSequenceMSE",                                m_printSequenceMSE,                               false, "0 (default) emit only bit rate and PSNRs for the whole sequence, 1 = also emit MSE values")
+  ("AsyncMetrics",                                    m_asyncMetrics,                                   false, "Compute the PSNR of a picture on a worker thread while its bitstream is written")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceMode",                                 m_conformanceWindowMode,                              0, "Deprecated alias of ConformanceWindowMode")
@@ -763,6 +847,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("CtuStatsFile",                                    m_ctuStatsFileName,                            string(), "Filename of the per-CTU encoding time, decision and background statistics (CSV). If empty, do not produce a file.")
   ("Verbosity,v",                                     m_verbosity,                               (Int)VERBOSE, "Specifies the level of the verboseness")
 
   //Field coding parameters
@@ -808,6 +893,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("LCTUFast",                                        m_useFastLCTU,                                    false, "Fast methods for large CTU")
   ("FastMrg",                                         m_useFastMrg,                                     false, "Fast methods for inter merge")
   ("PBIntraFast",                                     m_usePbIntraFast,                                 false, "Fast assertion if the intra mode is probable")
+  ("FastIntraGradient",                               m_useFastIntraGradient,                           false, "Restrict the first intra SATD pass to the angular modes of the dominant gradient directions")
   ("AMaxBT",                                          m_useAMaxBT,                                      false, "Adaptive maximal BT-size")
   ("SaveLoadEncInfo",                                 m_useSaveLoadEncInfo,                             false, "Reuse of previous encoder decision for same block generated by different partition methods")
   ("SaveLoadSplitDecision",                           m_useSaveLoadSplitDecision,                       false, "Reuse of previous split decision for same block generated by different partition methods")
@@ -837,11 +923,13 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
 
   // motion search options
   ("DisableIntraInInter",                             m_bDisableIntraPUsInInterSlices,                  false, "Flag to disable intra PUs in inter slices")
+  ("BgSkipIntra",                                     m_bgSkipIntra,                                    false, "Skip intra modes in inter-slice CTUs fully covered by the background reference")
   ("FastSearch",                                      tmpMotionEstimationSearchMethod,  Int(MESEARCH_DIAMOND), "0:Full search 1:Diamond 2:Selective 3:Enhanced Diamond")
   ("SearchRange,-sr",                                 m_iSearchRange,                                      96, "Motion search range")
   ("BipredSearchRange",                               m_bipredSearchRange,                                  4, "Motion search range for bipred refinement")
   ("MinSearchWindow",                                 m_minSearchWindow,                                    8, "Minimum motion search window size for the adaptive window ME")
   ("RestrictMESampling",                              m_bRestrictMESampling,                            false, "Restrict ME Sampling for selective inter motion search")
+  ("HierarchicalME",                                  m_useHierarchicalME,                              false, "Start the integer motion search from a motion field estimated on 1/4 and 1/2 resolution pictures")
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                        false, "Enables clipping in the Bi-Pred ME. It is disabled to reduce encoder run-time")
   ("FastMEAssumingSmootherMVEnabled",                 m_bFastMEAssumingSmootherMVEnabled,                true, "Enables fast ME assuming a smoother MV.")
 
@@ -912,6 +1000,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
 #if T0196_SELECTIVE_RDOQ
   ("SelectiveRDOQ",                                   m_useSelectiveRDOQ,                               false, "Enable selective RDOQ")
 #endif
+  ("FastRDOQ",                                        m_fastRDOQ,                                           0, "Fast RDOQ. 0:disabled  1:skip coefficient groups without levels and the zero-out region  2:1 and last position only decision for blocks up to 64 samples")
   ("RDpenalty",                                       m_rdPenalty,                                          0, "RD-penalty for 32x32 TU for intra in non-intra slices. 0:disabled  1:RD-penalty  2:maximum RD-penalty")
 
   // Deblocking filter parameters
@@ -1015,6 +1104,8 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("FDM",                                             m_useFastDecisionForMerge,                         true, "Fast decision for Merge RD Cost")
   ("CFM",                                             m_bUseCbfFastMode,                                false, "Cbf fast mode setting")
   ("ESD",                                             m_useEarlySkipDetection,                          false, "Early SKIP detection setting")
+  ("SpeedGovernor",                                   m_useSpeedGovernor,                               false, "Lower or raise the encoder effort at run time to keep up with the target frame rate")
+  ("SpeedGovernorFps",                                m_speedGovernorFps,                                 0.0, "Target frame rate of the speed governor (0: frame rate of the input)")
   ( "RateControl",                                    m_RCEnableRateControl,                            false, "Rate control: enable rate control" )
   ( "TargetBitrate",                                  m_RCTargetBitrate,                                    0, "Rate control: target bit-rate" )
   ( "KeepHierarchicalBit",                            m_RCKeepHierarchicalBit,                              0, "Rate control: 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation" )
@@ -1209,6 +1300,18 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                       true, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
 #else
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
+#endif
+  ("SegmentParallel",                                 m_numSegmentJobs,                             0, "Number of segments encoded concurrently, segments are concatenated into one bitstream (0: off)")
+  ("SegmentLength",                                   m_segmentLength,                              0, "Number of frames per segment in segment-parallel encoding (0: IntraPeriod)")
+  ("AsyncInputFrames",                                m_asyncInputFrames,                           0, "Number of frames read ahead by a separate input thread (0: synchronous reading)")
+  ("MemoryMappedInput",                               m_memoryMappedInput,                      false, "Memory map the input YUV file instead of reading it through the stream buffer")
+  ("AsyncOutputFrames",                               m_asyncOutputFrames,                          0, "Number of reconstructed frames queued for a separate output thread (0: synchronous writing)")
+  ("PicBufferHugePages",                              m_picBufferHugePages,                     false, "Back large picture buffers by transparent huge pages where supported")
+  ("PicBufferCacheSize",                              m_picBufferCacheSize,                         0, "Maximum size in MiB of released picture buffers kept for reuse (0: unlimited)")
+#if ENABLE_PROFILING
+  ("Profiling",                                       m_profiling,                              false, "Print the time spent in the profiled scopes of the encoder")
+  ("ProfilingTraceFile",                              m_profilingTraceFile,                    string(), "Write the profiled scopes as Chrome trace (JSON) to the given file")
+  ("ProfilingTraceLevel",                             m_profilingTraceLevel,                        3, "Deepest scope level written to the trace (0: GOP, 1: picture, 2: slice/stage, 3: CTU, 4: mode, 5: kernel)")
 #endif
     ;
 
@@ -1243,8 +1346,14 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
     }
   }
 
+  if( !m_preset.empty() && !applyPreset( opts, m_preset, argc, argv ) )
+  {
+    return false;
+  }
+
   g_verbosity = MsgLevel( m_verbosity );
 
+  m_cmdLineArgs.assign( argv, argv + argc );
 
   /*
    * Set any derived parameters
@@ -1773,6 +1882,12 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   m_SubPuMvpMode = m_SubPuMvpMode > 0 ? 3 : 0;
 #endif
 
+  // writing the reconstruction to the null device is skipped entirely
+  if( VideoIOYuv::isNullDevice( m_reconFileName ) )
+  {
+    m_reconFileName.clear();
+  }
+
   // print-out parameters
   xPrintParameter();
 
@@ -1869,6 +1984,26 @@ Bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
 #endif
 
+  xConfirmPara( m_numSegmentJobs < 0, "Number of concurrently encoded segments cannot be negative" );
+  if( m_numSegmentJobs > 0 )
+  {
+    xConfirmPara( m_isField, "Segment-parallel encoding is not supported for field coding" );
+    xConfirmPara( m_segmentLength < 0, "Segment length cannot be negative" );
+    xConfirmPara( m_segmentLength == 0 && m_iIntraPeriod <= 0, "SegmentLength has to be specified when there is no intra period" );
+    xConfirmPara( m_segmentLength > 0 && m_iIntraPeriod > 0 && m_segmentLength % m_iIntraPeriod != 0, "SegmentLength must be a multiple of the intra period" );
+  }
+  xConfirmPara( m_asyncInputFrames < 0, "Number of asynchronously read input frames cannot be negative" );
+  xConfirmPara( m_memoryMappedInput && m_inputFileName == "-", "The input cannot be memory mapped when reading from stdin" );
+  xConfirmPara( m_numSegmentJobs > 0 && m_inputFileName == "-", "Segment-parallel encoding cannot read the input from stdin" );
+  xConfirmPara( m_numSegmentJobs > 0 && !m_ctuStatsFileName.empty(), "Per-CTU statistics are not supported for segment-parallel encoding" );
+  xConfirmPara( m_speedGovernorFps < 0, "SpeedGovernorFps must not be negative" );
+  xConfirmPara( m_numSegmentJobs > 0 && m_useSpeedGovernor, "The speed governor is not supported for segment-parallel encoding" );
+  xConfirmPara( m_asyncOutputFrames < 0, "Number of asynchronously written output frames cannot be negative" );
+  xConfirmPara( m_picBufferCacheSize < 0, "The picture buffer cache size cannot be negative" );
+#if ENABLE_PROFILING
+  xConfirmPara( m_profilingTraceLevel < 0 || m_profilingTraceLevel > 5, "ProfilingTraceLevel must be in the range of 0 to 5" );
+#endif
+
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
   xConfirmPara( m_bUsePerceptQPA && m_lumaLevelToDeltaQPMapping.mode >= 2, "QPA and SharpDeltaQP mode 2 cannot be used together" );
@@ -1884,6 +2019,7 @@ Bool EncAppCfg::xCheckParameter()
 
 
   xConfirmPara( m_useAMaxBT && !m_QTBT, "AMaxBT can only be used with QTBT!" );
+  xConfirmPara( m_fastRDOQ < 0 || m_fastRDOQ > 2, "FastRDOQ must be in the range of 0 to 2" );
 
 
 
@@ -2763,6 +2899,7 @@ Void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Sequence PSNR output                   : %s\n", ( m_printMSEBasedSequencePSNR ? "Linear average, MSE-based" : "Linear average only" ) );
   msg( DETAILS, "Sequence MSE output                    : %s\n", ( m_printSequenceMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Frame MSE output                       : %s\n", ( m_printFrameMSE ? "Enabled" : "Disabled" ) );
+  msg( DETAILS, "Asynchronous frame metrics             : %s\n", ( m_asyncMetrics ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Cabac-zero-word-padding                : %s\n", ( m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled" ) );
   if (m_isField)
   {
@@ -2891,6 +3028,7 @@ Void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "HAD:%d ", m_bUseHADME                          );
   msg( VERBOSE, "RDQ:%d ", m_useRDOQ                            );
   msg( VERBOSE, "RDQTS:%d ", m_useRDOQTS                        );
+  msg( VERBOSE, "FastRDOQ:%d ", m_fastRDOQ                      );
   msg( VERBOSE, "RDpenalty:%d ", m_rdPenalty                    );
 #if SHARP_LUMA_DELTA_QP
   msg( VERBOSE, "LQP:%d ", m_lumaLevelToDeltaQPMapping.mode     );
@@ -2899,11 +3037,21 @@ Void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "ASR:%d ", m_bUseASR                            );
   msg( VERBOSE, "MinSearchWindow:%d ", m_minSearchWindow        );
   msg( VERBOSE, "RestrictMESampling:%d ", m_bRestrictMESampling );
+  msg( VERBOSE, "HierarchicalME:%d ", m_useHierarchicalME       );
   msg( VERBOSE, "FEN:%d ", Int(m_fastInterSearchMode)           );
   msg( VERBOSE, "ECU:%d ", m_bUseEarlyCU                        );
   msg( VERBOSE, "FDM:%d ", m_useFastDecisionForMerge            );
   msg( VERBOSE, "CFM:%d ", m_bUseCbfFastMode                    );
   msg( VERBOSE, "ESD:%d ", m_useEarlySkipDetection              );
+  if( !m_preset.empty() )
+  {
+    msg( VERBOSE, "Preset:%s ", m_preset.c_str() );
+  }
+  msg( VERBOSE, "BgSkipIntra:%d ", m_bgSkipIntra                );
+  if( m_useSpeedGovernor )
+  {
+    msg( VERBOSE, "SpeedGovernor:%.2ffps ", m_speedGovernorFps > 0 ? m_speedGovernorFps : Double( m_iFrameRate ) / m_temporalSubsampleRatio );
+  }
   msg( VERBOSE, "RQT:%d ", !m_QTBT                              );
   msg( VERBOSE, "TransformSkip:%d ",     m_useTransformSkip     );
   msg( VERBOSE, "TransformSkipFast:%d ", m_useTransformSkipFast );
@@ -2976,6 +3124,7 @@ Void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "FastMrg:%d ", m_useFastMrg );
   msg( VERBOSE, "PBIntraFast:%d ", m_usePbIntraFast );
+  msg( VERBOSE, "FastIntraGradient:%d ", m_useFastIntraGradient );
   if( m_QTBT ) msg( VERBOSE, "AMaxBT:%d ", m_useAMaxBT );
   if( m_QTBT ) msg( VERBOSE, "E0023FastEnc:%d ", m_e0023FastEnc );
   if( m_QTBT ) msg( VERBOSE, "ContentBasedFastQtbt:%d ", m_contentBasedFastQtbt );
@@ -2987,6 +3136,18 @@ Void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  if( m_numSegmentJobs > 0 )
+  {
+    msg( VERBOSE, "SegmentParallel:%d SegmentLength:%d ", m_numSegmentJobs, m_segmentLength );
+  }
+  msg( VERBOSE, "AsyncInputFrames:%d MemoryMappedInput:%d AsyncOutputFrames:%d ", m_asyncInputFrames, m_memoryMappedInput, m_asyncOutputFrames );
+  msg( VERBOSE, "PicBufferHugePages:%d PicBufferCacheSize:%d ", m_picBufferHugePages, m_picBufferCacheSize );
+#if ENABLE_PROFILING
+  if( m_profiling || !m_profilingTraceFile.empty() )
+  {
+    msg( VERBOSE, "Profiling:%d ProfilingTraceLevel:%d ", m_profiling, m_profilingTraceLevel );
+  }
+#endif
 
   msg( VERBOSE, "\n\n");
 
@@ -105,6 +105,7 @@ protected:
   Bool      m_printMSEBasedSequencePSNR;
   Bool      m_printFrameMSE;
   Bool      m_printSequenceMSE;
+  Bool      m_asyncMetrics;
   Bool      m_cabacZeroWordPaddingEnabled;
   Bool      m_bClipInputVideoToRec709Range;
   Bool      m_bClipOutputVideoToRec709Range;
@@ -209,6 +210,7 @@ protected:
 
   bool      m_useFastLCTU;
   bool      m_usePbIntraFast;
+  bool      m_useFastIntraGradient;
   bool      m_useAMaxBT;
   bool      m_useFastMrg;
   bool      m_useSaveLoadEncInfo;
@@ -222,6 +224,20 @@ protected:
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_numSegmentJobs;                                 ///< number of segments encoded concurrently (0: sequential encoding)
+  int       m_segmentLength;                                  ///< number of frames per segment (0: intra period)
+  std::vector<std::string> m_cmdLineArgs;                     ///< command line, used to configure the segment encoders
+  std::string m_preset;                                       ///< speed preset applied on top of the configuration files
+  int       m_asyncInputFrames;                               ///< number of frames read ahead by the input thread (0: synchronous reading)
+  bool      m_memoryMappedInput;                              ///< memory map the input file
+  int       m_asyncOutputFrames;                              ///< number of reconstructed frames queued for the output thread (0: synchronous writing)
+  bool      m_picBufferHugePages;                             ///< back large picture buffers by huge pages
+  int       m_picBufferCacheSize;                             ///< maximum size in MiB of released picture buffers kept for reuse (0: unlimited)
+#if ENABLE_PROFILING
+  bool      m_profiling;                                      ///< print the run-time profile of the encoder
+  std::string m_profilingTraceFile;                           ///< output Chrome trace of the profiled scopes
+  int       m_profilingTraceLevel;                            ///< deepest scope level recorded in the trace
+#endif
 
   // transfom unit (TU) definition
   Int       m_quadtreeTULog2MaxSize;
@@ -277,10 +293,13 @@ protected:
 #if T0196_SELECTIVE_RDOQ
   Bool      m_useSelectiveRDOQ;                               ///< flag for using selective RDOQ
 #endif
+  Int       m_fastRDOQ;                                       ///< fast RDOQ (0: disabled, 1: skip groups without levels, 2: 1 and last position only for small blocks)
   Int       m_rdPenalty;                                      ///< RD-penalty for 32x32 TU for intra in non-intra slices (0: no RD-penalty, 1: RD-penalty, 2: maximum RD-penalty)
   Bool      m_bDisableIntraPUsInInterSlices;                  ///< Flag for disabling intra predicted PUs in inter slices.
+  Bool      m_bgSkipIntra;                                    ///< Skip intra modes in CTUs fully covered by the background reference
   MESearchMethod m_motionEstimationSearchMethod;
   Bool      m_bRestrictMESampling;                            ///< Restrict sampling for the Selective ME
+  Bool      m_useHierarchicalME;                              ///< start the integer ME from a motion field estimated on downsampled pictures
   Int       m_iSearchRange;                                   ///< ME search range
   Int       m_bipredSearchRange;                              ///< ME search range for bipred refinement
   Int       m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
@@ -291,6 +310,8 @@ protected:
   Bool      m_useFastDecisionForMerge;                        ///< flag for using Fast Decision Merge RD-Cost
   Bool      m_bUseCbfFastMode;                                ///< flag for using Cbf Fast PU Mode Decision
   Bool      m_useEarlySkipDetection;                          ///< flag for using Early SKIP Detection
+  Bool      m_useSpeedGovernor;                               ///< adapt the encoder effort to the target frame rate
+  Double    m_speedGovernorFps;                               ///< target frame rate of the speed governor, 0: input frame rate
   SliceConstraint m_sliceMode;
   Int             m_sliceArgument;                            ///< argument according to selected slice mode
 #if HEVC_DEPENDENT_SLICES
@@ -464,6 +485,7 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  std::string m_ctuStatsFileName;                             ///< filename of the per-CTU statistics, no statistics if empty.
 
   Int         m_verbosity;
 
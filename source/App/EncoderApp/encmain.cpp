@@ -83,6 +83,21 @@ static void printMacroSettings()
 
 int main(int argc, char* argv[])
 {
+  // the bitstream is written to stdout: move the console output to stderr before anything is printed
+  {
+    std::string bitstreamFileName;
+    df::program_options_lite::Options opts;
+    opts.addOptions()
+      ( "BitstreamFile,b", bitstreamFileName, string( "" ), "" )
+      ( "c", df::program_options_lite::parseConfigFile, "" );
+    df::program_options_lite::SilentReporter err;
+    df::program_options_lite::scanArgv( opts, argc, ( const TChar** ) argv, err );
+    if( bitstreamFileName == "-" )
+    {
+      EncApp::reserveStdout();
+    }
+  }
+
   // print information
   fprintf( stdout, "\n" );
 #ifdef SVNREVISION
@@ -84,10 +84,22 @@ UInt SEIRemovalApp::decode()
 //  Int                 poc;
 //  PicList* pcListPic = NULL;
 
-  ifstream bitstreamFileIn(m_bitstreamFileNameIn.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFileIn)
+  ifstream              bitstreamFileIn;
+  MappedInputByteStream mappedBitstreamIn;
+  if (m_memoryMappedInput)
   {
-    EXIT( "failed to open bitstream file " << m_bitstreamFileNameIn.c_str() << " for reading" ) ;
+    if (!mappedBitstreamIn.open(m_bitstreamFileNameIn))
+    {
+      EXIT( "failed to map bitstream file " << m_bitstreamFileNameIn.c_str() << " for reading" ) ;
+    }
+  }
+  else
+  {
+    bitstreamFileIn.open(m_bitstreamFileNameIn.c_str(), ifstream::in | ifstream::binary);
+    if (!bitstreamFileIn)
+    {
+      EXIT( "failed to open bitstream file " << m_bitstreamFileNameIn.c_str() << " for reading" ) ;
+    }
   }
 
   ofstream bitstreamFileOut(m_bitstreamFileNameOut.c_str(), ifstream::out | ifstream::binary);
@@ -99,7 +111,7 @@ UInt SEIRemovalApp::decode()
 
   int unitCnt = 0;
 
-  while (!!bitstreamFileIn)
+  while (m_memoryMappedInput ? !mappedBitstreamIn.eof() : !!bitstreamFileIn)
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -107,11 +119,24 @@ UInt SEIRemovalApp::decode()
      * nal unit. */
     AnnexBStats stats = AnnexBStats();
 
-    InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    InputNALUnit   nalu;
+    const uint8_t* nalUnitData = nullptr;
+    std::size_t    nalUnitSize = 0;
+    if (m_memoryMappedInput)
+    {
+      // only the NAL unit header is needed for the decision, the payload is written directly from the mapping
+      byteStreamNALUnit(mappedBitstreamIn, nalUnitData, nalUnitSize, stats);
+      nalu.getBitstream().getFifo().assign(nalUnitData, nalUnitData + std::min<std::size_t>(nalUnitSize, 2));
+    }
+    else
+    {
+      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+      nalUnitData = nalu.getBitstream().getFifo().data();
+      nalUnitSize = nalu.getBitstream().getFifo().size();
+    }
 
     // call actual decoding function
-    if (nalu.getBitstream().getFifo().empty())
+    if (nalUnitSize == 0)
     {
       /* this can happen if the following occur:
        *  - empty input file
@@ -137,7 +162,7 @@ UInt SEIRemovalApp::decode()
         char ch = 0;
         for( int i = 0 ; i < iNumZeros; i++ ) { bitstreamFileOut.write( &ch, 1 ); }
         ch = 1; bitstreamFileOut.write( &ch, 1 );
-        bitstreamFileOut.write( (const char*)nalu.getBitstream().getFifo().data(), nalu.getBitstream().getFifo().size() );
+        bitstreamFileOut.write( (const char*)nalUnitData, nalUnitSize );
       }
     }
   }
@@ -64,6 +64,7 @@ Bool SEIRemovalAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("help",                      do_help,                               false,      "this help text")
   ("BitstreamFileIn,b",         m_bitstreamFileNameIn,                 string(""), "bitstream input file name")
   ("BitstreamFileOut,o",        m_bitstreamFileNameOut,                string(""), "bitstream output file name")
+  ("MemoryMappedInput",         m_memoryMappedInput,                   false,      "memory map the input bitstream file and copy NAL units directly from the mapping")
   ("DiscardPrefixSEI,p",        m_discardPrefixSEIs,                   false,      "remove all prefix SEIs (default: 0)")
   ("DiscardSuffixSEI,s",        m_discardSuffixSEIs,                   true,       "remove all suffix SEIs (default: 1)")
   ("NumSkip",                   m_numNALUnitsToSkip,                   0,          "number of NAL units to skip (counted inclusive the units skipped with -p/-s options)" )
@@ -115,6 +116,7 @@ Bool SEIRemovalAppCfg::parseCfg( Int argc, TChar* argv[] )
 SEIRemovalAppCfg::SEIRemovalAppCfg()
 : m_bitstreamFileNameIn()
 , m_bitstreamFileNameOut()
+, m_memoryMappedInput( false )
 , m_discardPrefixSEIs( false )
 , m_discardSuffixSEIs( false )
 {
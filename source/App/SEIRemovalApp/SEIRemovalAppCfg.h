@@ -58,6 +58,7 @@ class SEIRemovalAppCfg
 protected:
   std::string   m_bitstreamFileNameIn;                ///< output bitstream file name
   std::string   m_bitstreamFileNameOut;               ///< input bitstream file name
+  bool          m_memoryMappedInput;                  ///< memory map the input bitstream file instead of reading it through a stream
   bool          m_discardPrefixSEIs;
   bool          m_discardSuffixSEIs;
   int           m_numNALUnitsToSkip;
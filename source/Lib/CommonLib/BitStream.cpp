@@ -92,11 +92,13 @@ Void InputBitstream::resetToStart()
 
 UChar* OutputBitstream::getByteStream() const
 {
+  xFlushHeldBytes();
   return (UChar*) &m_fifo.front();
 }
 
 UInt OutputBitstream::getByteStreamLength()
 {
+  xFlushHeldBytes();
   return UInt(m_fifo.size());
 }
 
@@ -107,48 +109,45 @@ Void OutputBitstream::clear()
   m_num_held_bits = 0;
 }
 
-Void OutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
+Void OutputBitstream::xFlushHeldBytes() const
 {
-  CHECK( uiNumberOfBits > 32, "Number of bits is exceeds '32'" );
-  CHECK( uiNumberOfBits != 32 && (uiBits & (~0 << uiNumberOfBits)) != 0, "Unsupported parameters" );
+  const UInt numBytes = m_num_held_bits >> 3;
+
+  if( numBytes == 0 )
+  {
+    return;
+  }
 
-  /* any modulo 8 remainder of num_total_bits cannot be written this time,
-   * and will be held until next time. */
-  UInt num_total_bits = uiNumberOfBits + m_num_held_bits;
-  UInt next_num_held_bits = num_total_bits % 8;
+  const std::size_t pos = m_fifo.size();
+  m_fifo.resize( pos + numBytes );
 
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  UChar next_held_bits = uiBits << (8 - next_num_held_bits);
+  /* msb-align the accumulator and emit its complete bytes in one go */
+  uint8_t* dst      = &m_fifo[pos];
+  const uint64_t v  = m_held_bits << ( 64 - m_num_held_bits );
 
-  if (!(num_total_bits >> 3))
+  for( UInt i = 0; i < numBytes; i++ )
   {
-    /* insufficient bits accumulated to write out, append new_held_bits to
-     * current held_bits */
-    /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
-    m_num_held_bits = next_num_held_bits;
-    return;
+    dst[i] = uint8_t( v >> ( 56 - 8 * i ) );
   }
 
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  UInt topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  UInt write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
+  m_num_held_bits &= 0x7;
+  m_held_bits     &= ( uint64_t( 1 ) << m_num_held_bits ) - 1;
+}
 
-  switch (num_total_bits >> 3)
+Void OutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
+{
+  CHECK( uiNumberOfBits > 32, "Number of bits is exceeds '32'" );
+  CHECK( uiNumberOfBits != 32 && (uiBits & (~0 << uiNumberOfBits)) != 0, "Unsupported parameters" );
+
+  /* the accumulator always has room for 32 new bits after a flush,
+   * since at most 7 bits are held back from a flush */
+  if( m_num_held_bits + uiNumberOfBits > 64 )
   {
-  case 4: m_fifo.push_back(write_bits >> 24);
-  case 3: m_fifo.push_back(write_bits >> 16);
-  case 2: m_fifo.push_back(write_bits >> 8);
-  case 1: m_fifo.push_back(write_bits);
+    xFlushHeldBytes();
   }
 
-  m_held_bits = next_held_bits;
-  m_num_held_bits = next_num_held_bits;
+  m_held_bits      = ( m_held_bits << uiNumberOfBits ) | uiBits;
+  m_num_held_bits += uiNumberOfBits;
 }
 
 Void OutputBitstream::writeAlignOne()
@@ -160,11 +159,12 @@ Void OutputBitstream::writeAlignOne()
 
 Void OutputBitstream::writeAlignZero()
 {
+  xFlushHeldBytes();
   if (0 == m_num_held_bits)
   {
     return;
   }
-  m_fifo.push_back(m_held_bits);
+  m_fifo.push_back( UChar( m_held_bits << ( 8 - m_num_held_bits ) ) );
   m_held_bits = 0;
   m_num_held_bits = 0;
 }
@@ -179,9 +179,25 @@ Void   OutputBitstream::addSubstream( OutputBitstream* pcSubstream )
   UInt uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if( getNumBitsUntilByteAligned() == 0 )
   {
-    write(*it++, 8);
+    /* byte-aligned, the complete bytes can be appended as a block */
+    xFlushHeldBytes();
+    m_fifo.insert( m_fifo.end(), rbsp.begin(), rbsp.end() );
+  }
+  else
+  {
+    const std::size_t numWords = rbsp.size() >> 2;
+    const uint8_t*    src      = rbsp.data();
+
+    for( std::size_t i = 0; i < numWords; i++, src += 4 )
+    {
+      write( ( UInt( src[0] ) << 24 ) | ( UInt( src[1] ) << 16 ) | ( UInt( src[2] ) << 8 ) | src[3], 32 );
+    }
+    for( const uint8_t* end = rbsp.data() + rbsp.size(); src < end; src++ )
+    {
+      write( *src, 8 );
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -237,17 +253,29 @@ Int OutputBitstream::countStartCodeEmulations()
  */
 Void InputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
 {
-  UInt saved_num_held_bits = m_num_held_bits;
-  UChar saved_held_bits = m_held_bits;
-  UInt saved_fifo_idx = m_fifo_idx;
+  CHECK( uiNumberOfBits > 32, "Too many bits read" );
 
-  UInt num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
-  read(num_bits_to_read, ruiBits);
-  ruiBits <<= (uiNumberOfBits - num_bits_to_read);
+  if( uiNumberOfBits == 0 )
+  {
+    ruiBits = 0;
+    return;
+  }
 
-  m_fifo_idx = saved_fifo_idx;
-  m_held_bits = saved_held_bits;
-  m_num_held_bits = saved_num_held_bits;
+  /* assemble the held bits and the next four bytes msb-aligned in a 64-bit window,
+   * bytes beyond the end of the fifo read as zero */
+  const UInt   numBytes = std::min<UInt>( 4, UInt( m_fifo.size() ) - m_fifo_idx );
+  const UChar* src      = m_fifo.data() + m_fifo_idx;
+  uint64_t     window   = m_num_held_bits ? uint64_t( m_held_bits & ~( 0xff << m_num_held_bits ) ) << ( 64 - m_num_held_bits ) : 0;
+
+  for( UInt i = 0; i < numBytes; i++ )
+  {
+    window |= uint64_t( src[i] ) << ( 56 - m_num_held_bits - 8 * i );
+  }
+
+  ruiBits = UInt( window >> ( 64 - uiNumberOfBits ) );
+
+  /* keep the bit count of the former read-and-restore implementation */
+  m_numBitsRead += std::min( uiNumberOfBits, getNumBitsLeft() );
 }
 
 
@@ -292,12 +320,23 @@ Void InputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
   UInt num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
   CHECK(m_fifo_idx + num_bytes_to_load >= m_fifo.size(), "Exceeded FIFO size");
 
-  switch (num_bytes_to_load)
+  if( m_fifo_idx + 4 <= m_fifo.size() )
   {
-  case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
-  case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
-  case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= m_fifo[m_fifo_idx++];
+    /* load a whole big-endian word and drop the bytes that are not consumed */
+    const UChar* src = &m_fifo[m_fifo_idx];
+    aligned_word     = ( UInt( src[0] ) << 24 ) | ( UInt( src[1] ) << 16 ) | ( UInt( src[2] ) << 8 ) | src[3];
+    aligned_word   >>= 8 * ( 3 - num_bytes_to_load );
+    m_fifo_idx      += num_bytes_to_load + 1;
+  }
+  else
+  {
+    switch (num_bytes_to_load)
+    {
+    case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
+    case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
+    case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
+    case 0: aligned_word |= m_fifo[m_fifo_idx++];
+    }
   }
 
   /* resolve remainder bits */
@@ -321,6 +360,9 @@ Void OutputBitstream::insertAt(const OutputBitstream& src, UInt pos)
 {
   CHECK(0 != src.getNumberOfWrittenBits() % 8, "Number of written bits is not a multiple of 8");
 
+  src.xFlushHeldBytes();
+  xFlushHeldBytes();
+
   vector<uint8_t>::iterator at = m_fifo.begin() + pos;
   m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end());
 }
@@ -66,11 +66,16 @@ class OutputBitstream
    *  - &fifo.front() to get a pointer to the data array.
    *    NB, this pointer is only valid until the next push_back()/clear()
    */
-  std::vector<uint8_t> m_fifo;
+  mutable std::vector<uint8_t> m_fifo;
+
+  mutable UInt     m_num_held_bits; /// number of bits not flushed to bytestream.
+  mutable uint64_t m_held_bits;     /// 64-bit accumulator of the bits held and not flushed to bytestream.
+                                    /// this value is always lsb-aligned, complete bytes are only flushed
+                                    /// to the fifo when the accumulator is full or the fifo is accessed.
+
+  /** move all complete bytes from the accumulator to the fifo */
+  Void        xFlushHeldBytes () const;
 
-  UInt m_num_held_bits; /// number of bits not flushed to bytestream.
-  UChar m_held_bits; /// the bits held and not flushed to bytestream.
-                             /// this value is always msb-aligned, bigendian.
 public:
   // create / destroy
   OutputBitstream();
@@ -125,13 +130,14 @@ public:
   /**
    * Return a reference to the internal fifo
    */
-  std::vector<uint8_t>& getFIFO() { return m_fifo; }
+  std::vector<uint8_t>& getFIFO() { xFlushHeldBytes(); return m_fifo; }
 
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  /** Return the bits of the incomplete last byte, msb-aligned */
+  UChar getHeldBits  ()          { xFlushHeldBytes(); return UChar( m_held_bits << ( 8 - m_num_held_bits ) ); }
 
   //OutputBitstream& operator= (const OutputBitstream& src);
   /** Return a reference to the internal fifo */
-  const std::vector<uint8_t>& getFIFO() const { return m_fifo; }
+  const std::vector<uint8_t>& getFIFO() const { xFlushHeldBytes(); return m_fifo; }
 
   Void          addSubstream    ( OutputBitstream* pcSubstream );
   Void writeByteAlignment();
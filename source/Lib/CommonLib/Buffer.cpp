@@ -40,6 +40,7 @@
 // unit needs to come first due to a forward declaration
 #include "Unit.h"
 #include "Buffer.h"
+#include "BufferPool.h"
 #include "InterpolationFilter.h"
 
 #if ENABLE_SIMD_OPT_BUFFER
@@ -93,6 +94,38 @@ void linTfCore( const T* src, int srcStride, Pel *dst, int dstStride, int width,
 #undef LINTF_CORE_INC
 }
 
+template<typename T>
+void sobelCore( const T* src, int srcStride, Pel* gradX, Pel* gradY, int width )
+{
+  const T* above = src - srcStride;
+  const T* below = src + srcStride;
+
+  for( int x = 0; x < width; x++ )
+  {
+    gradX[x] = ( above[x + 1] + 2 * src[x + 1] + below[x + 1] ) - ( above[x - 1] + 2 * src[x - 1] + below[x - 1] );
+    gradY[x] = ( below[x - 1] + 2 * below[x] + below[x + 1] ) - ( above[x - 1] + 2 * above[x] + above[x + 1] );
+  }
+}
+
+template<typename T>
+uint64_t ssdCore( const T* src0, int src0Stride, const T* src1, int src1Stride, int width, int height )
+{
+  uint64_t sum = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int64_t diff = ( int64_t ) src0[x] - ( int64_t ) src1[x];
+      sum += uint64_t( diff * diff );
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+  return sum;
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg4 = addAvgCore<Pel>;
@@ -103,6 +136,10 @@ PelBufferOps::PelBufferOps()
 
   linTf4 = linTfCore<Pel>;
   linTf8 = linTfCore<Pel>;
+
+  sobel8 = sobelCore<Pel>;
+
+  ssd8 = ssdCore<Pel>;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -308,6 +345,7 @@ PelStorage::PelStorage()
   {
     m_origin[i] = nullptr;
   }
+  m_pooled = false;
 }
 
 PelStorage::~PelStorage()
@@ -320,11 +358,12 @@ void PelStorage::create( const UnitArea &_UnitArea )
   create( _UnitArea.chromaFormat, _UnitArea.blocks[0] );
 }
 
-void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize, const unsigned _margin, const unsigned _alignment, const bool _scaleChromaMargin )
+void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize, const unsigned _margin, const unsigned _alignment, const bool _scaleChromaMargin, const bool _pooled )
 {
   CHECK( !bufs.empty(), "Trying to re-create an already initialized buffer" );
 
   chromaFormat = _chromaFormat;
+  m_pooled     = _pooled;
 
   const UInt numCh = getNumberValidComponents( _chromaFormat );
 
@@ -359,7 +398,7 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, c
     UInt area = totalWidth * totalHeight;
     CHECK( !area, "Trying to create a buffer with zero area" );
 
-    m_origin[i] = ( Pel* ) xMalloc( Pel, area );
+    m_origin[i] = m_pooled ? PicBufferPool::getInstance().alloc( area ) : ( Pel* ) xMalloc( Pel, area );
     Pel* topLeft = m_origin[i] + totalWidth * ymargin + xmargin;
     bufs.push_back( PelBuf( topLeft, totalWidth, _area.width >> scaleX, _area.height >> scaleY ) );
   }
@@ -395,6 +434,7 @@ void PelStorage::swap( PelStorage& other )
     std::swap( bufs[i].stride, other.bufs[i].stride );
     std::swap( m_origin[i],    other.m_origin[i] );
   }
+  std::swap( m_pooled, other.m_pooled );
 }
 
 void PelStorage::destroy()
@@ -404,10 +444,18 @@ void PelStorage::destroy()
   {
     if( m_origin[i] )
     {
-      xFree( m_origin[i] );
+      if( m_pooled )
+      {
+        PicBufferPool::getInstance().release( m_origin[i] );
+      }
+      else
+      {
+        xFree( m_origin[i] );
+      }
       m_origin[i] = nullptr;
     }
   }
+  m_pooled = false;
   bufs.clear();
 }
 
@@ -68,6 +68,8 @@ struct PelBufferOps
   void ( *reco8 )         ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,                                   const ClpRng& clpRng );
   void ( *linTf4 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
   void ( *linTf8 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
+  void ( *sobel8 )        ( const Pel* src,  int srcStride,  Pel* gradX, Pel* gradY, int width );
+  uint64_t ( *ssd8 )      ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height );
 };
 
 extern PelBufferOps g_pelBufOP;
@@ -737,7 +739,7 @@ struct PelStorage : public PelUnitBuf
   void swap( PelStorage& other );
   void createFromBuf( PelUnitBuf buf );
   void create( const UnitArea &_unit );
-  void create( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize = 0, const unsigned _margin = 0, const unsigned _alignment = 0, const bool _scaleChromaMargin = true );
+  void create( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize = 0, const unsigned _margin = 0, const unsigned _alignment = 0, const bool _scaleChromaMargin = true, const bool _pooled = false );
   void destroy();
 
          PelBuf getBuf( const CompArea &blk );
@@ -752,6 +754,7 @@ struct PelStorage : public PelUnitBuf
 private:
 
   Pel *m_origin[MAX_NUM_COMPONENT];
+  bool m_pooled;                      ///< the planes are taken from the PicBufferPool
 };
 
 
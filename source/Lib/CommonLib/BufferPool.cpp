@@ -0,0 +1,186 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/** \file     BufferPool.cpp
+ *  \brief    Process-wide pool of picture sample buffers
+ */
+
+#include "BufferPool.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+PicBufferPool& PicBufferPool::getInstance()
+{
+  // never destroyed, pictures may still be released during static destruction
+  static PicBufferPool* pool = new PicBufferPool;
+  return *pool;
+}
+
+PicBufferPool::PicBufferPool()
+  : m_cachedBytes   ( 0 )
+  , m_maxCachedBytes( 0 )
+  , m_useHugePages  ( false )
+{
+}
+
+PicBufferPool::~PicBufferPool()
+{
+  trim();
+}
+
+void PicBufferPool::setUseHugePages( bool useHugePages )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_useHugePages = useHugePages;
+}
+
+void PicBufferPool::setMaxCachedBytes( size_t maxCachedBytes )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_maxCachedBytes = maxCachedBytes;
+}
+
+Pel* PicBufferPool::alloc( size_t numSamples )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  const size_t allocSize = xGetAllocSize( numSamples * sizeof( Pel ) );
+  void*        buf       = nullptr;
+
+  auto freeBufs = m_freeBufs.find( allocSize );
+  if( freeBufs != m_freeBufs.end() && !freeBufs->second.empty() )
+  {
+    buf = freeBufs->second.back();
+    freeBufs->second.pop_back();
+    m_cachedBytes -= allocSize;
+  }
+  else
+  {
+    buf = xAllocSystem( allocSize );
+    CHECK( !buf, "Failed to allocate a picture buffer" );
+  }
+
+  m_usedBufs[buf] = allocSize;
+  return ( Pel* ) buf;
+}
+
+void PicBufferPool::release( Pel* buf )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  auto usedBuf = m_usedBufs.find( buf );
+  CHECK( usedBuf == m_usedBufs.end(), "Releasing a buffer that is not owned by the pool" );
+
+  const size_t allocSize = usedBuf->second;
+  m_usedBufs.erase( usedBuf );
+
+  if( m_maxCachedBytes && m_cachedBytes + allocSize > m_maxCachedBytes )
+  {
+    xFreeSystem( buf, allocSize );
+    return;
+  }
+
+  m_freeBufs[allocSize].push_back( buf );
+  m_cachedBytes += allocSize;
+}
+
+void PicBufferPool::trim()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  for( auto &freeBufs : m_freeBufs )
+  {
+    for( auto &buf : freeBufs.second )
+    {
+      xFreeSystem( buf, freeBufs.first );
+    }
+  }
+  m_freeBufs.clear();
+  m_cachedBytes = 0;
+}
+
+/// buffers are rounded up to whole pages, large ones to whole huge pages, so similar sizes share a pool entry
+size_t PicBufferPool::xGetAllocSize( size_t numBytes ) const
+{
+  const size_t pageSize = numBytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : 4096;
+  return ( ( numBytes + pageSize - 1 ) / pageSize ) * pageSize;
+}
+
+void* PicBufferPool::xAllocSystem( size_t allocSize )
+{
+#ifdef _WIN32
+  return VirtualAlloc( NULL, allocSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+#else
+  if( !m_useHugePages || allocSize < HUGE_PAGE_SIZE )
+  {
+    void* buf = mmap( NULL, allocSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    return buf == MAP_FAILED ? nullptr : buf;
+  }
+
+  // huge pages need a huge page aligned range, the unaligned head and tail are unmapped again
+  void* range = mmap( NULL, allocSize + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+  if( range == MAP_FAILED )
+  {
+    return nullptr;
+  }
+  char*        buf  = ( char* ) ( ( ( size_t ) range + HUGE_PAGE_SIZE - 1 ) & ~( HUGE_PAGE_SIZE - 1 ) );
+  const size_t head = buf - ( char* ) range;
+  if( head )
+  {
+    munmap( range, head );
+  }
+  munmap( buf + allocSize, HUGE_PAGE_SIZE - head );
+#ifdef MADV_HUGEPAGE
+  madvise( buf, allocSize, MADV_HUGEPAGE );
+#endif
+  return buf;
+#endif
+}
+
+void PicBufferPool::xFreeSystem( void* buf, size_t allocSize )
+{
+#ifdef _WIN32
+  VirtualFree( buf, 0, MEM_RELEASE );
+#else
+  munmap( buf, allocSize );
+#endif
+}
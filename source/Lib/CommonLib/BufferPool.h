@@ -0,0 +1,89 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     BufferPool.h
+ *  \brief    Process-wide pool of picture sample buffers (header)
+ */
+
+#ifndef __BUFFERPOOL__
+#define __BUFFERPOOL__
+
+#include "CommonDef.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// PicBufferPool class
+// ---------------------------------------------------------------------------
+
+/**
+  Size-keyed pool of the sample buffers of pictures. All encoder and decoder instances of a
+  process draw their picture planes from it and return them on destruction, so the memory of
+  finished pictures and streams is reused instead of being unmapped and faulted in again.
+  The buffers are page aligned; buffers of at least the huge page size can be backed by
+  transparent huge pages.
+ */
+class PicBufferPool
+{
+public:
+  static PicBufferPool& getInstance();
+
+  void   setUseHugePages   ( bool useHugePages );        ///< back large buffers allocated from now on by huge pages, where supported
+  void   setMaxCachedBytes ( size_t maxCachedBytes );    ///< limit of the released memory kept for reuse (0: unlimited)
+
+  Pel*   alloc             ( size_t numSamples );
+  void   release           ( Pel* buf );
+  void   trim              ();                           ///< return all cached buffers to the system
+
+  size_t getCachedBytes    () const { return m_cachedBytes; }
+
+private:
+  PicBufferPool();
+  ~PicBufferPool();
+
+  size_t xGetAllocSize     ( size_t numBytes ) const;
+  void*  xAllocSystem      ( size_t allocSize );
+  void   xFreeSystem       ( void* buf, size_t allocSize );
+
+  std::mutex                                      m_mutex;
+  std::unordered_map<size_t, std::vector<void*> > m_freeBufs;       ///< released buffers by allocation size
+  std::unordered_map<void*, size_t>               m_usedBufs;       ///< allocation size of the buffers in use
+  size_t                                          m_cachedBytes;
+  size_t                                          m_maxCachedBytes;
+  bool                                            m_useHugePages;
+};
+
+#endif
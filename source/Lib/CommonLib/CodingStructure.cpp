@@ -44,7 +44,7 @@
 #include "UnitPartitioner.h"
 
 
-XUCache g_globalUnitCache = XUCache();
+thread_local XUCache g_globalUnitCache = XUCache();
 
 const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
 {
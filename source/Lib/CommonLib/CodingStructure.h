@@ -59,7 +59,7 @@ enum PictureType
   NUM_PIC_TYPES
 };
 
-extern XUCache g_globalUnitCache;
+extern thread_local XUCache g_globalUnitCache;
 
 // ---------------------------------------------------------------------------
 // coding structure
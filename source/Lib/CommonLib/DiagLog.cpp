@@ -0,0 +1,198 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/** \file     DiagLog.cpp
+ *  \brief    Buffered diagnostic output
+ */
+
+#include "DiagLog.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+static const size_t DIAG_LOG_BUFFER_SIZE = 1 << 14;
+
+struct DiagLogChunk
+{
+  std::string   text;
+  DiagLogChunk* next;
+};
+
+/// the pending chunks and the writer thread, never destroyed as threads may log during static destruction
+struct DiagLogWriter
+{
+  DiagLogWriter()
+    : pending( nullptr )
+    , numQueued( 0 )
+    , numWritten( 0 )
+  {
+    thread = std::thread( &DiagLogWriter::writeLoop, this );
+    thread.detach();
+  }
+
+  void push( std::string& text )
+  {
+    DiagLogChunk* chunk = new DiagLogChunk;
+    chunk->text.swap( text );
+    chunk->next = pending.load( std::memory_order_relaxed );
+    while( !pending.compare_exchange_weak( chunk->next, chunk, std::memory_order_release, std::memory_order_relaxed ) );
+    numQueued++;
+    cond.notify_one();
+  }
+
+  void waitWritten()
+  {
+    const uint64_t target = numQueued.load();
+    std::unique_lock<std::mutex> lock( mutex );
+    cond.notify_one();
+    writtenCond.wait( lock, [&] { return numWritten.load() >= target; } );
+  }
+
+  void writeLoop()
+  {
+    while( true )
+    {
+      {
+        std::unique_lock<std::mutex> lock( mutex );
+        cond.wait_for( lock, std::chrono::milliseconds( 50 ), [&] { return pending.load( std::memory_order_relaxed ) != nullptr; } );
+      }
+
+      // the list is in reverse order of pushing
+      DiagLogChunk* chunks = pending.exchange( nullptr, std::memory_order_acquire );
+      DiagLogChunk* ordered = nullptr;
+      uint64_t      num     = 0;
+      while( chunks )
+      {
+        DiagLogChunk* next = chunks->next;
+        chunks->next = ordered;
+        ordered      = chunks;
+        chunks       = next;
+      }
+      while( ordered )
+      {
+        DiagLogChunk* next = ordered->next;
+        fwrite( ordered->text.data(), 1, ordered->text.size(), stdout );
+        delete ordered;
+        ordered = next;
+        num++;
+      }
+
+      if( num > 0 )
+      {
+        fflush( stdout );
+        std::unique_lock<std::mutex> lock( mutex );
+        numWritten += num;
+        writtenCond.notify_all();
+      }
+    }
+  }
+
+  std::atomic<DiagLogChunk*> pending;
+  std::atomic<uint64_t>      numQueued;
+  std::atomic<uint64_t>      numWritten;
+  std::mutex                 mutex;
+  std::condition_variable    cond;
+  std::condition_variable    writtenCond;
+  std::thread                thread;
+};
+
+static DiagLogWriter& getDiagLogWriter()
+{
+  static DiagLogWriter* writer = new DiagLogWriter;
+  return *writer;
+}
+
+/// the buffer of a thread, the remaining messages are handed over when the thread exits
+struct DiagLogBuffer
+{
+  ~DiagLogBuffer()
+  {
+    if( !text.empty() )
+    {
+      getDiagLogWriter().push( text );
+    }
+  }
+
+  std::string text;
+};
+
+static thread_local DiagLogBuffer g_diagLogBuffer;
+
+void DiagLog::write( const char* fmt, ... )
+{
+  std::string& text = g_diagLogBuffer.text;
+  if( text.capacity() < DIAG_LOG_BUFFER_SIZE )
+  {
+    text.reserve( DIAG_LOG_BUFFER_SIZE );
+  }
+
+  va_list args;
+  va_start( args, fmt );
+  va_list argsCopy;
+  va_copy( argsCopy, args );
+
+  const size_t size = text.size();
+  const int    len  = vsnprintf( nullptr, 0, fmt, argsCopy );
+  va_end( argsCopy );
+  if( len > 0 )
+  {
+    text.resize( size + len + 1 );
+    vsnprintf( &text[size], len + 1, fmt, args );
+    text.resize( size + len );
+  }
+  va_end( args );
+
+  if( text.size() >= DIAG_LOG_BUFFER_SIZE )
+  {
+    getDiagLogWriter().push( text );
+  }
+}
+
+void DiagLog::flush()
+{
+  std::string& text = g_diagLogBuffer.text;
+  if( !text.empty() )
+  {
+    getDiagLogWriter().push( text );
+  }
+
+  getDiagLogWriter().waitWritten();
+}
@@ -0,0 +1,75 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     DiagLog.h
+ *  \brief    Buffered diagnostic output (header)
+ */
+
+#ifndef __DIAGLOG__
+#define __DIAGLOG__
+
+#include "CommonDef.h"
+
+// ---------------------------------------------------------------------------
+// DiagLog class
+// ---------------------------------------------------------------------------
+
+/**
+  Output of diagnostic messages from the coding loops. Every thread formats its messages into
+  its own buffer without locking; full buffers are handed to a background thread through a
+  lock-free list and written to stdout there, so the coding threads never wait for the console.
+  The messages of one thread keep their order, the messages of different threads are not
+  ordered. Messages are written when the verbosity reaches their level; levels above
+  DIAG_LOG_MAX_LEVEL are compiled out.
+ */
+class DiagLog
+{
+public:
+  static bool isEnabled  ( MsgLevel level ) { return level <= g_verbosity; }
+
+  static void write      ( const char* fmt, ... );
+  static void flush      ();                               ///< write the messages of all finished buffers and of the calling thread
+};
+
+#define DIAG_LOG( level, ... )                                                 \
+  do                                                                           \
+  {                                                                            \
+    if( ( level ) <= DIAG_LOG_MAX_LEVEL && DiagLog::isEnabled( level ) )       \
+    {                                                                          \
+      DiagLog::write( __VA_ARGS__ );                                           \
+    }                                                                          \
+  } while( 0 )
+
+#endif
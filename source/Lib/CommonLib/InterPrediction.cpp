@@ -39,6 +39,7 @@
 
 #include "Buffer.h"
 #include "UnitTools.h"
+#include "Profiler.h"
 
 #include <memory.h>
 #include <algorithm>
@@ -379,6 +380,8 @@ Void InterPrediction::xWeightedAverage( const PredictionUnit& pu, const CPelUnit
 
 Void InterPrediction::motionCompensation( PredictionUnit &pu, PelUnitBuf &predBuf, const RefPicList &eRefPicList )
 {
+  PROF_SCOPE( P_MOTION_COMPENSATION );
+
         CodingStructure &cs = *pu.cs;
   const PPS &pps            = *cs.pps;
   const SliceType sliceType =  cs.slice->getSliceType();
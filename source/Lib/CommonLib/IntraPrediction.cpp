@@ -43,6 +43,7 @@
 
 #include "dtrace_next.h"
 #include "Rom.h"
+#include "Profiler.h"
 
 #include <memory.h>
 
@@ -102,6 +103,18 @@ IntraPrediction::IntraPrediction()
   }
 
   m_piTemp = nullptr;
+
+  m_predIntraPlanar = xPredIntraPlanar;
+  m_predAngRows     = xPredAngRows;
+  m_sumRefRow       = xSumRefRow;
+  m_filterRefRow    = xFilterRefRow;
+  m_transposeBlock  = xTransposeBlock;
+
+#if ENABLE_SIMD_OPT_INTRA
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -168,10 +181,7 @@ Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
   const int width  = dstSize.width;
   const int height = dstSize.height;
 
-  for( iInd = 0; iInd < width; iInd++ )
-  {
-    iSum += pSrc.at( 1 + iInd, 0 );
-  }
+  iSum = m_sumRefRow( &pSrc.at( 1, 0 ), width );
   for( iInd = 0; iInd < height; iInd++ )
   {
     iSum += pSrc.at( 0, 1 + iInd );
@@ -183,6 +193,8 @@ Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
 
 void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu, const bool useFilteredPredSamples )
 {
+  PROF_SCOPE( P_INTRA_PREDICTION );
+
   const ComponentID    compID       = MAP_CHROMA( compId );
   const ChannelType    channelType  = toChannelType( compID );
   const Int            iWidth       = piPred.width;
@@ -205,7 +217,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
     switch( uiDirMode )
     {
     case( DC_IDX ):     xPredIntraDc    ( CPelBuf( ptrSrc, srcStride, srcStride ), piPred, channelType );            break; // including DCPredFiltering
-    case( PLANAR_IDX ): xPredIntraPlanar( CPelBuf( ptrSrc, srcStride, srcStride ), piPred, *pu.cs->sps );            break;
+    case( PLANAR_IDX ): m_predIntraPlanar( CPelBuf( ptrSrc, srcStride, srcStride ), piPred );                        break;
 #if HEVC_USE_HOR_VER_PREDFILTERING
     default:            xPredIntraAng   ( CPelBuf( ptrSrc, srcStride, srcStride ), piPred, channelType, uiDirMode,
                                           pu.cs->slice->clpRng( compID ), enableEdgeFilters, *pu.cs->sps );          break;
@@ -236,7 +248,7 @@ Void IntraPrediction::xFilterGroup(Pel* pMulDst[], Int i, Pel const * const piSr
  */
 
 //NOTE: Bit-Limit - 24-bit source
-Void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst, const SPS& sps )
+Void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
 {
   const UInt width  = pDst.width;
   const UInt height = pDst.height;
@@ -429,79 +441,87 @@ Void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
 
 
-  if( intraPredAngle == 0 )  // pure vertical or pure horizontal
+  m_predAngRows( pDstBuf, dstStride, refMain, width, height, intraPredAngle );
+
+#if HEVC_USE_HOR_VER_PREDFILTERING
+  if( edgeFilter && absAng <= 1 )
   {
+    const Int shift = intraPredAngle == 0 ? 1 : 2;
     for( Int y = 0; y < height; y++ )
     {
-      for( Int x = 0; x < width; x++ )
-      {
-        pDstBuf[y*dstStride + x] = refMain[x + 1];
-      }
-    }
-#if HEVC_USE_HOR_VER_PREDFILTERING
-    if (edgeFilter)
-    {
-      for( Int y = 0; y < height; y++ )
-      {
-        pDstBuf[y*dstStride] = ClipPel( pDstBuf[y*dstStride] + ( ( refSide[y + 1] - refSide[0] ) >> 1 ), clpRng );
-      }
+      pDstBuf[y*dstStride] = ClipPel( pDstBuf[y*dstStride] + ( ( refSide[y + 1] - refSide[0] ) >> shift ), clpRng );
     }
+  }
 #endif
+
+  // Flip the block if this is the horizontal mode
+  if( !bIsModeVer )
+  {
+    m_transposeBlock( pDstBuf, dstStride, pDst.buf, pDst.stride, width, height );
   }
-  else
+}
+
+/** Interpolation of the rows of a vertical angular prediction from the main reference.
+ * The displacement advances by intraPredAngle/32 samples per row, integer positions are copied.
+ */
+Void IntraPrediction::xPredAngRows( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle )
+{
+  for( Int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
   {
-    Pel *pDsty=pDstBuf;
+    const Int deltaInt   = deltaPos >> 5;
+    const Int deltaFract = deltaPos & ( 32 - 1 );
+    const Pel *pRM       = refMain + deltaInt + 1;
 
-    for (Int y=0, deltaPos=intraPredAngle; y<height; y++, deltaPos+=intraPredAngle, pDsty+=dstStride)
+    if( deltaFract )
     {
-      const Int deltaInt   = deltaPos >> 5;
-      const Int deltaFract = deltaPos & (32 - 1);
-
-      if( absAng < 32 )
-      {
-        {
-          // Do linear filtering
-          const Pel *pRM = refMain + deltaInt + 1;
-          Int lastRefMainPel = *pRM++;
-          for( Int x = 0; x < width; pRM++, x++ )
-          {
-            Int thisRefMainPel = *pRM;
-            pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
-            lastRefMainPel = thisRefMainPel;
-          }
-        }
-      }
-      else
+      // Do linear filtering
+      Int lastRefMainPel = *pRM++;
+      for( Int x = 0; x < width; pRM++, x++ )
       {
-        // Just copy the integer samples
-        for( Int x = 0; x < width; x++ )
-        {
-          pDsty[x] = refMain[x + deltaInt + 1];
-        }
+        Int thisRefMainPel = *pRM;
+        pDst[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
+        lastRefMainPel = thisRefMainPel;
       }
     }
-#if HEVC_USE_HOR_VER_PREDFILTERING
-    if( edgeFilter && absAng <= 1 )
+    else
     {
-      for( Int y = 0; y < height; y++ )
+      // Just copy the integer samples
+      for( Int x = 0; x < width; x++ )
       {
-        pDstBuf[y*dstStride] = ClipPel( pDstBuf[y*dstStride] + ((refSide[y + 1] - refSide[0]) >> 2), clpRng );
+        pDst[x] = pRM[x];
       }
     }
-#endif
   }
+}
 
-  // Flip the block if this is the horizontal mode
-  if( !bIsModeVer )
+Int IntraPrediction::xSumRefRow( const Pel* piRef, const Int numSamples )
+{
+  Int iSum = 0;
+  for( Int i = 0; i < numSamples; i++ )
   {
-    for( Int y = 0; y < height; y++ )
+    iSum += piRef[i];
+  }
+  return iSum;
+}
+
+/// [1 2 1] smoothing of numSamples contiguous reference samples, reads one sample beyond each end
+Void IntraPrediction::xFilterRefRow( const Pel* piSrc, Pel* piDst, const Int numSamples )
+{
+  for( Int i = 0; i < numSamples; i++ )
+  {
+    piDst[i] = ( piSrc[i + 1] + 2 * piSrc[i] + piSrc[i - 1] + 2 ) >> 2;
+  }
+}
+
+Void IntraPrediction::xTransposeBlock( const Pel* piSrc, const Int srcStride, Pel* piDst, const Int dstStride, const Int width, const Int height )
+{
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
     {
-      for( Int x = 0; x < width; x++ )
-      {
-        pDst.at( y, x ) = pDstBuf[x];
-      }
-      pDstBuf += dstStride;
+      piDst[x * dstStride + y] = piSrc[x];
     }
+    piSrc += srcStride;
   }
 }
 
@@ -836,12 +856,9 @@ void IntraPrediction::xFilterReferenceSamples( const Pel* refBufUnfiltered, Pel*
   piDestPtr++;
   piSrcPtr++;
   //top row (left-to-right)
-  for( UInt i=1; i < predSize; i++, piDestPtr++, piSrcPtr++ )
-  {
-    *piDestPtr = (piSrcPtr[1] + 2 * piSrcPtr[0] + piSrcPtr[-1] + 2) >> 2;
-  }
+  m_filterRefRow( piSrcPtr, piDestPtr, predSize - 1 );
   // top right (not filtered)
-  *piDestPtr=*piSrcPtr;
+  piDestPtr[predSize - 1] = piSrcPtr[predSize - 1];
 }
 
 bool IntraPrediction::useFilteredIntraRefSamples( const ComponentID &compID, const PredictionUnit &pu, bool modeSpecific, const UnitArea &tuArea )
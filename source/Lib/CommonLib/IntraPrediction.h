@@ -79,7 +79,6 @@ protected:
   ChromaFormat  m_currChromaFormat;
 
   // prediction
-  Void xPredIntraPlanar           ( const CPelBuf &pSrc, PelBuf &pDst,                                                                                                         const SPS& sps );
   Void xPredIntraDc               ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType,                                                                                          const bool enableBoundaryFilter = true );
 #if HEVC_USE_HOR_VER_PREDFILTERING
   Void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const UInt dirMode, const ClpRng& clpRng, const Bool bEnableEdgeFilters, const SPS& sps, const bool enableBoundaryFilter = true );
@@ -100,6 +99,37 @@ protected:
   Void destroy                    ();
 
   Void xFilterGroup               ( Pel* pMulDst[], Int i, Pel const* const piSrc, Int iRecStride, Bool bAboveAvaillable, Bool bLeftAvaillable);
+
+  // prediction kernels
+  static Void xPredIntraPlanar    ( const CPelBuf &pSrc, PelBuf &pDst );
+  static Void xPredAngRows        ( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle );
+  static Int  xSumRefRow          ( const Pel* piRef, const Int numSamples );
+  static Void xFilterRefRow       ( const Pel* piSrc, Pel* piDst, const Int numSamples );
+  static Void xTransposeBlock     ( const Pel* piSrc, const Int srcStride, Pel* piDst, const Int dstStride, const Int width, const Int height );
+
+  Void (*m_predIntraPlanar)       ( const CPelBuf &pSrc, PelBuf &pDst );
+  Void (*m_predAngRows)           ( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle );
+  Int  (*m_sumRefRow)             ( const Pel* piRef, const Int numSamples );
+  Void (*m_filterRefRow)          ( const Pel* piSrc, Pel* piDst, const Int numSamples );
+  Void (*m_transposeBlock)        ( const Pel* piSrc, const Int srcStride, Pel* piDst, const Int dstStride, const Int width, const Int height );
+
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext>
+  static Void xPredIntraPlanar_SIMD( const CPelBuf &pSrc, PelBuf &pDst );
+  template<X86_VEXT vext>
+  static Void xPredAngRows_SIMD    ( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle );
+  template<X86_VEXT vext>
+  static Int  xSumRefRow_SIMD      ( const Pel* piRef, const Int numSamples );
+  template<X86_VEXT vext>
+  static Void xFilterRefRow_SIMD   ( const Pel* piSrc, Pel* piDst, const Int numSamples );
+  template<X86_VEXT vext>
+  static Void xTransposeBlock_SIMD ( const Pel* piSrc, const Int srcStride, Pel* piDst, const Int dstStride, const Int width, const Int height );
+
+  Void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  Void _initIntraPredictionX86();
+#endif
+
 public:
   IntraPrediction();
   virtual ~IntraPrediction();
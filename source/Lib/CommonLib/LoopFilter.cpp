@@ -106,6 +106,14 @@ static bool isAvailable( const CodingUnit& cu, const CodingUnit& cu2, const bool
 
 LoopFilter::LoopFilter()
 {
+  m_filterLumaSegments = xFilterLumaSegments;
+  m_filterChromaLines  = xFilterChromaLines;
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
+#endif
 }
 
 LoopFilter::~LoopFilter()
@@ -506,6 +514,10 @@ Void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
 
   const int iBitdepthScale = 1 << (bitDepthLuma - 8);
 
+  // filter parameters of the parts along the edge, parts with equal parameters are filtered in one run
+  LFEdgeParam partParam[MAX_CU_SIZE >> MIN_CU_LOG2];
+  CHECK( uiNumParts > ( MAX_CU_SIZE >> MIN_CU_LOG2 ), "Too many parts along the edge" );
+
   // dec pos since within the loop we first calc the pos
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
@@ -515,6 +527,8 @@ Void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
     uiBsAbsIdx = getRasterIdx( pos, pcv );
     uiBs       = m_aapucBS[edgeDir][uiBsAbsIdx];
 
+    partParam[iIdx].filter = uiBs != 0;
+
     if( uiBs )
     {
       const CodingUnit& cuQ =  cu;
@@ -542,55 +556,47 @@ Void LoopFilter::xEdgeFilterLuma(const CodingUnit& cu, const DeblockEdgeDir edge
       const int iIndexTC  = Clip3(0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, Int(iQP + DEFAULT_INTRA_TC_OFFSET*(uiBs - 1) + (tcOffsetDiv2 << 1)));
       const int iIndexB   = Clip3(0, MAX_QP, iQP + (betaOffsetDiv2 << 1));
 
-      const int iTc       = sm_tcTable  [iIndexTC] * iBitdepthScale;
-      const int iBeta     = sm_betaTable[iIndexB ] * iBitdepthScale;
-      const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
-      const int iThrCut   = iTc * 10;
-
-      const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
-
-      for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+      bPartPNoFilter = bPartQNoFilter = false;
+      if( bPCMFilter )
       {
-        const int dp0 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dq0 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dp3 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int dq3 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int d0 = dp0 + dq0;
-        const int d3 = dp3 + dq3;
-
-        const int dp = dp0 + dp3;
-        const int dq = dq0 + dq3;
-        const int d  = d0  + d3;
-
-        bPartPNoFilter = bPartQNoFilter = false;
-        if( bPCMFilter )
-        {
-          // Check if each of PUs is I_PCM with LF disabling
-          bPartPNoFilter = cuP.ipcm;
-          bPartQNoFilter = cuQ.ipcm;
-        }
-        if( ppsTransquantBypassEnabledFlag )
-        {
-          // check if each of PUs is lossless coded
-          bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
-          bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
-        }
+        // Check if each of PUs is I_PCM with LF disabling
+        bPartPNoFilter = cuP.ipcm;
+        bPartQNoFilter = cuQ.ipcm;
+      }
+      if( ppsTransquantBypassEnabledFlag )
+      {
+        // check if each of PUs is lossless coded
+        bPartPNoFilter = bPartPNoFilter || cuP.transQuantBypass;
+        bPartQNoFilter = bPartQNoFilter || cuQ.transQuantBypass;
+      }
 
-        if( d < iBeta )
-        {
-          const bool bFilterP = (dp < iSideThreshold);
-          const bool bFilterQ = (dq < iSideThreshold);
+      partParam[iIdx].tc             = sm_tcTable  [iIndexTC] * iBitdepthScale;
+      partParam[iIdx].beta           = sm_betaTable[iIndexB ] * iBitdepthScale;
+      partParam[iIdx].bPartPNoFilter = bPartPNoFilter;
+      partParam[iIdx].bPartQNoFilter = bPartQNoFilter;
+    }
+  }
 
-          const bool sw = xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 0 ), iOffset, 2 * d0, iBeta, iTc )
-                       && xUseStrongFiltering( piTmpSrc + iSrcStep * ( iIdx*pelsInPart + iBlkIdx * 4 + 3 ), iOffset, 2 * d3, iBeta, iTc );
+  const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
 
-          for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
-          {
-            xPelFilterLuma( piTmpSrc + iSrcStep*( iIdx*pelsInPart + iBlkIdx * 4 + i ), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
-          }
-        }
-      }
+  for( int iIdx = 0; iIdx < uiNumParts; )
+  {
+    if( !partParam[iIdx].filter )
+    {
+      iIdx++;
+      continue;
+    }
+
+    int iEnd = iIdx + 1;
+    while( iEnd < uiNumParts && partParam[iEnd].filter && partParam[iEnd] == partParam[iIdx] )
+    {
+      iEnd++;
     }
+
+    const LFEdgeParam& prm = partParam[iIdx];
+    m_filterLumaSegments( piTmpSrc + iSrcStep * iIdx * pelsInPart, iSrcStep, iOffset, ( iEnd - iIdx ) * uiBlocksInPart, prm.tc, prm.beta, prm.bPartPNoFilter, prm.bPartQNoFilter, clpRng );
+
+    iIdx = iEnd;
   }
 }
 
@@ -672,6 +678,10 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
   const int iBitdepthScale = 1 << (sps.getBitDepth(CHANNEL_TYPE_CHROMA) - 8);
 
+  // filter parameters of the parts along the edge, parts with equal parameters are filtered in one run
+  LFEdgeParam partParam[2][MAX_CU_SIZE >> MIN_CU_LOG2];
+  CHECK( uiNumParts > ( MAX_CU_SIZE >> MIN_CU_LOG2 ), "Too many parts along the edge" );
+
   for( int iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     pos.x += xoffset;
@@ -680,6 +690,8 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
     uiBsAbsIdx = getRasterIdx( pos, pcv );
     ucBs       = m_aapucBS[edgeDir][uiBsAbsIdx];
 
+    partParam[0][iIdx].filter = partParam[1][iIdx].filter = ucBs > 1;
+
     if (ucBs > 1)
     {
       const CodingUnit& cuQ =  cu;
@@ -718,9 +730,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
 
       for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
       {
-        const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
         const int chromaQPOffset = pps.getQpOffset( ComponentID( chromaIdx + 1 ) );
-        Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
 
         int iQP = ( ( cuP.qp + cuQ.qp + 1 ) >> 1 ) + chromaQPOffset;
         if (iQP >= chromaQPMappingTableSize)
@@ -740,19 +750,109 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
         }
 
         const int iIndexTC = Clip3<int>( 0, MAX_QP + DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*( ucBs - 1 ) + ( tcOffsetDiv2 << 1 ) );
-        const int iTc      = sm_tcTable[iIndexTC] * iBitdepthScale;
 
-        for( unsigned uiStep = 0; uiStep < uiLoopLength; uiStep++ )
-        {
-          xPelFilterChroma( piTmpSrcChroma + iSrcStep*( uiStep + iIdx*uiLoopLength ), iOffset, iTc, bPartPNoFilter, bPartQNoFilter, clpRng );
-        }
+        partParam[chromaIdx][iIdx].tc             = sm_tcTable[iIndexTC] * iBitdepthScale;
+        partParam[chromaIdx][iIdx].beta           = 0;
+        partParam[chromaIdx][iIdx].bPartPNoFilter = bPartPNoFilter;
+        partParam[chromaIdx][iIdx].bPartQNoFilter = bPartQNoFilter;
+      }
+    }
+  }
+
+  for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+  {
+    const ClpRng& clpRng( cu.cs->slice->clpRng( ComponentID( chromaIdx + 1 )) );
+    Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
+
+    for( int iIdx = 0; iIdx < uiNumParts; )
+    {
+      if( !partParam[chromaIdx][iIdx].filter )
+      {
+        iIdx++;
+        continue;
       }
+
+      int iEnd = iIdx + 1;
+      while( iEnd < uiNumParts && partParam[chromaIdx][iEnd].filter && partParam[chromaIdx][iEnd] == partParam[chromaIdx][iIdx] )
+      {
+        iEnd++;
+      }
+
+      const LFEdgeParam& prm = partParam[chromaIdx][iIdx];
+      m_filterChromaLines( piTmpSrcChroma + iSrcStep * iIdx * uiLoopLength, iSrcStep, iOffset, ( iEnd - iIdx ) * uiLoopLength, prm.tc, prm.bPartPNoFilter, prm.bPartQNoFilter, clpRng );
+
+      iIdx = iEnd;
     }
   }
 }
 
 
 
+/**
+ - Deblocking of a run of 4-line luma segments sharing the same filter parameters
+ .
+ \param piSrc           pointer to the first line of the run at the edge
+ \param iSrcStep        step between two lines
+ \param iOffset         offset value for picture data across the edge
+ \param numSegments     number of 4-line segments
+ \param tc              tc value
+ \param beta            beta value
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+*/
+void LoopFilter::xFilterLumaSegments( Pel* piSrc, const int iSrcStep, const int iOffset, const int numSegments, const int tc, const int beta, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  const int iSideThreshold = ( beta + ( beta >> 1 ) ) >> 3;
+  const int iThrCut        = tc * 10;
+
+  for( int iBlkIdx = 0; iBlkIdx < numSegments; iBlkIdx++, piSrc += 4 * iSrcStep )
+  {
+    const int dp0 = xCalcDP( piSrc,                iOffset );
+    const int dq0 = xCalcDQ( piSrc,                iOffset );
+    const int dp3 = xCalcDP( piSrc + 3 * iSrcStep, iOffset );
+    const int dq3 = xCalcDQ( piSrc + 3 * iSrcStep, iOffset );
+    const int d0 = dp0 + dq0;
+    const int d3 = dp3 + dq3;
+
+    const int dp = dp0 + dp3;
+    const int dq = dq0 + dq3;
+    const int d  = d0  + d3;
+
+    if( d < beta )
+    {
+      const bool bFilterP = (dp < iSideThreshold);
+      const bool bFilterQ = (dq < iSideThreshold);
+
+      const bool sw = xUseStrongFiltering( piSrc,                iOffset, 2 * d0, beta, tc )
+                   && xUseStrongFiltering( piSrc + 3 * iSrcStep, iOffset, 2 * d3, beta, tc );
+
+      for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++ )
+      {
+        xPelFilterLuma( piSrc + iSrcStep * i, iOffset, tc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng );
+      }
+    }
+  }
+}
+
+/**
+ - Deblocking of a run of chroma lines sharing the same filter parameters
+ .
+ \param piSrc           pointer to the first line of the run at the edge
+ \param iSrcStep        step between two lines
+ \param iOffset         offset value for picture data across the edge
+ \param numLines        number of lines
+ \param tc              tc value
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+*/
+void LoopFilter::xFilterChromaLines( Pel* piSrc, const int iSrcStep, const int iOffset, const int numLines, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  for( int i = 0; i < numLines; i++ )
+  {
+    xPelFilterChroma( piSrc + iSrcStep * i, iOffset, tc, bPartPNoFilter, bPartQNoFilter, clpRng );
+  }
+}
+
 /**
  - Deblocking for the luminance component with strong or weak filter
  .
@@ -767,7 +867,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
  \param bFilterSecondQ  decision weak filter/no filter for partQ
  \param bitDepthLuma    luma bit depth
 */
-inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng )
 {
   int delta;
 
@@ -839,7 +939,7 @@ inline void LoopFilter::xPelFilterLuma( Pel* piSrc, const int iOffset, const int
  \param bPartQNoFilter  indicator to disable filtering on partQ
  \param bitDepthChroma  chroma bit depth
  */
-inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const
+inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
 {
   int delta;
 
@@ -871,7 +971,7 @@ inline void LoopFilter::xPelFilterChroma( Pel* piSrc, const int iOffset, const i
  \param tc              tc value
  \param piSrc           pointer to picture data
  */
-inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const
+inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc )
 {
   const Pel m4 = piSrc[ 0          ];
   const Pel m3 = piSrc[-iOffset    ];
@@ -883,12 +983,12 @@ inline bool LoopFilter::xUseStrongFiltering( Pel* piSrc, const int iOffset, cons
   return ( ( d_strong < ( beta >> 3 ) ) && ( d < ( beta >> 2 ) ) && ( abs( m3 - m4 ) < ( ( tc * 5 + 1 ) >> 1 ) ) );
 }
 
-inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDP( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[-iOffset * 3] - 2 * piSrc[-iOffset * 2] + piSrc[-iOffset] );
 }
 
-inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset ) const
+inline int LoopFilter::xCalcDQ( Pel* piSrc, const int iOffset )
 {
   return abs( piSrc[0] - 2 * piSrc[iOffset] + piSrc[iOffset * 2] );
 }
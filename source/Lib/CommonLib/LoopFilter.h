@@ -47,6 +47,21 @@
 
 #define DEBLOCK_SMALLEST_BLOCK  8
 
+/// filter parameters of one part along an edge
+struct LFEdgeParam
+{
+  bool filter;
+  int  tc;
+  int  beta;
+  bool bPartPNoFilter;
+  bool bPartQNoFilter;
+
+  bool operator==( const LFEdgeParam& other ) const
+  {
+    return tc == other.tc && beta == other.beta && bPartPNoFilter == other.bPartPNoFilter && bPartQNoFilter == other.bPartQNoFilter;
+  }
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -79,12 +94,26 @@ private:
   void xEdgeFilterLuma            ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
   void xEdgeFilterChroma          ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
 
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng ) const;
-  inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng ) const;
+  static void xFilterLumaSegments ( Pel* piSrc, const int iSrcStep, const int iOffset, const int numSegments, const int tc, const int beta, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+  static void xFilterChromaLines  ( Pel* piSrc, const int iSrcStep, const int iOffset, const int numLines,    const int tc,                 const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
 
-  inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc ) const;
-  inline int xCalcDP              ( Pel* piSrc, const int iOffset ) const;
-  inline int xCalcDQ              ( Pel* piSrc, const int iOffset ) const;
+  static inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng );
+  static inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc,                const bool bPartPNoFilter, const bool bPartQNoFilter,                                                                          const ClpRng& clpRng );
+
+  static inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc );
+  static inline int xCalcDP              ( Pel* piSrc, const int iOffset );
+  static inline int xCalcDQ              ( Pel* piSrc, const int iOffset );
+
+  /// edge kernels: runs of 4-line luma segments / chroma lines sharing the same filter parameters
+  void (*m_filterLumaSegments)    ( Pel* piSrc, const int iSrcStep, const int iOffset, const int numSegments, const int tc, const int beta, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+  void (*m_filterChromaLines)     ( Pel* piSrc, const int iSrcStep, const int iOffset, const int numLines,    const int tc,                 const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext>
+  static void xFilterLumaSegments_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const int numSegments, const int tc, const int beta, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+  template<X86_VEXT vext>
+  static void xFilterChromaLines_SIMD ( Pel* piSrc, const int iSrcStep, const int iOffset, const int numLines,    const int tc,                 const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng );
+#endif
 
   static const UChar sm_tcTable[54];
   static const UChar sm_betaTable[52];
@@ -106,6 +135,12 @@ public:
     const int indexB = Clip3( 0, MAX_QP, qp );
     return sm_betaTable[ indexB ];
   }
+
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
 };
 
 //! \}
@@ -35,9 +35,49 @@
 #include "SEI.h"
 #include "libmd5/MD5.h"
 
+#include <thread>
+
 //! \ingroup CommonLib
 //! \{
 
+/* luma samples from which the chroma planes are hashed on their own threads */
+static const UInt g_minThreadedHashArea = 1 << 16;
+
+/**
+ * Call hashPlane for every component of pic. For large pictures the chroma
+ * planes are processed concurrently with the luma plane, hashPlane must
+ * only write state of its own component.
+ */
+template<typename HashPlaneFunc>
+static Void hashPlanes(const CPelUnitBuf& pic, HashPlaneFunc hashPlane)
+{
+  const UInt numComp = (UInt)pic.bufs.size();
+
+  if (numComp > 1 && pic.get(COMPONENT_Y).area() >= g_minThreadedHashArea)
+  {
+    std::thread workers[MAX_NUM_COMPONENT - 1];
+    for (UInt chan = 1; chan < numComp; chan++)
+    {
+      workers[chan - 1] = std::thread(hashPlane, ComponentID(chan));
+    }
+    hashPlane(COMPONENT_Y);
+    for (UInt chan = 1; chan < numComp; chan++)
+    {
+      workers[chan - 1].join();
+    }
+  }
+  else
+  {
+    for (UInt chan = 0; chan < numComp; chan++)
+    {
+      hashPlane(ComponentID(chan));
+    }
+  }
+}
+
+/* number of samples packed for one md5 update */
+static const UInt g_md5BlockSamples = 256;
+
 /**
  * Update md5 using n samples from plane, each sample is adjusted to
  * OUTBIT_BITDEPTH_DIV8.
@@ -45,8 +85,8 @@
 template<UInt OUTPUT_BITDEPTH_DIV8>
 static Void md5_block(MD5& md5, const Pel* plane, UInt n)
 {
-  /* create a 64 byte buffer for packing Pel's into */
-  UChar buf[64/OUTPUT_BITDEPTH_DIV8][OUTPUT_BITDEPTH_DIV8];
+  /* create a buffer for packing Pel's into */
+  UChar buf[g_md5BlockSamples][OUTPUT_BITDEPTH_DIV8];
   for (UInt i = 0; i < n; i++)
   {
     Pel pel = plane[i];
@@ -68,7 +108,7 @@ static Void md5_plane(MD5& md5, const Pel* plane, UInt width, UInt height, UInt
 {
   /* N is the number of samples to process per md5 update.
    * All N samples must fit in buf */
-  UInt N = 32;
+  UInt N = g_md5BlockSamples;
   UInt width_modN = width % N;
   UInt width_less_modN = width - width_modN;
 
@@ -90,29 +130,32 @@ static Void md5_plane(MD5& md5, const Pel* plane, UInt width, UInt height, UInt
 UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, PictureHash &digest)
 {
   UInt crcMsb;
-  UInt bitVal;
   UInt crcVal = 0xffff;
   UInt bitIdx;
+
+  /* the bits of a data byte are shifted into the low byte of the CRC register while its high byte is shifted out,
+   * the polynomial reductions caused by the high byte are tabulated */
+  UShort reduction[256];
+  for (UInt highByte = 0; highByte < 256; highByte++)
+  {
+    UInt crc = highByte << 8;
+    for (bitIdx = 0; bitIdx < 8; bitIdx++)
+    {
+      crc = ((crc << 1) & 0xffff) ^ (((crc >> 15) & 1) * 0x1021);
+    }
+    reduction[highByte] = UShort(crc);
+  }
+
   for (UInt y = 0; y < height; y++)
   {
     for (UInt x = 0; x < width; x++)
     {
       // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
-      {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-      }
+      crcVal = reduction[crcVal >> 8] ^ ((crcVal << 8) & 0xffff) ^ (plane[y*stride+x] & 0xff);
       // take CRC of second pictureData byte if bit depth is greater than 8-bits
       if(bitdepth > 8)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        crcVal = reduction[crcVal >> 8] ^ ((crcVal << 8) & 0xffff) ^ ((plane[y*stride+x] >> 8) & 0xff);
       }
     }
   }
@@ -130,12 +173,19 @@ UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt strid
 UInt calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
   UInt digestLen=0;
+  PictureHash planeDigest[MAX_NUM_COMPONENT];
+
+  hashPlanes(pic, [&](const ComponentID compID)
+  {
+    const CPelBuf area = pic.get(compID);
+    compCRC(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, planeDigest[compID] );
+  });
+
   digest.hash.clear();
   for (UInt chan = 0; chan< (UInt)pic.bufs.size(); chan++)
   {
-    const ComponentID compID = ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    digestLen = compCRC(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, digest );
+    digest.hash.insert(digest.hash.end(), planeDigest[chan].hash.begin(), planeDigest[chan].hash.end());
+    digestLen = (UInt)planeDigest[chan].hash.size();
   }
   return digestLen;
 }
@@ -169,12 +219,19 @@ UInt compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt
 UInt calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
   UInt digestLen=0;
+  PictureHash planeDigest[MAX_NUM_COMPONENT];
+
+  hashPlanes(pic, [&](const ComponentID compID)
+  {
+    const CPelBuf area = pic.get(compID);
+    compChecksum(bitDepths.recon[toChannelType(compID)], area.bufAt(0,0), area.width, area.height, area.stride, planeDigest[compID], bitDepths);
+  });
+
   digest.hash.clear();
   for(UInt chan=0; chan< (UInt)pic.bufs.size(); chan++)
   {
-    const ComponentID compID=ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    digestLen=compChecksum(bitDepths.recon[toChannelType(compID)], area.bufAt(0,0), area.width, area.height, area.stride, digest, bitDepths);
+    digest.hash.insert(digest.hash.end(), planeDigest[chan].hash.begin(), planeDigest[chan].hash.end());
+    digestLen = (UInt)planeDigest[chan].hash.size();
   }
   return digestLen;
 }
@@ -189,23 +246,25 @@ UInt calcMD5(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDe
 {
   /* choose an md5_plane packing function based on the system bitdepth */
   typedef Void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
-  MD5PlaneFunc md5_plane_func;
 
   MD5 md5[MAX_NUM_COMPONENT];
+  UChar tmp_digest[MAX_NUM_COMPONENT][MD5_DIGEST_STRING_LENGTH];
+
+  hashPlanes(pic, [&](const ComponentID compID)
+  {
+    const CPelBuf area = pic.get(compID);
+    MD5PlaneFunc md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+    md5_plane_func(md5[compID], area.bufAt(0, 0), area.width, area.height, area.stride );
+    md5[compID].finalize(tmp_digest[compID]);
+  });
 
   digest.hash.clear();
 
   for (UInt chan = 0; chan< (UInt)pic.bufs.size(); chan++)
   {
-    const ComponentID compID=ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
-    UChar tmp_digest[MD5_DIGEST_STRING_LENGTH];
-    md5_plane_func(md5[compID], area.bufAt(0, 0), area.width, area.height, area.stride );
-    md5[compID].finalize(tmp_digest);
     for(UInt i=0; i<MD5_DIGEST_STRING_LENGTH; i++)
     {
-      digest.hash.push_back(tmp_digest[i]);
+      digest.hash.push_back(tmp_digest[chan][i]);
     }
   }
   return 16;
@@ -38,6 +38,7 @@
 #include "Picture.h"
 #include "SEI.h"
 #include "ChromaFormat.h"
+#include "DiagLog.h"
 #if ENABLE_WPP_PARALLELISM
 #if ENABLE_WPP_STATIC_LINK
 #include <atomic>
@@ -735,11 +736,11 @@ Void Picture::create(const ChromaFormat &_chromaFormat, const Size &size, const
   UnitArea::operator=( UnitArea( _chromaFormat, Area( Position{ 0, 0 }, size ) ) );
   margin            =  _margin;
   const Area a      = Area( Position(), size );
-  M_BUFS( 0, PIC_RECONSTRUCTION ).create( _chromaFormat, a, _maxCUSize, _margin, MEMORY_ALIGN_DEF_SIZE );
+  M_BUFS( 0, PIC_RECONSTRUCTION ).create( _chromaFormat, a, _maxCUSize, _margin, MEMORY_ALIGN_DEF_SIZE, true, true );
 
   if( !_decoder )
   {
-    M_BUFS( 0, PIC_ORIGINAL ).    create( _chromaFormat, a );
+    M_BUFS( 0, PIC_ORIGINAL ).    create( _chromaFormat, a, 0, 0, 0, true, true );
   }
 #if !KEEP_PRED_AND_RESI_SIGNALS
 
@@ -804,10 +805,10 @@ Void Picture::createTempBuffers( const unsigned _maxCUSize )
   for( int jId = 0; jId < scheduler.getNumPicInstances(); jId++ )
 #endif
   {
-    M_BUFS( jId, PIC_PREDICTION                   ).create( chromaFormat, a,   _maxCUSize );
-    M_BUFS( jId, PIC_RESIDUAL                     ).create( chromaFormat, a,   _maxCUSize );
+    M_BUFS( jId, PIC_PREDICTION                   ).create( chromaFormat, a,   _maxCUSize, 0, 0, true, true );
+    M_BUFS( jId, PIC_RESIDUAL                     ).create( chromaFormat, a,   _maxCUSize, 0, 0, true, true );
 #if ENABLE_SPLIT_PARALLELISM
-    if( jId > 0 ) M_BUFS( jId, PIC_RECONSTRUCTION ).create( chromaFormat, Y(), _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    if( jId > 0 ) M_BUFS( jId, PIC_RECONSTRUCTION ).create( chromaFormat, Y(), _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE, true, true );
 #endif
   }
 
@@ -3209,7 +3210,7 @@ Bool Picture::CompBlockRecoIsSimilar(UInt uiW, UInt uiH, Picture* pcPic, Picture
 			BgOrg += uiStride;
 		}
 	}
-	cout << "Zero" << Zero<<"SuM"<<Sum;
+	DIAG_LOG( DETAILS, "Zero%dSuM%d", Zero, Sum );
 	if (Zero>=900)
 		return true;
 	return false;
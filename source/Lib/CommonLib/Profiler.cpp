@@ -0,0 +1,256 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/** \file     Profiler.cpp
+ *  \brief    Hierarchical run-time profiler of the encoder
+ */
+
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+typedef std::chrono::steady_clock ProfilerClock;
+
+struct ProfilerScopeInfo
+{
+  const char* name;
+  int         level;
+};
+
+static const ProfilerScopeInfo g_profilerScopes[NUM_PROFILER_SCOPES] =
+{
+  { "GOP",                  PROF_LEVEL_GOP    },
+  { "Picture",              PROF_LEVEL_PIC    },
+  { "Slice",                PROF_LEVEL_STAGE  },
+  { "LoopFilter",           PROF_LEVEL_STAGE  },
+  { "SAO",                  PROF_LEVEL_STAGE  },
+  { "EntropyCoding",        PROF_LEVEL_STAGE  },
+  { "BgImportanceMap",      PROF_LEVEL_STAGE  },
+  { "BgCompDiffOrg",        PROF_LEVEL_STAGE  },
+  { "BgBlockGeneration",    PROF_LEVEL_STAGE  },
+  { "CTU",                  PROF_LEVEL_CTU    },
+  { "xCheckRDCostInter",    PROF_LEVEL_MODE   },
+  { "xCheckRDCostMerge",    PROF_LEVEL_MODE   },
+  { "xCheckRDCostIntra",    PROF_LEVEL_MODE   },
+  { "xCheckModeSplit",      PROF_LEVEL_MODE   },
+  { "MotionEstimation",     PROF_LEVEL_KERNEL },
+  { "MotionCompensation",   PROF_LEVEL_KERNEL },
+  { "IntraPrediction",      PROF_LEVEL_KERNEL },
+  { "Transform",            PROF_LEVEL_KERNEL },
+  { "InvTransform",         PROF_LEVEL_KERNEL },
+};
+
+struct ProfilerTraceEvent
+{
+  ProfilerScope scope;
+  int64_t       start;
+  int64_t       duration;
+};
+
+struct ProfilerThreadData
+{
+  struct Frame
+  {
+    ProfilerScope scope;
+    int64_t       start;
+    int64_t       childTicks;
+  };
+
+  ProfilerThreadData( int _threadId ) : threadId( _threadId )
+  {
+    for( int i = 0; i < NUM_PROFILER_SCOPES; i++ )
+    {
+      count[i] = inclusive[i] = self[i] = 0;
+      depth[i] = 0;
+    }
+  }
+
+  int                             threadId;
+  std::vector<Frame>              stack;
+  int64_t                         count    [NUM_PROFILER_SCOPES];
+  int64_t                         inclusive[NUM_PROFILER_SCOPES];     ///< time of the outermost calls of recursive scopes
+  int64_t                         self     [NUM_PROFILER_SCOPES];
+  int                             depth    [NUM_PROFILER_SCOPES];
+  std::vector<ProfilerTraceEvent> events;
+};
+
+// the records outlive their threads, they are evaluated after the worker threads have finished
+static std::mutex                                       g_profilerMutex;
+static std::vector<std::shared_ptr<ProfilerThreadData>> g_profilerThreads;
+static ProfilerClock::time_point                        g_profilerEpoch;
+static int                                              g_profilerTraceLevel = -1;
+
+bool Profiler::s_enabled = false;
+
+static inline int64_t getProfilerTicks()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>( ProfilerClock::now() - g_profilerEpoch ).count();
+}
+
+static ProfilerThreadData& getProfilerThreadData()
+{
+  thread_local std::shared_ptr<ProfilerThreadData> threadData;
+
+  if( !threadData )
+  {
+    std::lock_guard<std::mutex> lock( g_profilerMutex );
+    threadData = std::make_shared<ProfilerThreadData>( int( g_profilerThreads.size() ) );
+    threadData->stack.reserve( 64 );
+    g_profilerThreads.push_back( threadData );
+  }
+
+  return *threadData;
+}
+
+void Profiler::setTraceLevel( int traceLevel )
+{
+  g_profilerTraceLevel = traceLevel;
+}
+
+void Profiler::start()
+{
+  g_profilerEpoch = ProfilerClock::now();
+  s_enabled       = true;
+}
+
+void Profiler::stop()
+{
+  s_enabled = false;
+}
+
+void Profiler::enter( ProfilerScope scope )
+{
+  ProfilerThreadData& data = getProfilerThreadData();
+
+  data.depth[scope]++;
+  data.stack.push_back( { scope, getProfilerTicks(), 0 } );
+}
+
+void Profiler::leave( ProfilerScope scope )
+{
+  ProfilerThreadData& data = getProfilerThreadData();
+
+  CHECK( data.stack.empty() || data.stack.back().scope != scope, "profiler scopes not properly nested" );
+
+  const ProfilerThreadData::Frame frame    = data.stack.back();
+  const int64_t                   duration = getProfilerTicks() - frame.start;
+  data.stack.pop_back();
+
+  data.count[scope]++;
+  data.self [scope] += duration - frame.childTicks;
+  if( --data.depth[scope] == 0 )
+  {
+    data.inclusive[scope] += duration;
+  }
+  if( !data.stack.empty() )
+  {
+    data.stack.back().childTicks += duration;
+  }
+
+  if( g_profilerScopes[scope].level <= g_profilerTraceLevel )
+  {
+    data.events.push_back( { scope, frame.start, duration } );
+  }
+}
+
+void Profiler::printSummary()
+{
+  std::lock_guard<std::mutex> lock( g_profilerMutex );
+
+  int64_t count    [NUM_PROFILER_SCOPES] = { 0 };
+  int64_t inclusive[NUM_PROFILER_SCOPES] = { 0 };
+  int64_t self     [NUM_PROFILER_SCOPES] = { 0 };
+  int64_t totalSelf = 0;
+
+  for( auto& data : g_profilerThreads )
+  {
+    for( int i = 0; i < NUM_PROFILER_SCOPES; i++ )
+    {
+      count    [i] += data->count    [i];
+      inclusive[i] += data->inclusive[i];
+      self     [i] += data->self     [i];
+      totalSelf    += data->self     [i];
+    }
+  }
+
+  msg( INFO, "\n\nProfile (%d threads, times summed over all threads)\n", int( g_profilerThreads.size() ) );
+  msg( INFO, "  %-26s %12s %14s %14s %8s\n", "Scope", "Calls", "Total [ms]", "Self [ms]", "Self [%]" );
+
+  for( int i = 0; i < NUM_PROFILER_SCOPES; i++ )
+  {
+    if( count[i] == 0 )
+    {
+      continue;
+    }
+
+    const int indent = 2 * g_profilerScopes[i].level;
+    msg( INFO, "  %*s%-*s %12lld %14.1f %14.1f %8.2f\n", indent, "", 26 - indent, g_profilerScopes[i].name, (long long) count[i],
+         inclusive[i] * 1e-6, self[i] * 1e-6, totalSelf > 0 ? 100.0 * self[i] / totalSelf : 0.0 );
+  }
+}
+
+bool Profiler::writeTrace( const std::string& fileName )
+{
+  std::lock_guard<std::mutex> lock( g_profilerMutex );
+
+  FILE* file = fopen( fileName.c_str(), "w" );
+  if( !file )
+  {
+    return false;
+  }
+
+  fprintf( file, "{\"traceEvents\":[\n" );
+
+  bool first = true;
+  for( auto& data : g_profilerThreads )
+  {
+    for( auto& event : data->events )
+    {
+      const ProfilerScopeInfo& info = g_profilerScopes[event.scope];
+      fprintf( file, "%s{\"name\":\"%s\",\"cat\":\"L%d\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+               first ? "" : ",\n", info.name, info.level, event.start * 1e-3, event.duration * 1e-3, data->threadId );
+      first = false;
+    }
+  }
+
+  fprintf( file, "\n],\"displayTimeUnit\":\"ms\"}\n" );
+  fclose( file );
+  return true;
+}
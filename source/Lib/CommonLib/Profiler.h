@@ -0,0 +1,136 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     Profiler.h
+ *  \brief    Hierarchical run-time profiler of the encoder (header)
+ */
+
+#ifndef __PROFILER__
+#define __PROFILER__
+
+#include "CommonDef.h"
+
+#include <string>
+
+// ---------------------------------------------------------------------------
+// profiled scopes
+// ---------------------------------------------------------------------------
+
+enum ProfilerScope
+{
+  P_GOP_LEVEL = 0,
+  P_PIC_LEVEL,
+  P_SLICE_LEVEL,
+  P_LOOP_FILTER,
+  P_SAO,
+  P_ENTROPY_CODING,
+  P_BG_IMPORTANCE_MAP,
+  P_BG_DIFF,
+  P_BG_BLOCK_GEN,
+  P_CTU_LEVEL,
+  P_MODE_INTER,
+  P_MODE_MERGE,
+  P_MODE_INTRA,
+  P_MODE_SPLIT,
+  P_MOTION_ESTIMATION,
+  P_MOTION_COMPENSATION,
+  P_INTRA_PREDICTION,
+  P_TRANSFORM,
+  P_INV_TRANSFORM,
+  NUM_PROFILER_SCOPES
+};
+
+enum ProfilerLevel
+{
+  PROF_LEVEL_GOP    = 0,
+  PROF_LEVEL_PIC    = 1,
+  PROF_LEVEL_STAGE  = 2,                                   ///< slices and picture level stages
+  PROF_LEVEL_CTU    = 3,
+  PROF_LEVEL_MODE   = 4,
+  PROF_LEVEL_KERNEL = 5
+};
+
+// ---------------------------------------------------------------------------
+// Profiler class
+// ---------------------------------------------------------------------------
+
+/**
+  Scoped-timer profiler. Every thread accumulates the number of calls, the inclusive and the
+  self time of the scopes it enters into its own record, so the timers do not synchronise.
+  Scopes up to the trace level are additionally recorded as events for a Chrome trace
+  (chrome://tracing, Perfetto). When the profiler is disabled, a scope costs one test of a flag.
+ */
+class Profiler
+{
+public:
+  static void setTraceLevel( int traceLevel );             ///< deepest level recorded in the trace, -1: none
+  static void start        ();
+  static void stop         ();
+  static bool isEnabled    ()  { return s_enabled; }
+
+  static void enter        ( ProfilerScope scope );
+  static void leave        ( ProfilerScope scope );
+
+  static void printSummary ();
+  static bool writeTrace   ( const std::string& fileName );
+
+private:
+  static bool s_enabled;
+};
+
+class ProfilerScopeTimer
+{
+public:
+  ProfilerScopeTimer( ProfilerScope scope ) : m_scope( scope ), m_active( Profiler::isEnabled() ) { if( m_active ) Profiler::enter( m_scope ); }
+  ~ProfilerScopeTimer()                                                                           { if( m_active ) Profiler::leave( m_scope ); }
+
+private:
+  ProfilerScope m_scope;
+  bool          m_active;
+};
+
+#if ENABLE_PROFILING
+#define PROF_CONCAT_( a, b )  a##b
+#define PROF_CONCAT( a, b )   PROF_CONCAT_( a, b )
+#define PROF_SCOPE( scope )   ProfilerScopeTimer PROF_CONCAT( profScope, __LINE__ )( scope )
+#define PROF_START( scope )   const bool PROF_CONCAT( profActive, scope ) = Profiler::isEnabled(); if( PROF_CONCAT( profActive, scope ) ) Profiler::enter( scope )
+#define PROF_STOP( scope )    if( PROF_CONCAT( profActive, scope ) ) Profiler::leave( scope )
+#else
+#define PROF_SCOPE( scope )
+#define PROF_START( scope )
+#define PROF_STOP( scope )
+#endif
+
+#endif
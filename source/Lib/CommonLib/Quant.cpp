@@ -434,6 +434,7 @@ Void Quant::init( UInt uiMaxTrSize,
   m_uiMaxTrSize  = uiMaxTrSize;
   m_useRDOQ      = bUseRDOQ;
   m_useRDOQTS    = bUseRDOQTS;
+  m_fastRDOQ     = 0;
 #if T0196_SELECTIVE_RDOQ
   m_useSelectiveRDOQ     = useSelectiveRDOQ;
 #endif
@@ -109,6 +109,8 @@ public:
 #endif
   Void   setLambda               ( const Double dLambda )                      { m_dLambda = dLambda; }
   Double getLambda               () const                                      { return m_dLambda; }
+  Void   setUseRDOQ              ( const Bool useRDOQ )                        { m_useRDOQ = useRDOQ; }
+  Void   setFastRDOQ             ( const Int fastRDOQ )                        { m_fastRDOQ = fastRDOQ; }
 
 #if HEVC_USE_SCALING_LISTS
   Int* getQuantCoeff             ( UInt list, Int qp, UInt sizeX, UInt sizeY ) { return m_quantCoef            [sizeX][sizeY][list][qp]; };  //!< get Quant Coefficent
@@ -144,6 +146,7 @@ protected:
   UInt     m_uiMaxTrSize;
   Bool     m_useRDOQ;
   Bool     m_useRDOQTS;
+  Int      m_fastRDOQ;
 #if T0196_SELECTIVE_RDOQ
   Bool     m_useSelectiveRDOQ;
 #endif
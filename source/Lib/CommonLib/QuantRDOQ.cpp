@@ -67,6 +67,8 @@ struct coeffGroupRDStats
 // Constants
 // ====================================================================================================================
 
+static const UInt g_fastRDOQLastOnlyMaxArea = 64;   ///< largest block using the last position only decision of FastRDOQ 2
+
 
 // ====================================================================================================================
 // Static functions
@@ -656,6 +658,19 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   Int iScanPos;
   coeffGroupRDStats rdStats;
 
+  // fast RDOQ: coefficient groups inside the zero-out region of the transform are known to be zero, small blocks
+  // keep the dead-zone quantized levels and only optimize the last position
+  const Int    log2CGWidth    = cctx.log2CGSize() >> 1;
+  const Bool   hasZeroOut     = m_fastRDOQ && !tu.transformSkip[compID] && ( uiWidth > JVET_C0024_ZERO_OUT_TH || uiHeight > JVET_C0024_ZERO_OUT_TH );
+  const Bool   lastPosOnly    = m_fastRDOQ > 1 && uiMaxNumCoeff <= g_fastRDOQLastOnlyMaxArea;
+  const Intermediate_Int deadZoneOffset = Intermediate_Int( tu.cs->slice->isIntra() ? 171 : 85 ) << ( iQBits - 9 );
+
+  Intermediate_Int levelDouble[1 << MLS_CG_SIZE];
+  UInt             maxAbsLevel[1 << MLS_CG_SIZE];
+#if HEVC_USE_SCALING_LISTS
+  Double           errScale   [1 << MLS_CG_SIZE];
+#endif
+
 #if ENABLE_TRACING
   DTRACE( g_trace_ctx, D_RDOQ, "%d: %3d, %3d, %dx%d, comp=%d\n", DTRACE_GET_COUNTER( g_trace_ctx, D_RDOQ ), rect.x, rect.y, rect.width, rect.height, compID );
 #endif
@@ -668,12 +683,24 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
     memset( &rdStats, 0, sizeof (coeffGroupRDStats));
 
+    //===== quantization =====
+    const Bool zeroOutCG = hasZeroOut && ( ( cctx.cgPosX() << log2CGWidth ) >= JVET_C0024_ZERO_OUT_TH || ( cctx.cgPosY() << log2CGWidth ) >= JVET_C0024_ZERO_OUT_TH );
+    Bool       zeroCG    = true;
+
     for (Int iScanPosinCG = iCGSizeM1; iScanPosinCG >= 0; iScanPosinCG--)
     {
       iScanPos = cctx.minSubPos() + iScanPosinCG;
-      //===== quantization =====
       UInt    uiBlkPos          = cctx.blockPos(iScanPos);
 
+      if( zeroOutCG )
+      {
+        levelDouble [ iScanPosinCG ] = 0;
+        maxAbsLevel [ iScanPosinCG ] = 0;
+        pdCostCoeff0[ iScanPos ]     = 0;
+        piDstCoeff  [ uiBlkPos ]     = 0;
+        continue;
+      }
+
       // set coeff
 #if HEVC_USE_SCALING_LISTS
       const Int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [uiBlkPos]               : defaultQuantisationCoefficient;
@@ -682,6 +709,7 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 #else
       const Double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos] * blkErrScale : defaultErrorScale;
 #endif
+      errScale[ iScanPosinCG ]             = errorScale;
 #endif
       const Int64  tmpLevel                = Int64(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient;
 
@@ -694,6 +722,59 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
       d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
       piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
 
+      levelDouble[ iScanPosinCG ] = lLevelDouble;
+      maxAbsLevel[ iScanPosinCG ] = uiMaxAbsLevel;
+      zeroCG                     &= uiMaxAbsLevel == 0;
+    }
+
+    // fast RDOQ: a coefficient group without levels after the last position is signalled as not significant, the
+    // significance flags of its coefficients are never coded
+    if( m_fastRDOQ && zeroCG && ( iLastScanPos < 0 || cctx.subSetId() > 0 ) )
+    {
+      Double uncodedCost = 0;
+      for( Int iScanPosinCG = iCGSizeM1; iScanPosinCG >= 0; iScanPosinCG-- )
+      {
+        iScanPos                = cctx.minSubPos() + iScanPosinCG;
+        pdCostCoeff[ iScanPos ] = pdCostCoeff0[ iScanPos ];
+        uncodedCost            += pdCostCoeff0[ iScanPos ];
+      }
+      d64BaseCost += uncodedCost;
+
+      if( iLastScanPos >= 0 )
+      {
+        const BinFracBits fracBitsSigGroup = fracBits.getFracBitsArray( cctx.sigGroupCtxId() );
+        pdCostCoeffGroupSig[ cctx.subSetId() ] = xGetRateSigCoeffGroup( fracBitsSigGroup, 0 );
+        d64BaseCost += pdCostCoeffGroupSig[ cctx.subSetId() ];
+
+        // context set update of a group without levels
+        cctx.setGt2Flag( false );
+      }
+      continue;
+    }
+
+    // rates of the greater1 and greater2 flags of the context set of the group
+    BinFracBits fracBitsGt1[4];
+    BinFracBits fracBitsGt2;
+    if( !zeroCG || iLastScanPos >= 0 )
+    {
+      for( Int ctxGt1 = 0; ctxGt1 < 4; ctxGt1++ )
+      {
+        fracBitsGt1[ ctxGt1 ] = fracBits.getFracBitsArray( cctx.greater1CtxId( ctxGt1 ) );
+      }
+      fracBitsGt2 = fracBits.getFracBitsArray( cctx.greater2CtxId() );
+    }
+
+    for (Int iScanPosinCG = iCGSizeM1; iScanPosinCG >= 0; iScanPosinCG--)
+    {
+      iScanPos = cctx.minSubPos() + iScanPosinCG;
+      UInt    uiBlkPos          = cctx.blockPos(iScanPos);
+
+#if HEVC_USE_SCALING_LISTS
+      const Double errorScale                = errScale[ iScanPosinCG ];
+#endif
+      const Intermediate_Int lLevelDouble    = levelDouble[ iScanPosinCG ];
+      const UInt             uiMaxAbsLevel   = maxAbsLevel[ iScanPosinCG ];
+
       if ( uiMaxAbsLevel > 0 && iLastScanPos < 0 )
       {
         iLastScanPos            = iScanPos;
@@ -722,12 +803,37 @@ Void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
         UInt uiOneCtx = cctx.greater1CtxId( c1 );
         UInt uiAbsCtx = cctx.greater2CtxId();
 #endif
-        const BinFracBits fracBitsOne = fracBits.getFracBitsArray( cctx.greater1CtxId( c1 ) );
-        const BinFracBits fracBitsAbs = fracBits.getFracBitsArray( cctx.greater2CtxId()     );
+        const BinFracBits fracBitsOne = fracBitsGt1[ c1 ];
+        const BinFracBits fracBitsAbs = fracBitsGt2;
 
         DTRACE_COND( ( uiMaxAbsLevel != 0 ), g_trace_ctx, D_RDOQ_MORE, " One=%d Abs=%d", uiOneCtx, uiAbsCtx );
 
-        if( iScanPos == iLastScanPos )
+        if( lastPosOnly )
+        {
+          const Bool bLast = iScanPos == iLastScanPos;
+
+          // dead-zone quantized level, the last position has to stay significant
+          uiLevel = std::min<UInt>( uiMaxAbsLevel, UInt( ( lLevelDouble + deadZoneOffset ) >> iQBits ) );
+          uiLevel = bLast ? std::max<UInt>( uiLevel, 1 ) : uiLevel;
+
+          const BinFracBits fracBitsSig = bLast ? BinFracBits() : fracBits.getFracBitsArray( ctxIdSig );
+          const Double      costSig     = bLast ? 0 : xGetRateSigCoef( fracBitsSig, uiLevel ? 1 : 0 );
+
+          if( uiLevel )
+          {
+            const Double dErr = Double( lLevelDouble - ( Intermediate_Int( uiLevel ) << iQBits ) );
+            pdCostCoeff[ iScanPos ] = dErr * dErr * errorScale + xGetICost( xGetICRate( uiLevel, fracBitsOne, fracBitsAbs, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) ) + costSig;
+          }
+          else
+          {
+            pdCostCoeff[ iScanPos ] = pdCostCoeff0[ iScanPos ] + costSig;
+          }
+          pdCostSig[ iScanPos ] = costSig;
+#if HEVC_USE_SIGN_HIDING
+          sigRateDelta[ uiBlkPos ] = bLast ? 0 : fracBitsSig.intBits[1] - fracBitsSig.intBits[0];
+#endif
+        }
+        else if( iScanPos == iLastScanPos )
         {
           uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
                                                  lLevelDouble, uiMaxAbsLevel, nullptr, fracBitsOne, fracBitsAbs, 
@@ -44,6 +44,7 @@
 #include <iostream>
 using namespace std;
 #include <limits>
+#include <mutex>
 
 //! \ingroup CommonLib
 //! \{
@@ -123,8 +124,27 @@ Void RdCost::setLambdaRDO(Double dLambda, const BitDepths &bitDepths, Double M)
 }
 #endif
 
-// Initialize Function Pointer by [eDFunc]
+// the distortion functions and the luma level weights are static, they are set up once for all encoders of the process
+static std::once_flag s_staticTablesInit;
+
 Void RdCost::init()
+{
+  std::call_once( s_staticTablesInit, [this]()
+  {
+    xInitDistortFunctions();
+#if WCG_EXT
+    xInitLumaLevelToWeightTable();
+#endif
+  } );
+
+  m_costMode                   = COST_STANDARD_LOSSY;
+
+  m_motionLambda               = 0;
+  m_iCostScale                 = 0;
+}
+
+// Initialize Function Pointer by [eDFunc]
+Void RdCost::xInitDistortFunctions()
 {
   m_afpDistortFunc[DF_SSE    ] = RdCost::xGetSSE;
   m_afpDistortFunc[DF_SSE2   ] = RdCost::xGetSSE;
@@ -204,11 +224,6 @@ Void RdCost::init()
   initRdCostX86();
 #endif
 #endif
-
-  m_costMode                   = COST_STANDARD_LOSSY;
-
-  m_motionLambda               = 0;
-  m_iCostScale                 = 0;
 }
 
 
@@ -2898,7 +2913,7 @@ Void RdCost::saveUnadjustedLambda()
   m_DistScaleUnadjusted = m_DistScale;
 }
 
-Void RdCost::initLumaLevelToWeightTable()
+Void RdCost::xInitLumaLevelToWeightTable()
 {
   for (Int i = 0; i < LUMA_LEVEL_TO_DQP_LUT_MAXSIZE; i++) {
     Double x = i;
@@ -3307,10 +3322,11 @@ Distortion RdCost::xGetSSE64_WTD( const DistParam &rcDtParam )
 #endif
 
 
-Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
-
 #if _OPENMP
+Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
 #pragma omp threadprivate(orgCopy)
+#else
+thread_local Pel orgCopy[MAX_CU_SIZE * MAX_CU_SIZE];
 #endif
 
 Distortion RdCost::xGetMRHADs( const DistParam &rcDtParam )
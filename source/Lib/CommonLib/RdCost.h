@@ -192,12 +192,16 @@ public:
   UInt           getBitsOfVectorWithPredictor( const Int x, const Int y )  { return xGetExpGolombNumberOfBits(((x << m_iCostScale) - m_mvPredictor.getHor())) + xGetExpGolombNumberOfBits(((y << m_iCostScale) - m_mvPredictor.getVer())); }
 #if WCG_EXT
          Void    saveUnadjustedLambda       ();
-         Void    initLumaLevelToWeightTable ();
   inline Double  getWPSNRLumaLevelWeight    (Int val) { return m_lumaLevelToWeightPLUT[val]; }
 #endif
 
 private:
 
+         Void       xInitDistortFunctions       ();
+#if WCG_EXT
+  static Void       xInitLumaLevelToWeightTable ();
+#endif
+
   static Distortion xGetSSE           ( const DistParam& pcDtParam );
   static Distortion xGetSSE4          ( const DistParam& pcDtParam );
   static Distortion xGetSSE8          ( const DistParam& pcDtParam );
@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <iomanip>
+#include <mutex>
 
 // ====================================================================================================================
 // Initialize / destroy functions
@@ -181,9 +182,19 @@ public:
   }
 };
 
+// the ROM tables are shared by all encoder and decoder instances of a process
+static std::mutex s_romMutex;
+static Int        s_romRefCount = 0;
+
 // initialize ROM variables
 Void initROM()
 {
+  std::lock_guard<std::mutex> lock( s_romMutex );
+  if( s_romRefCount++ > 0 )
+  {
+    return;
+  }
+
   Int i, c;
 
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
@@ -401,6 +412,12 @@ Void initROM()
 
 Void destroyROM()
 {
+  std::lock_guard<std::mutex> lock( s_romMutex );
+  if( --s_romRefCount > 0 )
+  {
+    return;
+  }
+
   unsigned numWidths = gp_sizeIdxInfo->numAllWidths();
   unsigned numHeights = gp_sizeIdxInfo->numAllHeights();
 
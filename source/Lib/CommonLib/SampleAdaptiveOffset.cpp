@@ -112,15 +112,22 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
+  m_offsetLinesEO = xOffsetLinesEO;
+  m_offsetLinesBO = xOffsetLinesBO;
+  m_statsLinesEO  = xStatsLinesEO;
+  m_statsLinesBO  = xStatsLinesBO;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
 SampleAdaptiveOffset::~SampleAdaptiveOffset()
 {
   destroy();
-
-  m_signLineBuf1.clear();
-  m_signLineBuf2.clear();
 }
 
 Void SampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, UInt lumaBitShift, UInt chromaBitShift )
@@ -289,13 +296,72 @@ Void SampleAdaptiveOffset::xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkP
 }
 
 
+Void SampleAdaptiveOffset::xOffsetLinesEO( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines, Int posA, Int posB, const Int* offset, const ClpRng& clpRng )
+{
+  for( Int y = 0; y < numLines; y++ )
+  {
+    for( Int x = startX; x < endX; x++ )
+    {
+      const Int edgeType = sgn( srcLine[x] - srcLine[x + posA] ) + sgn( srcLine[x] - srcLine[x + posB] );
+
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+Void SampleAdaptiveOffset::xOffsetLinesBO( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines, Int shiftBits, const Int* offset, const ClpRng& clpRng )
+{
+  for( Int y = 0; y < numLines; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+Void SampleAdaptiveOffset::xStatsLinesEO( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int posA, Int posB, Int64* diff, Int64* count )
+{
+  for( Int y = 0; y < numLines; y++ )
+  {
+    for( Int x = startX; x < endX; x++ )
+    {
+      const Int edgeType = sgn( srcLine[x] - srcLine[x + posA] ) + sgn( srcLine[x] - srcLine[x + posB] );
+
+      diff [edgeType] += ( orgLine[x] - srcLine[x] );
+      count[edgeType] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+}
+
+Void SampleAdaptiveOffset::xStatsLinesBO( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int shiftBits, Int64* diff, Int64* count )
+{
+  for( Int y = 0; y < numLines; y++ )
+  {
+    for( Int x = startX; x < endX; x++ )
+    {
+      const Int bandIdx = srcLine[x] >> shiftBits;
+
+      diff [bandIdx] += ( orgLine[x] - srcLine[x] );
+      count[bandIdx] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+}
+
 Void SampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, const ClpRng& clpRng, Int typeIdx, Int* offset
                                           , const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
                                           , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
 {
-  Int x,y, startX, startY, endX, endY, edgeType;
+  Int startX, startY, endX, endY;
   Int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
-  SChar signLeft, signRight, signDown;
 
   const Pel* srcLine = srcBlk;
         Pel* resLine = resBlk;
@@ -307,197 +373,67 @@ Void SampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, const ClpRng&
       offset += 2;
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
-      for (y=0; y< height; y++)
-      {
-        signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-        for (x=startX; x< endX; x++)
-        {
-          signRight = (SChar)sgn(srcLine[x] - srcLine[x+1]);
-          edgeType =  signRight + signLeft;
-          signLeft  = -signRight;
-
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
-
+      m_offsetLinesEO( srcLine, srcStride, resLine, resStride, startX, endX, height, -1, 1, offset, clpRng );
     }
     break;
   case SAO_TYPE_EO_90:
     {
       offset += 2;
-      SChar *signUpLine = &m_signLineBuf1[0];
-
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
-      if (!isAboveAvail)
-      {
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
-      const Pel* srcLineAbove= srcLine- srcStride;
-      for (x=0; x< width; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-      }
-
-      const Pel* srcLineBelow;
-      for (y=startY; y<endY; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=0; x< width; x++)
-        {
-          signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-          edgeType = signDown + signUpLine[x];
-          signUpLine[x]= -signDown;
-
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
+      m_offsetLinesEO( srcLine + startY * srcStride, srcStride, resLine + startY * resStride, resStride, 0, width, endY - startY, -srcStride, srcStride, offset, clpRng );
     }
     break;
   case SAO_TYPE_EO_135:
     {
       offset += 2;
-      SChar *signUpLine, *signDownLine, *signTmpLine;
-
-      signUpLine  = &m_signLineBuf1[0];
-      signDownLine= &m_signLineBuf2[0];
+      const Int posA = -srcStride - 1;
+      const Int posB =  srcStride + 1;
 
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
 
-      //prepare 2nd line's upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX; x< endX+1; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x- 1]);
-      }
-
       //1st line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveLeftAvail ? 0 : 1;
       firstLineEndX   = isAboveAvail? endX: 1;
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType  =  sgn(srcLine[x] - srcLineAbove[x- 1]) - signUpLine[x+1];
-
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine  += srcStride;
-      resLine  += resStride;
-
+      m_offsetLinesEO( srcLine, srcStride, resLine, resStride, firstLineStartX, firstLineEndX, 1, posA, posB, offset, clpRng );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=startX; x<endX; x++)
-        {
-          signDown =  (SChar)sgn(srcLine[x] - srcLineBelow[x+ 1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-          signDownLine[x+1] = -signDown;
-        }
-        signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-        signTmpLine  = signUpLine;
-        signUpLine   = signDownLine;
-        signDownLine = signTmpLine;
-
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      m_offsetLinesEO( srcLine + srcStride, srcStride, resLine + resStride, resStride, startX, endX, height - 2, posA, posB, offset, clpRng );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowAvail ? startX : (width -1);
       lastLineEndX   = isBelowRightAvail ? width : (width -1);
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType =  sgn(srcLine[x] - srcLineBelow[x+ 1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      m_offsetLinesEO( srcLine + ( height - 1 ) * srcStride, srcStride, resLine + ( height - 1 ) * resStride, resStride, lastLineStartX, lastLineEndX, 1, posA, posB, offset, clpRng );
     }
     break;
   case SAO_TYPE_EO_45:
     {
       offset += 2;
-      SChar *signUpLine = &m_signLineBuf1[1];
+      const Int posA = -srcStride + 1;
+      const Int posB =  srcStride - 1;
 
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
 
-      //prepare 2nd line upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX-1; x< endX; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-      }
-
-
       //first line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveAvail ? startX : (width -1 );
       firstLineEndX   = isAboveRightAvail ? width : (width-1);
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) -signUpLine[x-1];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine += srcStride;
-      resLine += resStride;
+      m_offsetLinesEO( srcLine, srcStride, resLine, resStride, firstLineStartX, firstLineEndX, 1, posA, posB, offset, clpRng );
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for(x= startX; x< endX; x++)
-        {
-          signDown =  (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-          signUpLine[x-1] = -signDown;
-        }
-        signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
+      m_offsetLinesEO( srcLine + srcStride, srcStride, resLine + resStride, resStride, startX, endX, height - 2, posA, posB, offset, clpRng );
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowLeftAvail ? 0 : 1;
       lastLineEndX   = isBelowAvail ? endX : 1;
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-
-      }
+      m_offsetLinesEO( srcLine + ( height - 1 ) * srcStride, srcStride, resLine + ( height - 1 ) * resStride, resStride, lastLineStartX, lastLineEndX, 1, posA, posB, offset, clpRng );
     }
     break;
   case SAO_TYPE_BO:
     {
       const Int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      m_offsetLinesBO( srcLine, srcStride, resLine, resStride, width, height, shiftBits, offset, clpRng );
     }
     break;
   default:
@@ -528,13 +464,6 @@ Void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   //block boundary availability
   deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-  const size_t lineBufferSize = area.Y().width + 1;
-  if (m_signLineBuf1.size() < lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     const ComponentID compID = ComponentID(compIdx);
@@ -94,13 +94,39 @@ protected:
   Void xPCMSampleRestoration(CodingUnit& cu, const ComponentID compID);
   Void xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkParam* saoBlkParams);
 
+  // kernels over a rectangle of lines; posA/posB are the positions of the two EO neighbours relative to the current sample
+  static Void xOffsetLinesEO( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines, Int posA, Int posB, const Int* offset, const ClpRng& clpRng );
+  static Void xOffsetLinesBO( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines, Int shiftBits, const Int* offset, const ClpRng& clpRng );
+  static Void xStatsLinesEO ( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int posA, Int posB, Int64* diff, Int64* count );
+  static Void xStatsLinesBO ( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int shiftBits, Int64* diff, Int64* count );
+
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext>
+  static Void xOffsetLinesEO_SIMD( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines, Int posA, Int posB, const Int* offset, const ClpRng& clpRng );
+  template<X86_VEXT vext>
+  static Void xOffsetLinesBO_SIMD( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines, Int shiftBits, const Int* offset, const ClpRng& clpRng );
+  template<X86_VEXT vext>
+  static Void xStatsLinesEO_SIMD ( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int posA, Int posB, Int64* diff, Int64* count );
+  template<X86_VEXT vext>
+  static Void xStatsLinesBO_SIMD ( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int shiftBits, Int64* diff, Int64* count );
+#endif
+
 protected:
   UInt m_offsetStepLog2[MAX_NUM_COMPONENT]; //offset step
   PelStorage m_tempBuf;
   UInt m_numberOfComponents;
 
-  std::vector<SChar> m_signLineBuf1;
-  std::vector<SChar> m_signLineBuf2;
+  Void (*m_offsetLinesEO)( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines, Int posA, Int posB, const Int* offset, const ClpRng& clpRng );
+  Void (*m_offsetLinesBO)( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines, Int shiftBits, const Int* offset, const ClpRng& clpRng );
+  Void (*m_statsLinesEO) ( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int posA, Int posB, Int64* diff, Int64* count );
+  Void (*m_statsLinesBO) ( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int shiftBits, Int64* diff, Int64* count );
+
+#ifdef TARGET_SIMD_X86
+  Void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  Void _initSampleAdaptiveOffsetX86();
+#endif
+
 private:
   Bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
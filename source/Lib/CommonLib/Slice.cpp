@@ -40,6 +40,7 @@
 #include "Slice.h"
 #include "Picture.h"
 #include "dtrace_next.h"
+#include "DiagLog.h"
 #include "fstream"
 using namespace std;
 
@@ -795,7 +796,7 @@ Void Slice::setRefPicListaddbg(PicList& rcListPic,Picture* bgPicYuv, Picture* rc
 			m_apcRefPicList[REF_PIC_LIST_1][iRefIdx] = m_apcRefPicList[REF_PIC_LIST_0][iRefIdx];
 		}
 	}
-	cout << "setbg over" << endl;
+	DIAG_LOG( DETAILS, "setbg over\n" );
 }
 
 Void Slice::resetRefPicList(PicList& rcListPic, Picture* TempPicYuv,Int j)
@@ -1729,7 +1730,7 @@ Void Slice::setRefPicListaddBlockRecbg(PicList& rcListPic, Picture* bgPicYuv, Pi
 			m_apcRefPicList[REF_PIC_LIST_1][iRefIdx] = m_apcRefPicList[REF_PIC_LIST_0][iRefIdx];
 		}
 	}
-	cout << "setbg over" << endl;
+	DIAG_LOG( DETAILS, "setbg over\n" );
 }
 #endif
 #endif // ENCODE_BGPIC
@@ -45,6 +45,7 @@
 
 
 #include "dtrace_buffer.h"
+#include "Profiler.h"
 
 #include <stdlib.h>
 #include <limits>
@@ -71,11 +72,11 @@ struct coeffGroupRDStats
 // TrQuant class member functions
 // ====================================================================================================================
 #if HEVC_USE_4x4_DSTVII
-void xTrMxN ( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
-void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
+void xTrMxN ( FwdTrans* const* fwdTr, const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
+void xITrMxN( InvTrans* const* invTr, const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
 #else
-void xTrMxN ( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, const int maxLog2TrDynamicRange );
-void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, const int maxLog2TrDynamicRange );
+void xTrMxN ( FwdTrans* const* fwdTr, const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, const int maxLog2TrDynamicRange );
+void xITrMxN( InvTrans* const* invTr, const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, const int maxLog2TrDynamicRange );
 #endif
 
 
@@ -84,6 +85,29 @@ TrQuant::TrQuant() : m_quant( nullptr ), m_fTr( xTrMxN ), m_fITr( xITrMxN )
   // allocate temporary buffers
   m_plTempCoeff   = (TCoeff*) xMalloc( TCoeff, MAX_CU_SIZE * MAX_CU_SIZE );
 
+  m_fwdTrans[TRAFO_DCT2_B2  ] = fastForwardDCT2_B2;
+  m_fwdTrans[TRAFO_DCT2_B4  ] = fastForwardDCT2_B4;
+  m_fwdTrans[TRAFO_DCT2_B8  ] = fastForwardDCT2_B8;
+  m_fwdTrans[TRAFO_DCT2_B16 ] = fastForwardDCT2_B16;
+  m_fwdTrans[TRAFO_DCT2_B32 ] = fastForwardDCT2_B32;
+  m_fwdTrans[TRAFO_DCT2_B64 ] = fastForwardDCT2_B64;
+  m_fwdTrans[TRAFO_DCT2_B128] = fastForwardDCT2_B128;
+  m_fwdTrans[TRAFO_DST7_B4  ] = fastForwardDST7_B4;
+
+  m_invTrans[TRAFO_DCT2_B2  ] = fastInverseDCT2_B2;
+  m_invTrans[TRAFO_DCT2_B4  ] = fastInverseDCT2_B4;
+  m_invTrans[TRAFO_DCT2_B8  ] = fastInverseDCT2_B8;
+  m_invTrans[TRAFO_DCT2_B16 ] = fastInverseDCT2_B16;
+  m_invTrans[TRAFO_DCT2_B32 ] = fastInverseDCT2_B32;
+  m_invTrans[TRAFO_DCT2_B64 ] = fastInverseDCT2_B64;
+  m_invTrans[TRAFO_DCT2_B128] = fastInverseDCT2_B128;
+  m_invTrans[TRAFO_DST7_B4  ] = fastInverseDST7_B4;
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+  initTrQuantX86();
+#endif
+#endif
 }
 
 TrQuant::~TrQuant()
@@ -112,6 +136,7 @@ void TrQuant::copyState( const TrQuant& other )
 
 
 /** MxN forward transform (2D)
+*  \param fwdTr                 [in]  1D transform kernels
 *  \param bitDepth              [in]  bit depth
 *  \param residual              [in]  residual block
 *  \param stride                [in]  stride of residual block
@@ -123,9 +148,9 @@ void TrQuant::copyState( const TrQuant& other )
 
 */
 #if HEVC_USE_4x4_DSTVII
-void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange )
+void xTrMxN( FwdTrans* const* fwdTr, const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange )
 #else
-void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, const int maxLog2TrDynamicRange )
+void xTrMxN( FwdTrans* const* fwdTr, const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, const int maxLog2TrDynamicRange )
 #endif
 {
   const int iWidth  = (int)width;
@@ -157,27 +182,27 @@ void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coe
   {
     switch (iWidth)
     {
-    case 2:     fastForwardDCT2_B2( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
+    case 2:     fwdTr[TRAFO_DCT2_B2  ]( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
     case 4:
       {
 #if HEVC_USE_4x4_DSTVII
         if ((iHeight == 4) && useDST)    // Check for DCT or DST
         {
-          fastForwardDST7_B4( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );
+          fwdTr[TRAFO_DST7_B4  ]( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );
         }
         else
 #endif
         {
-          fastForwardDCT2_B4( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );
+          fwdTr[TRAFO_DCT2_B4  ]( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );
         }
       }
       break;
 
-    case 8:     fastForwardDCT2_B8  ( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 16:    fastForwardDCT2_B16 ( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 32:    fastForwardDCT2_B32 ( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
-    case 64:    fastForwardDCT2_B64 ( block, tmp, shift_1st + COM16_C806_TRANS_PREC, iHeight, 0, iSkipWidth, 0 );  break;
-    case 128:   fastForwardDCT2_B128( block, tmp, shift_1st + COM16_C806_TRANS_PREC, iHeight, 0, iSkipWidth, 0 );  break;
+    case 8:     fwdTr[TRAFO_DCT2_B8  ]( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
+    case 16:    fwdTr[TRAFO_DCT2_B16 ]( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
+    case 32:    fwdTr[TRAFO_DCT2_B32 ]( block, tmp, shift_1st, iHeight, 0, iSkipWidth, 0 );  break;
+    case 64:    fwdTr[TRAFO_DCT2_B64 ]( block, tmp, shift_1st + COM16_C806_TRANS_PREC, iHeight, 0, iSkipWidth, 0 );  break;
+    case 128:   fwdTr[TRAFO_DCT2_B128]( block, tmp, shift_1st + COM16_C806_TRANS_PREC, iHeight, 0, iSkipWidth, 0 );  break;
     default:
       THROW( "Unsupported transformation size" ); break;
     }
@@ -186,27 +211,27 @@ void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coe
   {
     switch (iHeight)
     {
-    case 2:     fastForwardDCT2_B2( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
+    case 2:     fwdTr[TRAFO_DCT2_B2  ]( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
     case 4:
       {
 #if HEVC_USE_4x4_DSTVII
         if ((iWidth == 4) && useDST)    // Check for DCT or DST
         {
-          fastForwardDST7_B4( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );
+          fwdTr[TRAFO_DST7_B4  ]( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );
         }
         else
 #endif
         {
-          fastForwardDCT2_B4( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );
+          fwdTr[TRAFO_DCT2_B4  ]( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );
         }
       }
       break;
 
-    case 8:     fastForwardDCT2_B8  ( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 16:    fastForwardDCT2_B16 ( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 32:    fastForwardDCT2_B32 ( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 64:    fastForwardDCT2_B64 ( tmp, coeff, shift_2nd + COM16_C806_TRANS_PREC, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
-    case 128:   fastForwardDCT2_B128( tmp, coeff, shift_2nd + COM16_C806_TRANS_PREC, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
+    case 8:     fwdTr[TRAFO_DCT2_B8  ]( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
+    case 16:    fwdTr[TRAFO_DCT2_B16 ]( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
+    case 32:    fwdTr[TRAFO_DCT2_B32 ]( tmp, coeff, shift_2nd, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
+    case 64:    fwdTr[TRAFO_DCT2_B64 ]( tmp, coeff, shift_2nd + COM16_C806_TRANS_PREC, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
+    case 128:   fwdTr[TRAFO_DCT2_B128]( tmp, coeff, shift_2nd + COM16_C806_TRANS_PREC, iWidth, iSkipWidth, iSkipHeight, 0 );  break;
     default:
       THROW( "Unsupported transformation size" ); break;
     }
@@ -215,6 +240,7 @@ void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coe
 
 
 /** MxN inverse transform (2D)
+*  \param invTr                 [in]  1D transform kernels
 *  \param bitDepth              [in]  bit depth
 *  \param coeff                 [in]  transform coefficients
 *  \param residual              [out] residual block
@@ -225,9 +251,9 @@ void xTrMxN( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coe
 *  \param maxLog2TrDynamicRange [in]
 */
 #if HEVC_USE_4x4_DSTVII
-void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange )
+void xITrMxN( InvTrans* const* invTr, const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange )
 #else
-void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, const int maxLog2TrDynamicRange )
+void xITrMxN( InvTrans* const* invTr, const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, const int maxLog2TrDynamicRange )
 #endif
 {
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_INVERSE];
@@ -252,27 +278,27 @@ void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t str
   {
     switch (iHeight)
     {
-    case 2: fastInverseDCT2_B2( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
+    case 2: invTr[TRAFO_DCT2_B2  ]( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
     case 4:
       {
 #if HEVC_USE_4x4_DSTVII
         if ((iWidth == 4) && useDST)    // Check for DCT or DST
         {
-          fastInverseDST7_B4( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
+          invTr[TRAFO_DST7_B4  ]( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
         }
         else
 #endif
         {
-          fastInverseDCT2_B4( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
+          invTr[TRAFO_DCT2_B4  ]( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum );
         }
       }
       break;
 
-    case   8: fastInverseDCT2_B8  ( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case  16: fastInverseDCT2_B16 ( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case  32: fastInverseDCT2_B32 ( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case  64: fastInverseDCT2_B64 ( coeff, tmp, shift_1st + COM16_C806_TRANS_PREC, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
-    case 128: fastInverseDCT2_B128( coeff, tmp, shift_1st + COM16_C806_TRANS_PREC, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
+    case   8: invTr[TRAFO_DCT2_B8  ]( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
+    case  16: invTr[TRAFO_DCT2_B16 ]( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
+    case  32: invTr[TRAFO_DCT2_B32 ]( coeff, tmp, shift_1st, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
+    case  64: invTr[TRAFO_DCT2_B64 ]( coeff, tmp, shift_1st + COM16_C806_TRANS_PREC, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
+    case 128: invTr[TRAFO_DCT2_B128]( coeff, tmp, shift_1st + COM16_C806_TRANS_PREC, iWidth, uiSkipWidth, uiSkipHeight, 0, clipMinimum, clipMaximum ); break;
     default:
       THROW( "Unsupported transformation size" ); break;
     }
@@ -281,28 +307,28 @@ void xITrMxN( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t str
   {
     switch (iWidth)
     {
-    case 2: fastInverseDCT2_B2( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case 2: invTr[TRAFO_DCT2_B2  ]( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
     // Clipping here is not in the standard, but is used to protect the "Pel" data type into which the inverse-transformed samples will be copied
     case 4:
       {
 #if HEVC_USE_4x4_DSTVII
         if ((iHeight == 4) && useDST)    // Check for DCT or DST
         {
-          fastInverseDST7_B4( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
+          invTr[TRAFO_DST7_B4  ]( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
         }
         else
 #endif
         {
-          fastInverseDCT2_B4( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
+          invTr[TRAFO_DCT2_B4  ]( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
         }
       }
       break;
 
-    case   8: fastInverseDCT2_B8  ( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case  16: fastInverseDCT2_B16 ( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case  32: fastInverseDCT2_B32 ( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case  64: fastInverseDCT2_B64 ( tmp, block, shift_2nd + COM16_C806_TRANS_PREC, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
-    case 128: fastInverseDCT2_B128( tmp, block, shift_2nd + COM16_C806_TRANS_PREC, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case   8: invTr[TRAFO_DCT2_B8  ]( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case  16: invTr[TRAFO_DCT2_B16 ]( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case  32: invTr[TRAFO_DCT2_B32 ]( tmp, block, shift_2nd, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case  64: invTr[TRAFO_DCT2_B64 ]( tmp, block, shift_2nd + COM16_C806_TRANS_PREC, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case 128: invTr[TRAFO_DCT2_B128]( tmp, block, shift_2nd + COM16_C806_TRANS_PREC, iHeight, 0, uiSkipWidth, 0, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
     default:
       THROW( "Unsupported transformation size" );
       break;
@@ -366,6 +392,8 @@ Void TrQuant::init( const Quant* otherQuant,
 
 Void TrQuant::invTransformNxN( TransformUnit &tu, const ComponentID &compID, PelBuf &pResi, const QpParam &cQP )
 {
+  PROF_SCOPE( P_INV_TRANSFORM );
+
   const CompArea &area    = tu.blocks[compID];
   const UInt uiWidth      = area.width;
   const UInt uiHeight     = area.height;
@@ -482,9 +510,9 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
 #endif
   {
 #if HEVC_USE_4x4_DSTVII
-    m_fTr     ( channelBitDepth, resi.buf, resi.stride, dstCoeff.buf, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+    m_fTr     ( m_fwdTrans, channelBitDepth, resi.buf, resi.stride, dstCoeff.buf, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
 #else
-    m_fTr     ( channelBitDepth, resi.buf, resi.stride, dstCoeff.buf, iWidth, iHeight, maxLog2TrDynamicRange );
+    m_fTr     ( m_fwdTrans, channelBitDepth, resi.buf, resi.stride, dstCoeff.buf, iWidth, iHeight, maxLog2TrDynamicRange );
 #endif
   }
 }
@@ -501,9 +529,9 @@ void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCo
 
   {
 #if HEVC_USE_4x4_DSTVII
-    m_fITr     ( channelBitDepth, pCoeff.buf, pResidual.buf, pResidual.stride, pCoeff.width, pCoeff.height,                          useDST, maxLog2TrDynamicRange );
+    m_fITr     ( m_invTrans, channelBitDepth, pCoeff.buf, pResidual.buf, pResidual.stride, pCoeff.width, pCoeff.height,                          useDST, maxLog2TrDynamicRange );
 #else
-    m_fITr     ( channelBitDepth, pCoeff.buf, pResidual.buf, pResidual.stride, pCoeff.width, pCoeff.height,                          maxLog2TrDynamicRange );
+    m_fITr     ( m_invTrans, channelBitDepth, pCoeff.buf, pResidual.buf, pResidual.stride, pCoeff.width, pCoeff.height,                          maxLog2TrDynamicRange );
 #endif
   }
 }
@@ -572,6 +600,8 @@ Void TrQuant::xQuant(TransformUnit &tu, const ComponentID &compID, const CCoeffB
 
 Void TrQuant::transformNxN(TransformUnit &tu, const ComponentID &compID, const QpParam &cQP, TCoeff &uiAbsSum, const Ctx &ctx)
 {
+  PROF_SCOPE( P_TRANSFORM );
+
         CodingStructure &cs = *tu.cs;
   const SPS &sps            = *cs.sps;
   const CompArea &rect      = tu.blocks[compID];
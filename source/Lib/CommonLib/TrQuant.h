@@ -53,6 +53,20 @@
 typedef void FwdTrans(const TCoeff*, TCoeff*, Int, Int, Int, Int, Int);
 typedef void InvTrans(const TCoeff*, TCoeff*, Int, Int, Int, Int, Int, const TCoeff, const TCoeff);
 
+/// 1D transform kernels, the DCT-II entries are indexed by log2( size ) - 1
+enum TrafoKernel
+{
+  TRAFO_DCT2_B2 = 0,
+  TRAFO_DCT2_B4,
+  TRAFO_DCT2_B8,
+  TRAFO_DCT2_B16,
+  TRAFO_DCT2_B32,
+  TRAFO_DCT2_B64,
+  TRAFO_DCT2_B128,
+  TRAFO_DST7_B4,
+  NUM_TRAFO_KERNELS
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -127,13 +141,17 @@ private:
   void xT        ( const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int iWidth, const int iHeight );
 
 #if HEVC_USE_4x4_DSTVII
-  void (*m_fTr ) ( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
-  void (*m_fITr) ( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
+  void (*m_fTr ) ( FwdTrans* const* fwdTr, const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
+  void (*m_fITr) ( InvTrans* const* invTr, const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, bool useDST, const int maxLog2TrDynamicRange );
 #else
-  void (*m_fTr ) ( const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, const int maxLog2TrDynamicRange );
-  void (*m_fITr) ( const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, const int maxLog2TrDynamicRange );
+  void (*m_fTr ) ( FwdTrans* const* fwdTr, const int bitDepth, const Pel *residual, size_t stride, TCoeff *coeff, size_t width, size_t height, const int maxLog2TrDynamicRange );
+  void (*m_fITr) ( InvTrans* const* invTr, const int bitDepth, const TCoeff *coeff, Pel *residual, size_t stride, size_t width, size_t height, const int maxLog2TrDynamicRange );
 #endif
 
+  // 1D transform kernels used by m_fTr / m_fITr
+  FwdTrans *m_fwdTrans[NUM_TRAFO_KERNELS];
+  InvTrans *m_invTrans[NUM_TRAFO_KERNELS];
+
 
   // skipping Transform
   Void xTransformSkip   (const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, TCoeff* psCoeff);
@@ -91,6 +91,16 @@
 
 #endif // ! ENABLE_TRACING
 
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING                                  1 // scoped-timer profiler, activated at run time by the encoder options Profiling and ProfilingTraceFile
+
+#endif // ! ENABLE_PROFILING
+
+#ifndef DIAG_LOG_MAX_LEVEL
+#define DIAG_LOG_MAX_LEVEL                                6 // DIAG_LOG messages above this message level are compiled out, 0 removes all of them
+
+#endif // ! DIAG_LOG_MAX_LEVEL
+
 #define WCG_EXT                                           0 // part of JEM sharp Luma qp
 #define WCG_WPSNR                                         WCG_EXT 
 
@@ -195,6 +205,10 @@
 #define ENABLE_SIMD_OPT_MCIF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the interpolation filter, no impact on RD performance
 #define ENABLE_SIMD_OPT_BUFFER                          ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the buffer operations, no impact on RD performance
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the DCT-II/DST-VII transform kernels, no impact on RD performance
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter edge kernels, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the SAO application and statistics kernels, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRA                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the intra prediction kernels, no impact on RD performance
 // End of SIMD optimizations
 
 #define AMP_ENC_SPEEDUP                                   0 ///< encoder only speed-up by AMP mode skipping
@@ -1289,10 +1303,11 @@ public:
 // dynamic cache
 // ---------------------------------------------------------------------------
 
-template<typename T>
+template<typename T, size_t CHUNK_SIZE = 64>
 class dynamic_cache
 {
   std::vector<T*> m_cache;
+  std::vector<T*> m_chunks;     ///< contiguous slabs owning all elements ever handed out
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   int64_t         m_cacheId;
 #endif
@@ -1312,15 +1327,17 @@ public:
     deleteEntries();
   }
 
+  // releases the whole arena, all elements handed out by get() become invalid
   void deleteEntries()
   {
-    for( auto &p : m_cache )
+    for( auto &p : m_chunks )
     {
-      delete p;
+      delete[] p;
       p = nullptr;
     }
 
-    m_cache.clear();
+    m_chunks.clear();
+    m_cache .clear();
   }
 
   T* get()
@@ -1338,7 +1355,21 @@ public:
     }
     else
     {
-      ret = new T;
+      // allocate a new slab and hand its elements out in address order
+      T* chunk = new T[CHUNK_SIZE];
+      m_chunks.push_back( chunk );
+
+      m_cache.reserve( m_cache.size() + CHUNK_SIZE );
+      for( size_t i = CHUNK_SIZE - 1; i > 0; i-- )
+      {
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+        chunk[i].cacheId   = m_cacheId;
+        chunk[i].cacheUsed = true;
+#endif
+        m_cache.push_back( &chunk[i] );
+      }
+
+      ret = &chunk[0];
     }
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
@@ -1373,7 +1404,8 @@ public:
     }
 
 #endif
-    m_cache.insert( m_cache.end(), vel.begin(), vel.end() );
+    // bulk return in reverse, so the next get() calls reuse the same elements in the same order
+    m_cache.insert( m_cache.end(), vel.rbegin(), vel.rend() );
     vel.clear();
   }
 };
@@ -1424,7 +1456,6 @@ struct XUCache
 #define PRINT_UPDATEBG_RESI 0
 #define PRINT_UPDATE_TRCOEFF 0
 #define PRINT_FCVALUE 0
-#define PRINT_OrgDIFF 0
 #define PRINT_DIFF 0
 #define PRINT_PUREF 0 //puĲο֡
 #define ENCODE_BGPIC 1
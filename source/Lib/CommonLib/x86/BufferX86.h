@@ -362,6 +362,64 @@ Void linTf_SSE_entry( const Pel* src, Int srcStride, Pel *dst, Int dstStride, In
   }
 }
 
+template< X86_VEXT vext >
+void sobel_SSE( const Pel* src, int srcStride, Pel* gradX, Pel* gradY, int width )
+{
+  // width is a multiple of 8, the samples left, right, above and below the row have to be accessible
+  for( int x = 0; x < width; x += 8 )
+  {
+    const Pel* p = src + x;
+
+    __m128i tl = _mm_loadu_si128( ( const __m128i* )( p - srcStride - 1 ) );
+    __m128i tc = _mm_loadu_si128( ( const __m128i* )( p - srcStride     ) );
+    __m128i tr = _mm_loadu_si128( ( const __m128i* )( p - srcStride + 1 ) );
+    __m128i ml = _mm_loadu_si128( ( const __m128i* )( p             - 1 ) );
+    __m128i mr = _mm_loadu_si128( ( const __m128i* )( p             + 1 ) );
+    __m128i bl = _mm_loadu_si128( ( const __m128i* )( p + srcStride - 1 ) );
+    __m128i bc = _mm_loadu_si128( ( const __m128i* )( p + srcStride     ) );
+    __m128i br = _mm_loadu_si128( ( const __m128i* )( p + srcStride + 1 ) );
+
+    __m128i gx = _mm_sub_epi16( _mm_add_epi16( _mm_add_epi16( tr, br ), _mm_slli_epi16( mr, 1 ) ),
+                                _mm_add_epi16( _mm_add_epi16( tl, bl ), _mm_slli_epi16( ml, 1 ) ) );
+    __m128i gy = _mm_sub_epi16( _mm_add_epi16( _mm_add_epi16( bl, br ), _mm_slli_epi16( bc, 1 ) ),
+                                _mm_add_epi16( _mm_add_epi16( tl, tr ), _mm_slli_epi16( tc, 1 ) ) );
+
+    _mm_storeu_si128( ( __m128i* )( gradX + x ), gx );
+    _mm_storeu_si128( ( __m128i* )( gradY + x ), gy );
+  }
+}
+
+template< X86_VEXT vext >
+uint64_t ssd_SSE( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height )
+{
+  // width is a multiple of 8; the differences of two samples in [0, 2^15) fit 16 bit and a pair of their squares
+  // fits an unsigned 32 bit lane, which is widened to 64 bit before the accumulation
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i vsum = vzero;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      __m128i vsrc0 = _mm_loadu_si128( ( const __m128i* )( src0 + x ) );
+      __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )( src1 + x ) );
+      __m128i vdiff = _mm_sub_epi16( vsrc0, vsrc1 );
+      __m128i vsq   = _mm_madd_epi16( vdiff, vdiff );
+
+      vsum = _mm_add_epi64( vsum, _mm_unpacklo_epi32( vsq, vzero ) );
+      vsum = _mm_add_epi64( vsum, _mm_unpackhi_epi32( vsq, vzero ) );
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+  vsum = _mm_add_epi64( vsum, _mm_unpackhi_epi64( vsum, vsum ) );
+
+  uint64_t sum;
+  _mm_storel_epi64( ( __m128i* ) &sum, vsum );
+  return sum;
+}
+
 template<X86_VEXT vext>
 Void PelBufferOps::_initPelBufOpsX86()
 {
@@ -373,6 +431,10 @@ Void PelBufferOps::_initPelBufOpsX86()
 
   linTf8 = linTf_SSE_entry<vext, 8>;
   linTf4 = linTf_SSE_entry<vext, 4>;
+
+  sobel8 = sobel_SSE<vext>;
+
+  ssd8 = ssd_SSE<vext>;
 }
 
 template Void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
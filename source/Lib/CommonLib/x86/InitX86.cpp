@@ -43,6 +43,9 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/RdCost.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/LoopFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+#include "CommonLib/IntraPrediction.h"
 
 #ifdef TARGET_SIMD_X86
 
@@ -110,5 +113,85 @@ Void RdCost::initRdCostX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_DBLF
+Void LoopFilter::initLoopFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initLoopFilterX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initLoopFilterX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+Void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initSampleAdaptiveOffsetX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initSampleAdaptiveOffsetX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRA
+Void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initIntraPredictionX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initIntraPredictionX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_TRAFO
+Void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initTrQuantX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initTrQuantX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
 #endif
 
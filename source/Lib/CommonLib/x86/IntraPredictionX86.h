@@ -0,0 +1,305 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    intra prediction kernels, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_INTRA
+#ifdef TARGET_SIMD_X86
+
+template<X86_VEXT vext>
+Void IntraPrediction::xPredAngRows_SIMD( Pel* pDst, const Int dstStride, const Pel* refMain, const Int width, const Int height, const Int intraPredAngle )
+{
+  if( width < 4 )
+  {
+    xPredAngRows( pDst, dstStride, refMain, width, height, intraPredAngle );
+    return;
+  }
+
+  const __m128i voffset = _mm_set1_epi32( 16 );
+
+  for( Int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const Int deltaInt   = deltaPos >> 5;
+    const Int deltaFract = deltaPos & ( 32 - 1 );
+    const Pel *pRM       = refMain + deltaInt + 1;
+
+    if( !deltaFract )
+    {
+      if( width == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* ) pDst, _mm_loadl_epi64( ( const __m128i* ) pRM ) );
+      }
+      else
+      {
+        for( Int x = 0; x < width; x += 8 )
+        {
+          _mm_storeu_si128( ( __m128i* ) ( pDst + x ), _mm_loadu_si128( ( const __m128i* ) ( pRM + x ) ) );
+        }
+      }
+      continue;
+    }
+
+    // both weights in one 32 bit lane, applied to interleaved ( left, right ) reference pairs
+    const Int weights = ( deltaFract << 16 ) | ( 32 - deltaFract );
+
+#if USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      const __m256i vw   = _mm256_set1_epi32( weights );
+      const __m256i voff = _mm256_set1_epi32( 16 );
+
+      for( Int x = 0; x < width; x += 16 )
+      {
+        const __m256i a  = _mm256_loadu_si256( ( const __m256i* ) ( pRM + x ) );
+        const __m256i b  = _mm256_loadu_si256( ( const __m256i* ) ( pRM + x + 1 ) );
+        const __m256i lo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( a, b ), vw ), voff ), 5 );
+        const __m256i hi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( a, b ), vw ), voff ), 5 );
+        _mm256_storeu_si256( ( __m256i* ) ( pDst + x ), _mm256_packs_epi32( lo, hi ) );
+      }
+      continue;
+    }
+#endif
+
+    const __m128i vw = _mm_set1_epi32( weights );
+
+    if( width == 4 )
+    {
+      const __m128i a  = _mm_loadl_epi64( ( const __m128i* ) pRM );
+      const __m128i b  = _mm_loadl_epi64( ( const __m128i* ) ( pRM + 1 ) );
+      const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), vw ), voffset ), 5 );
+      _mm_storel_epi64( ( __m128i* ) pDst, _mm_packs_epi32( lo, lo ) );
+    }
+    else
+    {
+      for( Int x = 0; x < width; x += 8 )
+      {
+        const __m128i a  = _mm_loadu_si128( ( const __m128i* ) ( pRM + x ) );
+        const __m128i b  = _mm_loadu_si128( ( const __m128i* ) ( pRM + x + 1 ) );
+        const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), vw ), voffset ), 5 );
+        const __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), vw ), voffset ), 5 );
+        _mm_storeu_si128( ( __m128i* ) ( pDst + x ), _mm_packs_epi32( lo, hi ) );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+Void IntraPrediction::xPredIntraPlanar_SIMD( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const UInt width  = pDst.width;
+  const UInt height = pDst.height;
+
+  if( width < 4 )
+  {
+    xPredIntraPlanar( pSrc, pDst );
+    return;
+  }
+
+  const UInt log2W      = g_aucLog2[ width ];
+  const UInt log2H      = g_aucLog2[ height ];
+  const UInt finalShift = 1 + log2W + log2H;
+
+  // the running sums of the scalar version are written out: vertical part per column, horizontal part per lane index
+  Int topRow[MAX_CU_SIZE], bottomRow[MAX_CU_SIZE];
+
+  const Pel* topRef     = &pSrc.at( 1, 0 );
+  const Int  topRight   = topRef[width];
+  const Int  bottomLeft = pSrc.at( 0, height + 1 );
+
+  for( Int k = 0; k < width; k++ )
+  {
+    bottomRow[k] = bottomLeft - topRef[k];
+    topRow[k]    = topRef[k] << log2H;
+  }
+
+  const __m128i vshiftW = _mm_cvtsi32_si128( log2W );
+  const __m128i vshiftH = _mm_cvtsi32_si128( log2H );
+  const __m128i vshiftF = _mm_cvtsi32_si128( finalShift );
+  const __m128i voffset = _mm_set1_epi32( width * height );
+  const __m128i vlanes  = _mm_setr_epi32( 1, 2, 3, 4 );
+
+  const UInt stride = pDst.stride;
+  Pel*       pred   = pDst.buf;
+
+  for( Int y = 0; y < height; y++, pred += stride )
+  {
+    const Int left = pSrc.at( 0, y + 1 );
+    const __m128i vleft  = _mm_set1_epi32( left << log2W );
+    const __m128i vright = _mm_set1_epi32( topRight - left );
+
+#if USE_AVX2
+    if( vext >= AVX2 && width >= 8 )
+    {
+      const __m256i vleft8   = _mm256_set1_epi32( left << log2W );
+      const __m256i vright8  = _mm256_set1_epi32( topRight - left );
+      const __m256i vlanes8  = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 );
+      const __m256i voffset8 = _mm256_set1_epi32( width * height );
+
+      for( Int x = 0; x < width; x += 8 )
+      {
+        const __m256i vert = _mm256_add_epi32( _mm256_loadu_si256( ( const __m256i* ) ( topRow + x ) ), _mm256_loadu_si256( ( const __m256i* ) ( bottomRow + x ) ) );
+        _mm256_storeu_si256( ( __m256i* ) ( topRow + x ), vert );
+
+        const __m256i hor = _mm256_add_epi32( vleft8, _mm256_mullo_epi32( vright8, _mm256_add_epi32( vlanes8, _mm256_set1_epi32( x ) ) ) );
+        __m256i sum = _mm256_add_epi32( _mm256_sll_epi32( hor, vshiftH ), _mm256_sll_epi32( vert, vshiftW ) );
+        sum = _mm256_sra_epi32( _mm256_add_epi32( sum, voffset8 ), vshiftF );
+        sum = _mm256_permute4x64_epi64( _mm256_packs_epi32( sum, sum ), 0x08 );
+        _mm_storeu_si128( ( __m128i* ) ( pred + x ), _mm256_castsi256_si128( sum ) );
+      }
+      continue;
+    }
+#endif
+
+    for( Int x = 0; x < width; x += 4 )
+    {
+      const __m128i vert = _mm_add_epi32( _mm_loadu_si128( ( const __m128i* ) ( topRow + x ) ), _mm_loadu_si128( ( const __m128i* ) ( bottomRow + x ) ) );
+      _mm_storeu_si128( ( __m128i* ) ( topRow + x ), vert );
+
+      const __m128i hor = _mm_add_epi32( vleft, _mm_mullo_epi32( vright, _mm_add_epi32( vlanes, _mm_set1_epi32( x ) ) ) );
+      __m128i sum = _mm_add_epi32( _mm_sll_epi32( hor, vshiftH ), _mm_sll_epi32( vert, vshiftW ) );
+      sum = _mm_sra_epi32( _mm_add_epi32( sum, voffset ), vshiftF );
+      _mm_storel_epi64( ( __m128i* ) ( pred + x ), _mm_packs_epi32( sum, sum ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+Int IntraPrediction::xSumRefRow_SIMD( const Pel* piRef, const Int numSamples )
+{
+  const __m128i vone = _mm_set1_epi16( 1 );
+  __m128i vsum = _mm_setzero_si128();
+  Int i = 0;
+
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vone16 = _mm256_set1_epi16( 1 );
+    __m256i vsum16 = _mm256_setzero_si256();
+    for( ; i + 16 <= numSamples; i += 16 )
+    {
+      vsum16 = _mm256_add_epi32( vsum16, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) ( piRef + i ) ), vone16 ) );
+    }
+    vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum16 ), _mm256_extracti128_si256( vsum16, 1 ) );
+  }
+#endif
+  for( ; i + 8 <= numSamples; i += 8 )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( piRef + i ) ), vone ) );
+  }
+  if( i + 4 <= numSamples )
+  {
+    vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_loadl_epi64( ( const __m128i* ) ( piRef + i ) ), vone ) );
+    i += 4;
+  }
+
+  vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0x4e ) );
+  vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0xb1 ) );
+
+  Int iSum = _mm_cvtsi128_si32( vsum );
+  for( ; i < numSamples; i++ )
+  {
+    iSum += piRef[i];
+  }
+  return iSum;
+}
+
+template<X86_VEXT vext>
+Void IntraPrediction::xFilterRefRow_SIMD( const Pel* piSrc, Pel* piDst, const Int numSamples )
+{
+  if( numSamples < 8 )
+  {
+    xFilterRefRow( piSrc, piDst, numSamples );
+    return;
+  }
+
+  // ( a + 2b + c + 2 ) >> 2 == ( ( ( a + c ) >> 1 ) + b + 1 ) >> 1, which stays within unsigned 16 bit
+  for( Int i = 0; i < numSamples; i += 8 )
+  {
+    const Int     k  = std::min( i, numSamples - 8 );
+    const __m128i a  = _mm_loadu_si128( ( const __m128i* ) ( piSrc + k - 1 ) );
+    const __m128i b  = _mm_loadu_si128( ( const __m128i* ) ( piSrc + k ) );
+    const __m128i c  = _mm_loadu_si128( ( const __m128i* ) ( piSrc + k + 1 ) );
+    _mm_storeu_si128( ( __m128i* ) ( piDst + k ), _mm_avg_epu16( _mm_srli_epi16( _mm_add_epi16( a, c ), 1 ), b ) );
+  }
+}
+
+template<X86_VEXT vext>
+Void IntraPrediction::xTransposeBlock_SIMD( const Pel* piSrc, const Int srcStride, Pel* piDst, const Int dstStride, const Int width, const Int height )
+{
+  if( ( width & 7 ) || ( height & 7 ) )
+  {
+    xTransposeBlock( piSrc, srcStride, piDst, dstStride, width, height );
+    return;
+  }
+
+  for( Int y = 0; y < height; y += 8 )
+  {
+    for( Int x = 0; x < width; x += 8 )
+    {
+      __m128i m[8];
+      for( Int i = 0; i < 8; i++ )
+      {
+        m[i] = _mm_loadu_si128( ( const __m128i* ) ( piSrc + ( y + i ) * srcStride + x ) );
+      }
+      TRANSPOSE8x8( m );
+      for( Int i = 0; i < 8; i++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) ( piDst + ( x + i ) * dstStride + y ), m[i] );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+Void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predIntraPlanar = xPredIntraPlanar_SIMD<vext>;
+  m_predAngRows     = xPredAngRows_SIMD<vext>;
+  m_sumRefRow       = xSumRefRow_SIMD<vext>;
+  m_filterRefRow    = xFilterRefRow_SIMD<vext>;
+  m_transposeBlock  = xTransposeBlock_SIMD<vext>;
+}
+
+template Void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
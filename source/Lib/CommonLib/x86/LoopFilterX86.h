@@ -0,0 +1,304 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    deblocking filter edge kernels, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+
+// Both kernels work on 16 bit lanes, one lane per line across the edge. Lines of a vertical edge are
+// rows in memory and get transposed, lines of a horizontal edge are contiguous and loaded directly.
+
+/// broadcast the sum of the first and the last line of each 4-line segment to all lanes of the segment
+static inline __m128i segmentSum( const __m128i v )
+{
+  const __m128i v0 = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0x00 ), 0x00 );
+  const __m128i v3 = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0xff ), 0xff );
+  return _mm_add_epi16( v0, v3 );
+}
+
+/// broadcast the conjunction of the first and the last line of each 4-line segment to all lanes of the segment
+static inline __m128i segmentAnd( const __m128i v )
+{
+  const __m128i v0 = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0x00 ), 0x00 );
+  const __m128i v3 = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0xff ), 0xff );
+  return _mm_and_si128( v0, v3 );
+}
+
+static inline __m128i clip3( const __m128i vmin, const __m128i vmax, const __m128i v )
+{
+  return _mm_min_epi16( vmax, _mm_max_epi16( vmin, v ) );
+}
+
+template<X86_VEXT vext>
+Void LoopFilter::xFilterLumaSegments_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const int numSegments, const int tc, const int beta, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  if( clpRng.bd > 10 )
+  {
+    // the weak filter decision does not fit into 16 bit for higher bit depths
+    xFilterLumaSegments( piSrc, iSrcStep, iOffset, numSegments, tc, beta, bPartPNoFilter, bPartQNoFilter, clpRng );
+    return;
+  }
+
+  const __m128i vzero    = _mm_setzero_si128();
+  const __m128i vtc      = _mm_set1_epi16( tc );
+  const __m128i vtcNeg   = _mm_set1_epi16( -tc );
+  const __m128i vtc2     = _mm_set1_epi16( tc >> 1 );
+  const __m128i vtc2Neg  = _mm_set1_epi16( -( tc >> 1 ) );
+  const __m128i vtcx2    = _mm_set1_epi16( 2 * tc );
+  const __m128i vtcStrong= _mm_set1_epi16( ( tc * 5 + 1 ) >> 1 );
+  const __m128i vthrCut  = _mm_set1_epi16( tc * 10 );
+  const __m128i vbeta    = _mm_set1_epi16( beta );
+  const __m128i vbeta2   = _mm_set1_epi16( beta >> 2 );
+  const __m128i vbeta3   = _mm_set1_epi16( beta >> 3 );
+  const __m128i vside    = _mm_set1_epi16( ( beta + ( beta >> 1 ) ) >> 3 );
+  const __m128i vmin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax     = _mm_set1_epi16( clpRng.max );
+  const __m128i vtwo     = _mm_set1_epi16( 2 );
+  const __m128i vfour    = _mm_set1_epi16( 4 );
+  const __m128i veight   = _mm_set1_epi16( 8 );
+  const __m128i vkeepP   = _mm_set1_epi16( bPartPNoFilter ? -1 : 0 );
+  const __m128i vkeepQ   = _mm_set1_epi16( bPartQNoFilter ? -1 : 0 );
+  const bool    isVer    = iOffset == 1;
+
+  // two 4-line segments per iteration
+  for( int seg = 0; seg < numSegments; seg += 2, piSrc += 8 * iSrcStep )
+  {
+    const int numLines = numSegments - seg > 1 ? 8 : 4;
+    __m128i m[8];
+
+    if( isVer )
+    {
+      for( int l = 0; l < 8; l++ )
+      {
+        m[l] = l < numLines ? _mm_loadu_si128( ( const __m128i* ) ( piSrc + l * iSrcStep - 4 ) ) : vzero;
+      }
+      TRANSPOSE8x8( m );
+    }
+    else
+    {
+      for( int k = 0; k < 8; k++ )
+      {
+        const Pel* p = piSrc + ( k - 4 ) * iOffset;
+        m[k] = numLines == 8 ? _mm_loadu_si128( ( const __m128i* ) p ) : _mm_loadl_epi64( ( const __m128i* ) p );
+      }
+    }
+
+    // decisions
+    const __m128i dpl  = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( m[1], _mm_slli_epi16( m[2], 1 ) ), m[3] ) );
+    const __m128i dql  = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( m[4], _mm_slli_epi16( m[5], 1 ) ), m[6] ) );
+    const __m128i dp   = segmentSum( dpl );
+    const __m128i dq   = segmentSum( dql );
+    const __m128i filt = _mm_cmplt_epi16( _mm_add_epi16( dp, dq ), vbeta );
+
+    if( ( _mm_movemask_epi8( filt ) & ( numLines == 8 ? 0xffff : 0x00ff ) ) == 0 )
+    {
+      continue;
+    }
+
+    const __m128i filtP = _mm_cmplt_epi16( dp, vside );
+    const __m128i filtQ = _mm_cmplt_epi16( dq, vside );
+
+    const __m128i dStrong = _mm_add_epi16( _mm_abs_epi16( _mm_sub_epi16( m[0], m[3] ) ), _mm_abs_epi16( _mm_sub_epi16( m[7], m[4] ) ) );
+    __m128i strong = _mm_cmplt_epi16( dStrong, vbeta3 );
+    strong = _mm_and_si128( strong, _mm_cmplt_epi16( _mm_slli_epi16( _mm_add_epi16( dpl, dql ), 1 ), vbeta2 ) );
+    strong = _mm_and_si128( strong, _mm_cmplt_epi16( _mm_abs_epi16( _mm_sub_epi16( m[3], m[4] ) ), vtcStrong ) );
+    const __m128i sw = segmentAnd( strong );
+
+    // strong filter
+    const __m128i s234 = _mm_add_epi16( _mm_add_epi16( m[2], m[3] ), m[4] );
+    const __m128i s345 = _mm_add_epi16( _mm_add_epi16( m[3], m[4] ), m[5] );
+    const __m128i sp0  = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[1], m[5] ), _mm_slli_epi16( s234, 1 ) ), vfour ), 3 );
+    const __m128i sq0  = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[2], m[6] ), _mm_slli_epi16( s345, 1 ) ), vfour ), 3 );
+    const __m128i sp1  = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( m[1], s234 ), vtwo ), 2 );
+    const __m128i sq1  = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( s345, m[6] ), vtwo ), 2 );
+    const __m128i sp2  = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( m[0], 1 ), _mm_add_epi16( _mm_slli_epi16( m[1], 1 ), m[1] ) ), s234 ), vfour ), 3 );
+    const __m128i sq2  = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( m[7], 1 ), _mm_add_epi16( _mm_slli_epi16( m[6], 1 ), m[6] ) ), s345 ), vfour ), 3 );
+
+    // weak filter
+    __m128i delta = _mm_sub_epi16( _mm_mullo_epi16( _mm_sub_epi16( m[4], m[3] ), _mm_set1_epi16( 9 ) ), _mm_mullo_epi16( _mm_sub_epi16( m[5], m[2] ), _mm_set1_epi16( 3 ) ) );
+    delta = _mm_srai_epi16( _mm_add_epi16( delta, veight ), 4 );
+    const __m128i weak = _mm_cmplt_epi16( _mm_abs_epi16( delta ), vthrCut );
+    delta = clip3( vtcNeg, vtc, delta );
+
+    const __m128i wp0    = clip3( vmin, vmax, _mm_add_epi16( m[3], delta ) );
+    const __m128i wq0    = clip3( vmin, vmax, _mm_sub_epi16( m[4], delta ) );
+    const __m128i delta1 = clip3( vtc2Neg, vtc2, _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( _mm_avg_epu16( m[1], m[3] ), m[2] ), delta ), 1 ) );
+    const __m128i delta2 = clip3( vtc2Neg, vtc2, _mm_srai_epi16( _mm_sub_epi16( _mm_sub_epi16( _mm_avg_epu16( m[6], m[4] ), m[5] ), delta ), 1 ) );
+    const __m128i wp1    = clip3( vmin, vmax, _mm_add_epi16( m[2], delta1 ) );
+    const __m128i wq1    = clip3( vmin, vmax, _mm_add_epi16( m[5], delta2 ) );
+
+    __m128i f[8];
+    f[0] = m[0];
+    f[7] = m[7];
+    f[1] = _mm_blendv_epi8( m[1], clip3( _mm_sub_epi16( m[1], vtcx2 ), _mm_add_epi16( m[1], vtcx2 ), sp2 ), sw );
+    f[2] = _mm_blendv_epi8( _mm_blendv_epi8( m[2], wp1, _mm_and_si128( weak, filtP ) ), clip3( _mm_sub_epi16( m[2], vtcx2 ), _mm_add_epi16( m[2], vtcx2 ), sp1 ), sw );
+    f[3] = _mm_blendv_epi8( _mm_blendv_epi8( m[3], wp0, weak ),                         clip3( _mm_sub_epi16( m[3], vtcx2 ), _mm_add_epi16( m[3], vtcx2 ), sp0 ), sw );
+    f[4] = _mm_blendv_epi8( _mm_blendv_epi8( m[4], wq0, weak ),                         clip3( _mm_sub_epi16( m[4], vtcx2 ), _mm_add_epi16( m[4], vtcx2 ), sq0 ), sw );
+    f[5] = _mm_blendv_epi8( _mm_blendv_epi8( m[5], wq1, _mm_and_si128( weak, filtQ ) ), clip3( _mm_sub_epi16( m[5], vtcx2 ), _mm_add_epi16( m[5], vtcx2 ), sq1 ), sw );
+    f[6] = _mm_blendv_epi8( m[6], clip3( _mm_sub_epi16( m[6], vtcx2 ), _mm_add_epi16( m[6], vtcx2 ), sq2 ), sw );
+
+    // segments failing the on/off decision and excluded sides keep their samples
+    const __m128i keepP = _mm_or_si128( _mm_andnot_si128( filt, _mm_set1_epi16( -1 ) ), vkeepP );
+    const __m128i keepQ = _mm_or_si128( _mm_andnot_si128( filt, _mm_set1_epi16( -1 ) ), vkeepQ );
+    for( int k = 1; k < 4; k++ )
+    {
+      f[k]     = _mm_blendv_epi8( f[k],     m[k],     keepP );
+      f[k + 3] = _mm_blendv_epi8( f[k + 3], m[k + 3], keepQ );
+    }
+
+    if( isVer )
+    {
+      TRANSPOSE8x8( f );
+      for( int l = 0; l < numLines; l++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) ( piSrc + l * iSrcStep - 4 ), f[l] );
+      }
+    }
+    else
+    {
+      for( int k = 1; k < 7; k++ )
+      {
+        Pel* p = piSrc + ( k - 4 ) * iOffset;
+        if( numLines == 8 )
+        {
+          _mm_storeu_si128( ( __m128i* ) p, f[k] );
+        }
+        else
+        {
+          _mm_storel_epi64( ( __m128i* ) p, f[k] );
+        }
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+Void LoopFilter::xFilterChromaLines_SIMD( Pel* piSrc, const int iSrcStep, const int iOffset, const int numLines, const int tc, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng )
+{
+  if( clpRng.bd > 10 )
+  {
+    xFilterChromaLines( piSrc, iSrcStep, iOffset, numLines, tc, bPartPNoFilter, bPartQNoFilter, clpRng );
+    return;
+  }
+
+  const __m128i vzero  = _mm_setzero_si128();
+  const __m128i vtc    = _mm_set1_epi16( tc );
+  const __m128i vtcNeg = _mm_set1_epi16( -tc );
+  const __m128i vmin   = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax   = _mm_set1_epi16( clpRng.max );
+  const __m128i vfour  = _mm_set1_epi16( 4 );
+  const bool    isVer  = iOffset == 1;
+
+  int line = 0;
+
+  // four or eight lines per iteration
+  while( numLines - line >= 4 )
+  {
+    const int n = numLines - line >= 8 ? 8 : 4;
+    __m128i m[8];
+
+    if( isVer )
+    {
+      for( int l = 0; l < 8; l++ )
+      {
+        m[l] = l < n ? _mm_loadl_epi64( ( const __m128i* ) ( piSrc + l * iSrcStep - 2 ) ) : vzero;
+      }
+      TRANSPOSE8x8( m );
+    }
+    else
+    {
+      for( int k = 0; k < 4; k++ )
+      {
+        const Pel* p = piSrc + ( k - 2 ) * iOffset;
+        m[k] = n == 8 ? _mm_loadu_si128( ( const __m128i* ) p ) : _mm_loadl_epi64( ( const __m128i* ) p );
+      }
+    }
+
+    // m[0..3] hold the samples p1, p0, q0, q1
+    __m128i delta = _mm_add_epi16( _mm_slli_epi16( _mm_sub_epi16( m[2], m[1] ), 2 ), _mm_sub_epi16( m[0], m[3] ) );
+    delta = clip3( vtcNeg, vtc, _mm_srai_epi16( _mm_add_epi16( delta, vfour ), 3 ) );
+
+    const __m128i p0 = bPartPNoFilter ? m[1] : clip3( vmin, vmax, _mm_add_epi16( m[1], delta ) );
+    const __m128i q0 = bPartQNoFilter ? m[2] : clip3( vmin, vmax, _mm_sub_epi16( m[2], delta ) );
+
+    if( isVer )
+    {
+      __m128i f[8] = { m[0], p0, q0, m[3], vzero, vzero, vzero, vzero };
+      TRANSPOSE8x8( f );
+      for( int l = 0; l < n; l++ )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( piSrc + l * iSrcStep - 2 ), f[l] );
+      }
+    }
+    else if( n == 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) ( piSrc - iOffset ), p0 );
+      _mm_storeu_si128( ( __m128i* ) ( piSrc           ), q0 );
+    }
+    else
+    {
+      _mm_storel_epi64( ( __m128i* ) ( piSrc - iOffset ), p0 );
+      _mm_storel_epi64( ( __m128i* ) ( piSrc           ), q0 );
+    }
+
+    line  += n;
+    piSrc += n * iSrcStep;
+  }
+
+  if( line < numLines )
+  {
+    xFilterChromaLines( piSrc, iSrcStep, iOffset, numLines - line, tc, bPartPNoFilter, bPartQNoFilter, clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+Void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaSegments = xFilterLumaSegments_SIMD<vext>;
+  m_filterChromaLines  = xFilterChromaLines_SIMD<vext>;
+}
+
+template Void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
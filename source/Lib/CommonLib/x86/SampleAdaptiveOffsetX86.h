@@ -0,0 +1,387 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SAO application and statistics kernels, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+
+// The kernels are written once against the overloads below and instantiated with 8 (SSE) or 16 (AVX2) lanes of 16 bit.
+// A row which is not a multiple of the vector width is finished with an overlapping last vector.
+
+template<typename V> static inline V sao_load( const Pel* p );
+template<typename V> static inline V sao_set1( const int i );
+template<typename V> static inline V sao_lanes();
+
+template<> inline __m128i sao_load <__m128i>( const Pel* p ) { return _mm_loadu_si128( ( const __m128i* ) p ); }
+template<> inline __m128i sao_set1 <__m128i>( const int i )  { return _mm_set1_epi16( ( short ) i ); }
+template<> inline __m128i sao_lanes<__m128i>()               { return _mm_setr_epi16( 0, 1, 2, 3, 4, 5, 6, 7 ); }
+
+static inline void    sao_store  ( Pel* p, const __m128i v )             { _mm_storeu_si128( ( __m128i* ) p, v ); }
+static inline __m128i sao_add    ( const __m128i a, const __m128i b )    { return _mm_add_epi16( a, b ); }
+static inline __m128i sao_sub    ( const __m128i a, const __m128i b )    { return _mm_sub_epi16( a, b ); }
+static inline __m128i sao_and    ( const __m128i a, const __m128i b )    { return _mm_and_si128( a, b ); }
+static inline __m128i sao_or     ( const __m128i a, const __m128i b )    { return _mm_or_si128( a, b ); }
+static inline __m128i sao_cmpeq  ( const __m128i a, const __m128i b )    { return _mm_cmpeq_epi16( a, b ); }
+static inline __m128i sao_cmpgt  ( const __m128i a, const __m128i b )    { return _mm_cmpgt_epi16( a, b ); }
+static inline __m128i sao_srl    ( const __m128i a, const int s )        { return _mm_srli_epi16( a, s ); }
+static inline __m128i sao_sll    ( const __m128i a, const int s )        { return _mm_slli_epi16( a, s ); }
+static inline __m128i sao_addsat ( const __m128i a, const __m128i b )    { return _mm_adds_epi16( a, b ); }
+static inline __m128i sao_clip   ( const __m128i v, const __m128i vmin, const __m128i vmax ) { return _mm_min_epi16( vmax, _mm_max_epi16( vmin, v ) ); }
+static inline __m128i sao_madd   ( const __m128i a, const __m128i b )    { return _mm_madd_epi16( a, b ); }
+static inline __m128i sao_add32  ( const __m128i a, const __m128i b )    { return _mm_add_epi32( a, b ); }
+static inline __m128i sao_lookup ( const __m128i tab, const __m128i idx ){ return _mm_shuffle_epi8( tab, idx ); }
+static inline void    sao_table  ( __m128i& v, const __m128i tab )       { v = tab; }
+
+static inline Int sao_hsum32( const __m128i v )
+{
+  __m128i s = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4e ) );
+  s = _mm_add_epi32( s, _mm_shuffle_epi32( s, 0xb1 ) );
+  return _mm_cvtsi128_si32( s );
+}
+
+#if USE_AVX2
+template<> inline __m256i sao_load <__m256i>( const Pel* p ) { return _mm256_loadu_si256( ( const __m256i* ) p ); }
+template<> inline __m256i sao_set1 <__m256i>( const int i )  { return _mm256_set1_epi16( ( short ) i ); }
+template<> inline __m256i sao_lanes<__m256i>()               { return _mm256_setr_epi16( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ); }
+
+static inline void    sao_store  ( Pel* p, const __m256i v )             { _mm256_storeu_si256( ( __m256i* ) p, v ); }
+static inline __m256i sao_add    ( const __m256i a, const __m256i b )    { return _mm256_add_epi16( a, b ); }
+static inline __m256i sao_sub    ( const __m256i a, const __m256i b )    { return _mm256_sub_epi16( a, b ); }
+static inline __m256i sao_and    ( const __m256i a, const __m256i b )    { return _mm256_and_si256( a, b ); }
+static inline __m256i sao_or     ( const __m256i a, const __m256i b )    { return _mm256_or_si256( a, b ); }
+static inline __m256i sao_cmpeq  ( const __m256i a, const __m256i b )    { return _mm256_cmpeq_epi16( a, b ); }
+static inline __m256i sao_cmpgt  ( const __m256i a, const __m256i b )    { return _mm256_cmpgt_epi16( a, b ); }
+static inline __m256i sao_srl    ( const __m256i a, const int s )        { return _mm256_srli_epi16( a, s ); }
+static inline __m256i sao_sll    ( const __m256i a, const int s )        { return _mm256_slli_epi16( a, s ); }
+static inline __m256i sao_addsat ( const __m256i a, const __m256i b )    { return _mm256_adds_epi16( a, b ); }
+static inline __m256i sao_clip   ( const __m256i v, const __m256i vmin, const __m256i vmax ) { return _mm256_min_epi16( vmax, _mm256_max_epi16( vmin, v ) ); }
+static inline __m256i sao_madd   ( const __m256i a, const __m256i b )    { return _mm256_madd_epi16( a, b ); }
+static inline __m256i sao_add32  ( const __m256i a, const __m256i b )    { return _mm256_add_epi32( a, b ); }
+static inline __m256i sao_lookup ( const __m256i tab, const __m256i idx ){ return _mm256_shuffle_epi8( tab, idx ); }
+static inline void    sao_table  ( __m256i& v, const __m128i tab )       { v = _mm256_broadcastsi128_si256( tab ); }
+
+static inline Int sao_hsum32( const __m256i v )
+{
+  return sao_hsum32( _mm_add_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) ) );
+}
+#endif
+
+/// edge index ( edgeType + 2 ) of the samples at p
+template<typename V>
+static inline V sao_edgeIdx( const V c, const Pel* p, const Int posA, const Int posB, const V vtwo )
+{
+  const V na = sao_load<V>( p + posA );
+  const V nb = sao_load<V>( p + posB );
+  const V sa = sao_sub( sao_cmpgt( na, c ), sao_cmpgt( c, na ) );
+  const V sb = sao_sub( sao_cmpgt( nb, c ), sao_cmpgt( c, nb ) );
+  return sao_add( sao_add( sa, sb ), vtwo );
+}
+
+template<typename V>
+static void sao_offsetLinesEO( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines, Int posA, Int posB, const Int* offset, const ClpRng& clpRng )
+{
+  const Int numLanes = sizeof( V ) / sizeof( Pel );
+
+  // the five offsets as a byte shuffle table, edge index i selects the bytes 2i and 2i+1
+  V vtab;
+  sao_table( vtab, _mm_setr_epi16( offset[-2], offset[-1], offset[0], offset[1], offset[2], 0, 0, 0 ) );
+  const V vmin  = sao_set1<V>( clpRng.min );
+  const V vmax  = sao_set1<V>( clpRng.max );
+  const V vtwo  = sao_set1<V>( 2 );
+  const V vbias = sao_set1<V>( 0x0100 );
+
+  for( Int y = 0; y < numLines; y++ )
+  {
+    for( Int x = startX; x < endX; x += numLanes )
+    {
+      const Int xPos = std::min( x, endX - numLanes );
+      const V   c    = sao_load<V>( srcLine + xPos );
+      const V   idx2 = sao_sll( sao_edgeIdx<V>( c, srcLine + xPos, posA, posB, vtwo ), 1 );
+      const V   off  = sao_lookup( vtab, sao_add( sao_or( idx2, sao_sll( idx2, 8 ) ), vbias ) );
+
+      sao_store( resLine + xPos, sao_clip( sao_addsat( c, off ), vmin, vmax ) );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+template<typename V>
+static void sao_offsetLinesBO( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines, Int shiftBits, const Int* offset, const ClpRng& clpRng )
+{
+  const Int numLanes = sizeof( V ) / sizeof( Pel );
+
+  // only the bands carrying an offset are tested, four for a conforming stream
+  V   vband[NUM_SAO_BO_CLASSES];
+  V   voff [NUM_SAO_BO_CLASSES];
+  Int numBands = 0;
+  for( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+  {
+    if( offset[k] )
+    {
+      vband[numBands] = sao_set1<V>( k );
+      voff [numBands] = sao_set1<V>( offset[k] );
+      numBands++;
+    }
+  }
+  const V vmin = sao_set1<V>( clpRng.min );
+  const V vmax = sao_set1<V>( clpRng.max );
+
+  for( Int y = 0; y < numLines; y++ )
+  {
+    for( Int x = 0; x < width; x += numLanes )
+    {
+      const Int xPos = std::min( x, width - numLanes );
+      const V   c    = sao_load<V>( srcLine + xPos );
+      const V   band = sao_srl( c, shiftBits );
+      V         off  = sao_set1<V>( 0 );
+      for( Int b = 0; b < numBands; b++ )
+      {
+        off = sao_or( off, sao_and( sao_cmpeq( band, vband[b] ), voff[b] ) );
+      }
+
+      sao_store( resLine + xPos, sao_clip( sao_addsat( c, off ), vmin, vmax ) );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+template<typename V>
+static void sao_statsLinesEO( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int posA, Int posB, Int64* diff, Int64* count )
+{
+  const Int numLanes = sizeof( V ) / sizeof( Pel );
+  const Int numVecs  = ( endX - startX + numLanes - 1 ) / numLanes;
+
+  const V vtwo   = sao_set1<V>( 2 );
+  const V vone   = sao_set1<V>( 1 );
+  const V vlanes = sao_lanes<V>();
+  V vclass[NUM_SAO_EO_CLASSES], vdiff[NUM_SAO_EO_CLASSES], vcount[NUM_SAO_EO_CLASSES];
+  for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    vclass[k] = sao_set1<V>( k );
+    vdiff [k] = sao_set1<V>( 0 );
+    vcount[k] = sao_set1<V>( 0 );
+  }
+
+  // counts are kept in 16 bit and sums of madd pairs in 32 bit lanes, flushed before either could overflow
+  Int numAcc = 0;
+
+  for( Int y = 0; y < numLines; y++ )
+  {
+    if( numAcc + numVecs > 32767 )
+    {
+      for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        diff [k - 2] += sao_hsum32( vdiff[k] );
+        count[k - 2] += sao_hsum32( sao_madd( vcount[k], vone ) );
+        vdiff [k] = sao_set1<V>( 0 );
+        vcount[k] = sao_set1<V>( 0 );
+      }
+      numAcc = 0;
+    }
+
+    for( Int x = startX; x < endX; x += numLanes )
+    {
+      const Int xPos  = std::min( x, endX - numLanes );
+      const V   c     = sao_load<V>( srcLine + xPos );
+      const V   idx   = sao_edgeIdx<V>( c, srcLine + xPos, posA, posB, vtwo );
+      const V   d     = sao_sub( sao_load<V>( orgLine + xPos ), c );
+      const V   valid = sao_cmpgt( vlanes, sao_set1<V>( x - xPos - 1 ) );
+
+      for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        const V m = sao_and( sao_cmpeq( idx, vclass[k] ), valid );
+        vcount[k] = sao_sub  ( vcount[k], m );
+        vdiff [k] = sao_add32( vdiff [k], sao_madd( sao_and( d, m ), vone ) );
+      }
+    }
+    numAcc  += numVecs;
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+
+  for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diff [k - 2] += sao_hsum32( vdiff[k] );
+    count[k - 2] += sao_hsum32( sao_madd( vcount[k], vone ) );
+  }
+}
+
+template<typename V>
+static void sao_statsLinesBO( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int shiftBits, Int64* diff, Int64* count )
+{
+  const Int numLanes = sizeof( V ) / sizeof( Pel );
+
+  // band index and difference are computed in vectors, the scatter into the histogram stays scalar on 32 bit counters
+  Int  diffAcc [NUM_SAO_BO_CLASSES] = { 0 };
+  Int  countAcc[NUM_SAO_BO_CLASSES] = { 0 };
+  Pel  band[sizeof( V ) / sizeof( Pel )];
+  Pel  d   [sizeof( V ) / sizeof( Pel )];
+  Int  numAcc = 0;
+
+  for( Int y = 0; y < numLines; y++ )
+  {
+    if( numAcc + ( endX - startX ) > 65536 )
+    {
+      for( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+      {
+        diff [k] += diffAcc [k];
+        count[k] += countAcc[k];
+        diffAcc [k] = 0;
+        countAcc[k] = 0;
+      }
+      numAcc = 0;
+    }
+
+    Int x = startX;
+    for( ; x + numLanes <= endX; x += numLanes )
+    {
+      const V c = sao_load<V>( srcLine + x );
+      sao_store( band, sao_srl( c, shiftBits ) );
+      sao_store( d,    sao_sub( sao_load<V>( orgLine + x ), c ) );
+
+      for( Int i = 0; i < numLanes; i++ )
+      {
+        diffAcc [band[i]] += d[i];
+        countAcc[band[i]] ++;
+      }
+    }
+    for( ; x < endX; x++ )
+    {
+      const Int bandIdx = srcLine[x] >> shiftBits;
+      diffAcc [bandIdx] += orgLine[x] - srcLine[x];
+      countAcc[bandIdx] ++;
+    }
+    numAcc  += std::max( endX - startX, 0 );
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+
+  for( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+  {
+    diff [k] += diffAcc [k];
+    count[k] += countAcc[k];
+  }
+}
+
+template<X86_VEXT vext>
+Void SampleAdaptiveOffset::xOffsetLinesEO_SIMD( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines, Int posA, Int posB, const Int* offset, const ClpRng& clpRng )
+{
+#if USE_AVX2
+  if( vext >= AVX2 && endX - startX >= 16 )
+  {
+    sao_offsetLinesEO<__m256i>( srcLine, srcStride, resLine, resStride, startX, endX, numLines, posA, posB, offset, clpRng );
+    return;
+  }
+#endif
+  if( endX - startX >= 8 )
+  {
+    sao_offsetLinesEO<__m128i>( srcLine, srcStride, resLine, resStride, startX, endX, numLines, posA, posB, offset, clpRng );
+    return;
+  }
+  xOffsetLinesEO( srcLine, srcStride, resLine, resStride, startX, endX, numLines, posA, posB, offset, clpRng );
+}
+
+template<X86_VEXT vext>
+Void SampleAdaptiveOffset::xOffsetLinesBO_SIMD( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines, Int shiftBits, const Int* offset, const ClpRng& clpRng )
+{
+#if USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    sao_offsetLinesBO<__m256i>( srcLine, srcStride, resLine, resStride, width, numLines, shiftBits, offset, clpRng );
+    return;
+  }
+#endif
+  if( width >= 8 )
+  {
+    sao_offsetLinesBO<__m128i>( srcLine, srcStride, resLine, resStride, width, numLines, shiftBits, offset, clpRng );
+    return;
+  }
+  xOffsetLinesBO( srcLine, srcStride, resLine, resStride, width, numLines, shiftBits, offset, clpRng );
+}
+
+template<X86_VEXT vext>
+Void SampleAdaptiveOffset::xStatsLinesEO_SIMD( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int posA, Int posB, Int64* diff, Int64* count )
+{
+#if USE_AVX2
+  if( vext >= AVX2 && endX - startX >= 16 )
+  {
+    sao_statsLinesEO<__m256i>( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, posA, posB, diff, count );
+    return;
+  }
+#endif
+  if( endX - startX >= 8 )
+  {
+    sao_statsLinesEO<__m128i>( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, posA, posB, diff, count );
+    return;
+  }
+  xStatsLinesEO( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, posA, posB, diff, count );
+}
+
+template<X86_VEXT vext>
+Void SampleAdaptiveOffset::xStatsLinesBO_SIMD( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines, Int shiftBits, Int64* diff, Int64* count )
+{
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    sao_statsLinesBO<__m256i>( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, shiftBits, diff, count );
+    return;
+  }
+#endif
+  sao_statsLinesBO<__m128i>( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, shiftBits, diff, count );
+}
+
+template<X86_VEXT vext>
+Void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetLinesEO = xOffsetLinesEO_SIMD<vext>;
+  m_offsetLinesBO = xOffsetLinesBO_SIMD<vext>;
+  m_statsLinesEO  = xStatsLinesEO_SIMD<vext>;
+  m_statsLinesBO  = xStatsLinesBO_SIMD<vext>;
+}
+
+template Void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1,457 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    DCT-II/DST-VII transform kernels, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../TrQuant.h"
+#include "../TrQuant_EMT.h"
+
+#include <algorithm>
+
+//! \ingroup CommonLib
+//! \{
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+
+// The DCT-II kernels evaluate the first even/odd butterfly stage and the remaining matrix products directly,
+// using the same (left half) matrix entries as the scalar butterflies. All arithmetic is 32 bit integer
+// addition and multiplication, so the results are bit exact to the scalar kernels in TrQuant_EMT.cpp.
+
+template<typename T> static inline T tr_load   ( const TCoeff*       p );
+template<typename T> static inline T tr_loadMat( const TMatrixCoeff* p );
+template<typename T> static inline T tr_set1   ( const Int           v );
+
+template<> inline __m128i tr_load   <__m128i>( const TCoeff*       p ) { return _mm_loadu_si128  ( ( const __m128i* ) p ); }
+template<> inline __m128i tr_loadMat<__m128i>( const TMatrixCoeff* p ) { return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) p ) ); }
+template<> inline __m128i tr_set1   <__m128i>( const Int           v ) { return _mm_set1_epi32   ( v ); }
+
+static inline Void    tr_store  ( TCoeff* p, const __m128i& v )                             { _mm_storeu_si128( ( __m128i* ) p, v ); }
+static inline __m128i tr_add    ( const __m128i& a, const __m128i& b )                      { return _mm_add_epi32  ( a, b ); }
+static inline __m128i tr_sub    ( const __m128i& a, const __m128i& b )                      { return _mm_sub_epi32  ( a, b ); }
+static inline __m128i tr_mul    ( const __m128i& a, const __m128i& b )                      { return _mm_mullo_epi32( a, b ); }
+static inline __m128i tr_sra    ( const __m128i& a, const __m128i& vshift )                 { return _mm_sra_epi32  ( a, vshift ); }
+static inline __m128i tr_clip   ( const __m128i& a, const __m128i& vmin, const __m128i& vmax ) { return _mm_min_epi32( vmax, _mm_max_epi32( vmin, a ) ); }
+static inline __m128i tr_reverse( const __m128i& a )                                        { return _mm_shuffle_epi32( a, 0x1b ); }
+
+#if USE_AVX2
+template<> inline __m256i tr_load   <__m256i>( const TCoeff*       p ) { return _mm256_loadu_si256  ( ( const __m256i* ) p ); }
+template<> inline __m256i tr_loadMat<__m256i>( const TMatrixCoeff* p ) { return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) p ) ); }
+template<> inline __m256i tr_set1   <__m256i>( const Int           v ) { return _mm256_set1_epi32   ( v ); }
+
+static inline Void    tr_store  ( TCoeff* p, const __m256i& v )                             { _mm256_storeu_si256( ( __m256i* ) p, v ); }
+static inline __m256i tr_add    ( const __m256i& a, const __m256i& b )                      { return _mm256_add_epi32  ( a, b ); }
+static inline __m256i tr_sub    ( const __m256i& a, const __m256i& b )                      { return _mm256_sub_epi32  ( a, b ); }
+static inline __m256i tr_mul    ( const __m256i& a, const __m256i& b )                      { return _mm256_mullo_epi32( a, b ); }
+static inline __m256i tr_sra    ( const __m256i& a, const __m128i& vshift )                 { return _mm256_sra_epi32  ( a, vshift ); }
+static inline __m256i tr_clip   ( const __m256i& a, const __m256i& vmin, const __m256i& vmax ) { return _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, a ) ); }
+static inline __m256i tr_reverse( const __m256i& a )                                        { return _mm256_permutevar8x32_epi32( a, _mm256_setr_epi32( 7, 6, 5, 4, 3, 2, 1, 0 ) ); }
+#endif
+
+template<Int trSize> static inline const TMatrixCoeff* getDCT2Matrix( const Int dir, const Int use );
+
+template<> inline const TMatrixCoeff* getDCT2Matrix<  4>( const Int dir, const Int use ) { return use ? g_aiTr4  [DCT2][0] : g_aiT4  [dir][0]; }
+template<> inline const TMatrixCoeff* getDCT2Matrix<  8>( const Int dir, const Int use ) { return use ? g_aiTr8  [DCT2][0] : g_aiT8  [dir][0]; }
+template<> inline const TMatrixCoeff* getDCT2Matrix< 16>( const Int dir, const Int use ) { return use ? g_aiTr16 [DCT2][0] : g_aiT16 [dir][0]; }
+template<> inline const TMatrixCoeff* getDCT2Matrix< 32>( const Int dir, const Int use ) { return use ? g_aiTr32 [DCT2][0] : g_aiT32 [dir][0]; }
+template<> inline const TMatrixCoeff* getDCT2Matrix< 64>( const Int dir, const Int use ) { return use ? g_aiTr64 [DCT2][0] : g_aiT64 [dir][0]; }
+template<> inline const TMatrixCoeff* getDCT2Matrix<128>( const Int dir, const Int use ) { return use ? g_aiTr128[DCT2][0] : g_aiT128[dir][0]; }
+
+
+// ********************************** forward DCT-II **********************************
+
+/** forward 1D DCT-II of W lines at once, the lines are processed in the SIMD lanes
+*  \param buf  [tmp] trSize x W buffer holding the transposed input lines
+*/
+template<typename T, Int trSize>
+static inline Void fastForwardDCT2Core_SIMD( const TMatrixCoeff* iT, const TCoeff* src, TCoeff* dst, const Int line, const Int cutoff, const TCoeff rnd, const __m128i vshift, TCoeff* buf )
+{
+  static const Int W = sizeof( T ) / sizeof( TCoeff );
+
+  // transpose, such that the n-th sample of all W lines is contiguous in buf
+  for( Int l = 0; l < W; l += 4 )
+  {
+    for( Int n = 0; n < trSize; n += 4 )
+    {
+      __m128i vsrc[4];
+      for( Int i = 0; i < 4; i++ )
+      {
+        vsrc[i] = _mm_loadu_si128( ( const __m128i* ) &src[( l + i ) * trSize + n] );
+      }
+      TRANSPOSE4x4( vsrc );
+      for( Int i = 0; i < 4; i++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) &buf[( n + i ) * W + l], vsrc[i] );
+      }
+    }
+  }
+
+  // E and O, O is stored mirrored in the upper half of buf
+  for( Int n = 0; n < trSize / 2; n++ )
+  {
+    const T a = tr_load<T>( &buf[n * W] );
+    const T b = tr_load<T>( &buf[( trSize - 1 - n ) * W] );
+    tr_store( &buf[n * W],                  tr_add( a, b ) );
+    tr_store( &buf[( trSize - 1 - n ) * W], tr_sub( a, b ) );
+  }
+
+  const T vrnd = tr_set1<T>( rnd );
+
+  for( Int k = 0; k < cutoff; k++ )
+  {
+    const TMatrixCoeff* coef = iT + k * trSize;
+    T sum = vrnd;
+
+    if( k & 1 )
+    {
+      for( Int n = 0; n < trSize / 2; n++ )
+      {
+        sum = tr_add( sum, tr_mul( tr_set1<T>( coef[n] ), tr_load<T>( &buf[( trSize - 1 - n ) * W] ) ) );
+      }
+    }
+    else
+    {
+      for( Int n = 0; n < trSize / 2; n++ )
+      {
+        sum = tr_add( sum, tr_mul( tr_set1<T>( coef[n] ), tr_load<T>( &buf[n * W] ) ) );
+      }
+    }
+
+    tr_store( &dst[k * line], tr_sra( sum, vshift ) );
+  }
+}
+
+template<X86_VEXT vext, Int trSize>
+Void fastForwardDCT2_SIMD( const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int use )
+{
+  const TMatrixCoeff *iT = getDCT2Matrix<trSize>( TRANSFORM_FORWARD, use );
+
+  const Int     reducedLine = line - iSkipLine;
+  const Int     cutoff      = trSize - iSkipLine2;
+  const TCoeff  rnd_factor  = 1 << ( shift - 1 );
+  const __m128i vshift      = _mm_cvtsi32_si128( shift );
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff buf[trSize * 8] );
+
+  Int j = 0;
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; j + 8 <= reducedLine; j += 8 )
+    {
+      fastForwardDCT2Core_SIMD<__m256i, trSize>( iT, src + j * trSize, dst + j, line, cutoff, rnd_factor, vshift, buf );
+    }
+  }
+#endif
+  for( ; j + 4 <= reducedLine; j += 4 )
+  {
+    fastForwardDCT2Core_SIMD<__m128i, trSize>( iT, src + j * trSize, dst + j, line, cutoff, rnd_factor, vshift, buf );
+  }
+  for( ; j < reducedLine; j++ )
+  {
+    const TCoeff *pSrc = src + j * trSize;
+    for( Int k = 0; k < cutoff; k++ )
+    {
+      TCoeff sum = rnd_factor;
+      for( Int n = 0; n < trSize; n++ )
+      {
+        sum += iT[k * trSize + n] * pSrc[n];
+      }
+      dst[k * line + j] = sum >> shift;
+    }
+  }
+
+  if( iSkipLine )
+  {
+    for( Int k = 0; k < cutoff; k++ )
+    {
+      memset( dst + k * line + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+  }
+  if( iSkipLine2 )
+  {
+    memset( dst + cutoff * line, 0, sizeof( TCoeff ) * line * iSkipLine2 );
+  }
+}
+
+
+// ********************************** inverse DCT-II **********************************
+
+/** inverse 1D DCT-II of a single line, the output samples are processed in the SIMD lanes
+*  only the non-zero coefficients given by idx/val are accumulated, split into even (0) and odd (1) rows
+*/
+template<typename T, Int trSize>
+static inline Void fastInverseDCT2Core_SIMD( const TMatrixCoeff* iT, const Int idx[2][trSize], const TCoeff val[2][trSize], const Int num[2], TCoeff* dst, const TCoeff rnd, const __m128i vshift, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  static const Int W = sizeof( T ) / sizeof( TCoeff );
+
+  const T vmin = tr_set1<T>( outputMinimum );
+  const T vmax = tr_set1<T>( outputMaximum );
+
+  for( Int n = 0; n < trSize / 2; n += W )
+  {
+    T e = tr_set1<T>( rnd );
+    T o = tr_set1<T>( 0 );
+
+    for( Int i = 0; i < num[0]; i++ )
+    {
+      e = tr_add( e, tr_mul( tr_set1<T>( val[0][i] ), tr_loadMat<T>( iT + idx[0][i] * trSize + n ) ) );
+    }
+    for( Int i = 0; i < num[1]; i++ )
+    {
+      o = tr_add( o, tr_mul( tr_set1<T>( val[1][i] ), tr_loadMat<T>( iT + idx[1][i] * trSize + n ) ) );
+    }
+
+    tr_store( dst + n,              tr_clip( tr_sra( tr_add( e, o ), vshift ), vmin, vmax ) );
+    tr_store( dst + trSize - W - n, tr_reverse( tr_clip( tr_sra( tr_sub( e, o ), vshift ), vmin, vmax ) ) );
+  }
+}
+
+template<X86_VEXT vext, Int trSize>
+Void fastInverseDCT2_SIMD( const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int use, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const TMatrixCoeff *iT = getDCT2Matrix<trSize>( TRANSFORM_INVERSE, use );
+
+  const Int     reducedLine = line - iSkipLine;
+  // like the scalar kernels, zeroed-out coefficient rows are skipped in steps of 32
+  // (the 128-point kernel only skips them for the rows not divisible by 4)
+  const Int     rows        = trSize > 32 ? std::max<Int>( 32, trSize - ( iSkipLine2 & ~31 ) ) : trSize;
+  const Int     rowsMod4    = trSize == 128 ? trSize : rows;
+  const TCoeff  rnd_factor  = 1 << ( shift - 1 );
+  const __m128i vshift      = _mm_cvtsi32_si128( shift );
+
+  Int    idx[2][trSize];
+  TCoeff val[2][trSize];
+
+  for( Int j = 0; j < reducedLine; j++ )
+  {
+    Int num[2] = { 0, 0 };
+    for( Int k = 0; k < rowsMod4; k++ )
+    {
+      const TCoeff c = src[k * line + j];
+      if( c && ( k < rows || ( k & 3 ) == 0 ) )
+      {
+        const Int p = k & 1;
+        idx[p][num[p]] = k;
+        val[p][num[p]] = c;
+        num[p]++;
+      }
+    }
+
+#if USE_AVX2
+    if( vext >= AVX2 && trSize >= 16 )
+    {
+      fastInverseDCT2Core_SIMD<__m256i, trSize>( iT, idx, val, num, dst + j * trSize, rnd_factor, vshift, outputMinimum, outputMaximum );
+    }
+    else
+#endif
+    {
+      fastInverseDCT2Core_SIMD<__m128i, trSize>( iT, idx, val, num, dst + j * trSize, rnd_factor, vshift, outputMinimum, outputMaximum );
+    }
+  }
+
+  memset( dst + reducedLine * trSize, 0, trSize * iSkipLine * sizeof( TCoeff ) );
+}
+
+
+// ********************************** DST-VII **********************************
+
+/** forward 4-point DST-VII, four lines at once using the same intermediate terms as the scalar kernel */
+template<X86_VEXT vext>
+Void fastForwardDST7_B4_SIMD( const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int use )
+{
+  const TCoeff rnd_factor = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+
+#if HEVC_USE_4x4_DSTVII
+  const TMatrixCoeff *iT = use ? g_aiTr4[DST7][0] : g_as_DST_MAT_4[TRANSFORM_FORWARD][0];
+#else
+  const TMatrixCoeff *iT = g_aiTr4[DST7][0];
+#endif
+
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+  const __m128i vrnd   = _mm_set1_epi32( rnd_factor );
+  const __m128i vc0    = _mm_set1_epi32( iT[0] );
+  const __m128i vc1    = _mm_set1_epi32( iT[1] );
+  const __m128i vc2    = _mm_set1_epi32( iT[2] );
+
+  const Int reducedLine = line - iSkipLine;
+  Int j = 0;
+
+  for( ; j + 4 <= reducedLine; j += 4 )
+  {
+    __m128i s[4];
+    for( Int i = 0; i < 4; i++ )
+    {
+      s[i] = _mm_loadu_si128( ( const __m128i* ) &src[( j + i ) * 4] );
+    }
+    TRANSPOSE4x4( s );
+
+    const __m128i c0 = _mm_add_epi32( s[0], s[3] );
+    const __m128i c1 = _mm_add_epi32( s[1], s[3] );
+    const __m128i c2 = _mm_sub_epi32( s[0], s[1] );
+    const __m128i c3 = _mm_mullo_epi32( vc2, s[2] );
+
+    __m128i d;
+    d = _mm_add_epi32( _mm_add_epi32( _mm_mullo_epi32( vc0, c0 ), _mm_mullo_epi32( vc1, c1 ) ), _mm_add_epi32( c3, vrnd ) );
+    _mm_storeu_si128( ( __m128i* ) &dst[0 * line + j], _mm_sra_epi32( d, vshift ) );
+    d = _mm_add_epi32( _mm_mullo_epi32( vc2, _mm_sub_epi32( _mm_add_epi32( s[0], s[1] ), s[3] ) ), vrnd );
+    _mm_storeu_si128( ( __m128i* ) &dst[1 * line + j], _mm_sra_epi32( d, vshift ) );
+    d = _mm_add_epi32( _mm_sub_epi32( _mm_add_epi32( _mm_mullo_epi32( vc0, c2 ), _mm_mullo_epi32( vc1, c0 ) ), c3 ), vrnd );
+    _mm_storeu_si128( ( __m128i* ) &dst[2 * line + j], _mm_sra_epi32( d, vshift ) );
+    d = _mm_add_epi32( _mm_sub_epi32( _mm_mullo_epi32( vc1, c2 ), _mm_mullo_epi32( vc0, c1 ) ), _mm_add_epi32( c3, vrnd ) );
+    _mm_storeu_si128( ( __m128i* ) &dst[3 * line + j], _mm_sra_epi32( d, vshift ) );
+  }
+  for( ; j < reducedLine; j++ )
+  {
+    const TCoeff *s = src + j * 4;
+    const TCoeff c0 = s[0] + s[3];
+    const TCoeff c1 = s[1] + s[3];
+    const TCoeff c2 = s[0] - s[1];
+    const TCoeff c3 = iT[2] * s[2];
+
+    dst[0 * line + j] = ( iT[0] * c0 + iT[1] * c1 + c3 + rnd_factor ) >> shift;
+    dst[1 * line + j] = ( iT[2] * ( s[0] + s[1] - s[3] ) + rnd_factor ) >> shift;
+    dst[2 * line + j] = ( iT[0] * c2 + iT[1] * c0 - c3 + rnd_factor ) >> shift;
+    dst[3 * line + j] = ( iT[1] * c2 - iT[0] * c1 + c3 + rnd_factor ) >> shift;
+  }
+
+  if( iSkipLine )
+  {
+    for( Int k = 0; k < 4; k++ )
+    {
+      memset( dst + k * line + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+  }
+}
+
+/** inverse 4-point DST-VII, four lines at once using the same intermediate terms as the scalar kernel */
+template<X86_VEXT vext>
+Void fastInverseDST7_B4_SIMD( const TCoeff *src, TCoeff *dst, Int shift, Int line, Int iSkipLine, Int iSkipLine2, Int use, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const TCoeff rnd_factor = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+
+#if HEVC_USE_4x4_DSTVII
+  const TMatrixCoeff *iT = use ? g_aiTr4[DST7][0] : g_as_DST_MAT_4[TRANSFORM_INVERSE][0];
+#else
+  const TMatrixCoeff *iT = g_aiTr4[DST7][0];
+#endif
+
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+  const __m128i vrnd   = _mm_set1_epi32( rnd_factor );
+  const __m128i vmin   = _mm_set1_epi32( outputMinimum );
+  const __m128i vmax   = _mm_set1_epi32( outputMaximum );
+  const __m128i vc0    = _mm_set1_epi32( iT[0] );
+  const __m128i vc1    = _mm_set1_epi32( iT[1] );
+  const __m128i vc2    = _mm_set1_epi32( iT[2] );
+
+  const Int reducedLine = line - iSkipLine;
+  Int j = 0;
+
+  for( ; j + 4 <= reducedLine; j += 4 )
+  {
+    __m128i s[4];
+    for( Int k = 0; k < 4; k++ )
+    {
+      s[k] = _mm_loadu_si128( ( const __m128i* ) &src[k * line + j] );
+    }
+
+    const __m128i c0 = _mm_add_epi32( s[0], s[2] );
+    const __m128i c1 = _mm_add_epi32( s[2], s[3] );
+    const __m128i c2 = _mm_sub_epi32( s[0], s[3] );
+    const __m128i c3 = _mm_mullo_epi32( vc2, s[1] );
+
+    __m128i d[4];
+    d[0] = _mm_add_epi32( _mm_add_epi32( _mm_mullo_epi32( vc0, c0 ), _mm_mullo_epi32( vc1, c1 ) ), _mm_add_epi32( c3, vrnd ) );
+    d[1] = _mm_add_epi32( _mm_sub_epi32( _mm_mullo_epi32( vc1, c2 ), _mm_mullo_epi32( vc0, c1 ) ), _mm_add_epi32( c3, vrnd ) );
+    d[2] = _mm_add_epi32( _mm_mullo_epi32( vc2, _mm_add_epi32( _mm_sub_epi32( s[0], s[2] ), s[3] ) ), vrnd );
+    d[3] = _mm_add_epi32( _mm_sub_epi32( _mm_add_epi32( _mm_mullo_epi32( vc1, c0 ), _mm_mullo_epi32( vc0, c2 ) ), c3 ), vrnd );
+
+    for( Int i = 0; i < 4; i++ )
+    {
+      d[i] = _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_sra_epi32( d[i], vshift ) ) );
+    }
+    TRANSPOSE4x4( d );
+    for( Int i = 0; i < 4; i++ )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst[( j + i ) * 4], d[i] );
+    }
+  }
+  for( ; j < reducedLine; j++ )
+  {
+    const TCoeff c0 = src[0 * line + j] + src[2 * line + j];
+    const TCoeff c1 = src[2 * line + j] + src[3 * line + j];
+    const TCoeff c2 = src[0 * line + j] - src[3 * line + j];
+    const TCoeff c3 = iT[2] * src[1 * line + j];
+
+    dst[j * 4 + 0] = Clip3( outputMinimum, outputMaximum, ( iT[0] * c0 + iT[1] * c1 + c3 + rnd_factor ) >> shift );
+    dst[j * 4 + 1] = Clip3( outputMinimum, outputMaximum, ( iT[1] * c2 - iT[0] * c1 + c3 + rnd_factor ) >> shift );
+    dst[j * 4 + 2] = Clip3( outputMinimum, outputMaximum, ( iT[2] * ( src[0 * line + j] - src[2 * line + j] + src[3 * line + j] ) + rnd_factor ) >> shift );
+    dst[j * 4 + 3] = Clip3( outputMinimum, outputMaximum, ( iT[1] * c0 + iT[0] * c2 - c3 + rnd_factor ) >> shift );
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst + reducedLine * 4, 0, ( iSkipLine << 2 ) * sizeof( TCoeff ) );
+  }
+}
+
+
+template<X86_VEXT vext>
+Void TrQuant::_initTrQuantX86()
+{
+  // the 2-point kernels and the 4-point inverse DCT-II stay scalar, there is little to gain from vectorizing them
+  m_fwdTrans[TRAFO_DCT2_B4  ] = fastForwardDCT2_SIMD<vext,   4>;
+  m_fwdTrans[TRAFO_DCT2_B8  ] = fastForwardDCT2_SIMD<vext,   8>;
+  m_fwdTrans[TRAFO_DCT2_B16 ] = fastForwardDCT2_SIMD<vext,  16>;
+  m_fwdTrans[TRAFO_DCT2_B32 ] = fastForwardDCT2_SIMD<vext,  32>;
+  m_fwdTrans[TRAFO_DCT2_B64 ] = fastForwardDCT2_SIMD<vext,  64>;
+  m_fwdTrans[TRAFO_DCT2_B128] = fastForwardDCT2_SIMD<vext, 128>;
+  m_fwdTrans[TRAFO_DST7_B4  ] = fastForwardDST7_B4_SIMD<vext>;
+
+  m_invTrans[TRAFO_DCT2_B8  ] = fastInverseDCT2_SIMD<vext,   8>;
+  m_invTrans[TRAFO_DCT2_B16 ] = fastInverseDCT2_SIMD<vext,  16>;
+  m_invTrans[TRAFO_DCT2_B32 ] = fastInverseDCT2_SIMD<vext,  32>;
+  m_invTrans[TRAFO_DCT2_B64 ] = fastInverseDCT2_SIMD<vext,  64>;
+  m_invTrans[TRAFO_DCT2_B128] = fastInverseDCT2_SIMD<vext, 128>;
+  m_invTrans[TRAFO_DST7_B4  ] = fastInverseDST7_B4_SIMD<vext>;
+}
+
+template Void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
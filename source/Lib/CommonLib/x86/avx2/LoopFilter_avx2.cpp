@@ -0,0 +1 @@
+#include "../LoopFilterX86.h"
\ No newline at end of file
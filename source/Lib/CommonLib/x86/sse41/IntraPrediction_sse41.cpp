@@ -0,0 +1 @@
+#include "../IntraPredictionX86.h"
\ No newline at end of file
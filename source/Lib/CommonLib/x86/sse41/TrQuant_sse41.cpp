@@ -0,0 +1 @@
+#include "../TrQuantX86.h"
\ No newline at end of file
@@ -38,8 +38,19 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include <vector>
 #include "AnnexBread.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
@@ -195,4 +206,247 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = UInt(nalUnit.size());
   return eof;
 }
+
+// ====================================================================================================================
+// Memory mapped byte stream
+// ====================================================================================================================
+
+MappedInputByteStream::MappedInputByteStream()
+: m_data   ( nullptr )
+, m_size   ( 0 )
+, m_pos    ( 0 )
+#ifdef _WIN32
+, m_file   ( nullptr )
+, m_mapping( nullptr )
+#else
+, m_file   ( -1 )
+#endif
+{
+}
+
+Bool MappedInputByteStream::open( const std::string& fileName )
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+  if( file == INVALID_HANDLE_VALUE )
+  {
+    return false;
+  }
+  m_file = file;
+
+  LARGE_INTEGER fileSize;
+  if( !GetFileSizeEx( file, &fileSize ) )
+  {
+    close();
+    return false;
+  }
+
+  if( fileSize.QuadPart > 0 )
+  {
+    m_mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    m_data    = m_mapping ? ( const uint8_t* ) MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+    if( !m_data )
+    {
+      close();
+      return false;
+    }
+    m_size = std::size_t( fileSize.QuadPart );
+  }
+#else
+  m_file = ::open( fileName.c_str(), O_RDONLY );
+  if( m_file < 0 )
+  {
+    return false;
+  }
+
+  struct stat fileStat;
+  if( fstat( m_file, &fileStat ) != 0 )
+  {
+    close();
+    return false;
+  }
+
+  if( fileStat.st_size > 0 )
+  {
+    void* data = mmap( NULL, std::size_t( fileStat.st_size ), PROT_READ, MAP_PRIVATE, m_file, 0 );
+    if( data == MAP_FAILED )
+    {
+      close();
+      return false;
+    }
+    madvise( data, std::size_t( fileStat.st_size ), MADV_SEQUENTIAL );
+
+    m_data = ( const uint8_t* ) data;
+    m_size = std::size_t( fileStat.st_size );
+  }
+#endif
+
+  m_pos = 0;
+  return true;
+}
+
+Void MappedInputByteStream::close()
+{
+#ifdef _WIN32
+  if( m_data )
+  {
+    UnmapViewOfFile( m_data );
+  }
+  if( m_mapping )
+  {
+    CloseHandle( m_mapping );
+  }
+  if( m_file )
+  {
+    CloseHandle( m_file );
+  }
+  m_mapping = nullptr;
+  m_file    = nullptr;
+#else
+  if( m_data )
+  {
+    munmap( const_cast<uint8_t*>( m_data ), m_size );
+  }
+  if( m_file >= 0 )
+  {
+    ::close( m_file );
+  }
+  m_file = -1;
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+  m_pos  = 0;
+}
+
+static inline Bool isStartCode( const uint8_t* p, const uint8_t* end )
+{
+  /* 0x000001 or 0x00000001 */
+  return ( end - p >= 3 && p[0] == 0 && p[1] == 0 && p[2] == 1 )
+      || ( end - p >= 4 && p[0] == 0 && p[1] == 0 && p[2] == 0 && p[3] == 1 );
+}
+
+/**
+ * Locate the next NAL unit directly in the mapped byte stream, following the
+ * same steps as the std::istream based parser above. nalUnit points into the
+ * mapping and stays valid as long as bs is open.
+ */
+static Bool
+_byteStreamNALUnit(
+  MappedInputByteStream& bs,
+  const uint8_t*& nalUnit,
+  std::size_t& nalUnitSize,
+  AnnexBStats& stats)
+{
+  const uint8_t* const begin = bs.getData();
+  const uint8_t* const end   = begin + bs.getSize();
+  const uint8_t*       pos   = begin + bs.getPosition();
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  CodingStatistics::SStat &statBits=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  CodingStatistics::SStat &bodyStats=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+  const uint8_t* const start = pos;
+#endif
+
+  /* leading_zero_8bits */
+  while( !isStartCode( pos, end ) )
+  {
+    if( pos == end )
+    {
+      bs.setPosition( bs.getSize() );
+      return true;
+    }
+    if( *pos != 0 ) { THROW( "Leading zero bits not zero" ); }
+    stats.m_numLeadingZero8BitsBytes++;
+    pos++;
+  }
+
+  /* zero_byte and start_code_prefix_one_3bytes */
+  if( pos[2] != 1 )
+  {
+    stats.m_numZeroByteBytes++;
+    pos++;
+  }
+  stats.m_numStartCodePrefixBytes += 3;
+  pos += 3;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  statBits.bits += 8 * UInt( pos - start ); statBits.count += UInt( pos - start );
+#endif
+
+  /* NumBytesInNALunit: scan for the next byte-aligned 0x000000, 0x000001 or 0x000002,
+   * only positions of zero bytes need to be inspected */
+  const uint8_t* nalEnd = pos;
+  while( true )
+  {
+    nalEnd = ( const uint8_t* ) memchr( nalEnd, 0, end - nalEnd );
+    if( !nalEnd || end - nalEnd < 3 )
+    {
+      nalEnd = end;
+      break;
+    }
+    if( nalEnd[1] == 0 && nalEnd[2] <= 2 )
+    {
+      break;
+    }
+    nalEnd += nalEnd[1] == 0 ? 1 : 2;
+  }
+
+  nalUnit     = pos;
+  nalUnitSize = std::size_t( nalEnd - pos );
+  pos         = nalEnd;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  bodyStats.bits += 8 * UInt( nalUnitSize ); bodyStats.count += UInt( nalUnitSize );
+#endif
+
+  /* trailing_zero_8bits */
+  Bool eof = false;
+  while( !isStartCode( pos, end ) )
+  {
+    if( pos == end )
+    {
+      eof = true;
+      break;
+    }
+    CHECK( *pos != 0, "Trailing zero bits not '0'" );
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    stats.m_numTrailingZero8BitsBytes++;
+    pos++;
+  }
+
+  bs.setPosition( std::size_t( pos - begin ) );
+  return eof;
+}
+
+/**
+ * Locate a single nalUnit in the memory mapped Annex-B byte stream bs
+ * without copying it, while accumulating bytestream statistics into stats.
+ *
+ * Returns true if the end of the byte stream was reached (NB, nalunit data
+ * may be valid), otherwise false.
+ */
+Bool
+byteStreamNALUnit(
+  MappedInputByteStream& bs,
+  const uint8_t*& nalUnit,
+  std::size_t& nalUnitSize,
+  AnnexBStats& stats)
+{
+  Bool eof = false;
+  nalUnit     = nullptr;
+  nalUnitSize = 0;
+  try
+  {
+    eof = _byteStreamNALUnit(bs, nalUnit, nalUnitSize, stats);
+  }
+  catch (...)
+  {
+    bs.setPosition( bs.getSize() );
+    eof = true;
+  }
+  stats.m_numBytesInNALUnit = UInt(nalUnitSize);
+  return eof;
+}
 //! \}
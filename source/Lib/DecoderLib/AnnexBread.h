@@ -43,7 +43,9 @@
 
 #include <stdint.h>
 #include <istream>
+#include <string>
 #include <vector>
+#include <algorithm>
 
 #include "CommonLib/CommonDef.h"
 
@@ -170,6 +172,42 @@ private:
   std::istream& m_Input; /* Input stream to read from */
 };
 
+/**
+ * Read-only memory mapping of a complete Annex-B byte stream file.
+ * NAL units are located directly in the mapped data, avoiding the byte-wise
+ * std::istream access of InputByteStream.
+ */
+class MappedInputByteStream
+{
+public:
+  MappedInputByteStream();
+  ~MappedInputByteStream() { close(); }
+
+  /** map the file, returns false if the file cannot be opened or mapped */
+  Bool open ( const std::string& fileName );
+  Void close();
+
+  Bool           eof         ()                  const { return m_pos >= m_size; }
+  std::size_t    getPosition ()                  const { return m_pos; }
+  Void           setPosition ( std::size_t pos )       { m_pos = std::min( pos, m_size ); }
+  const uint8_t* getData     ()                  const { return m_data; }
+  std::size_t    getSize     ()                  const { return m_size; }
+
+private:
+  MappedInputByteStream( const MappedInputByteStream& ) = delete;
+  MappedInputByteStream& operator=( const MappedInputByteStream& ) = delete;
+
+  const uint8_t* m_data;   /* start of the mapped file */
+  std::size_t    m_size;   /* size of the mapped file in bytes */
+  std::size_t    m_pos;    /* current position in the byte stream */
+#ifdef _WIN32
+  void*          m_file;
+  void*          m_mapping;
+#else
+  Int            m_file;
+#endif
+};
+
 /**
  * Statistics associated with AnnexB bytestreams
  */
@@ -193,6 +231,7 @@ struct AnnexBStats
 };
 
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
+Bool byteStreamNALUnit(MappedInputByteStream& bs, const uint8_t*& nalUnit, std::size_t& nalUnitSize, AnnexBStats& stats);
 
 //! \}
 
@@ -41,6 +41,7 @@
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/DiagLog.h"
 #include "CommonLib/UnitTools.h"
 
 #include <fstream>
@@ -1773,7 +1774,7 @@ Bool DecLib::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDispl
 #if BG_REFERENCE_SUBSTITUTION
 	//cout << "setRefPicList" << endl;
 	Int SetRefPoc = -999;
-	cout <<a<< "afterdebg" << afterdebg<<endl;
+	DIAG_LOG( DETAILS, "%d afterdebg %d\n", a ? 1 : 0, afterdebg ? 1 : 0 );
 #if BLOCK_ENCODE
 	if (afterdebg)
 	{
@@ -1914,20 +1915,21 @@ Bool DecLib::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDispl
 				  num_block++;
 			  }
 		  }
-		  cout << "num_block" << num_block << endl;
+		  DIAG_LOG( DETAILS, "num_block %d\n", num_block );
 
-		  { // cout
+		  if( DiagLog::isEnabled( DETAILS ) )
+		  {
 			  Int i = 0;
 			  Int j = 0;
-			  cout << endl;
+			  DIAG_LOG( DETAILS, "\n" );
 			  while (i < num_block)
 			  {
-				  cout << BgBlock[i] << " ";
+				  DIAG_LOG( DETAILS, "%d ", BgBlock[i] );
 				  if (BgBlock[i] != 0)
 					  j++;
 				  i++;
 			  }
-			  cout << endl <<" bgBlock " << j << endl;
+			  DIAG_LOG( DETAILS, "\n bgBlock %d\n", j );
 		  }
 	  }
 	 
@@ -1942,7 +1944,7 @@ Bool DecLib::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDispl
 #if ENCODE_BGPIC
   if (pcSlice->getPOC() == BGPICPOC)
   {
-	  cout << isO << "  " << pcSlice->getPOC() << endl;
+	  DIAG_LOG( DETAILS, "%d  %d\n", isO ? 1 : 0, pcSlice->getPOC() );
   }
   if (pcSlice->getPOC() == BGPICPOC && isO)
   {
@@ -1952,7 +1954,7 @@ Bool DecLib::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDispl
 	  pcSlice->getPic()->CopyPic2Reco(bg_NewPicYuvReco,pcSlice->getPic());
 
 	  isO = false;
-	  cout << isO << "  " << pcSlice->getPOC() << endl;
+	  DIAG_LOG( DETAILS, "%d  %d\n", isO ? 1 : 0, pcSlice->getPOC() );
   }
   
   
@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 
@@ -56,44 +57,74 @@ using namespace std;
 
 //! \ingroup DecoderLib
 //! \{
-static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, Bool isVclNalUnit)
+/**
+ * convert the NAL unit payload of size bytes at src to the RBSP in nalUnitBuf,
+ * src may point to the data of nalUnitBuf itself for an in-place conversion
+ */
+static Void convertPayloadToRBSP(const uint8_t* src, std::size_t size, vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, Bool isVclNalUnit)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  if (src != nalUnitBuf.data())
+  {
+    nalUnitBuf.resize(size);
+  }
+
+  const uint8_t*    buf      = src;
+  uint8_t*          dst      = nalUnitBuf.data();
+  std::size_t       readPos  = 0;
+  std::size_t       writePos = 0;
+  Bool              endsWithEmulationPrevention = false;
 
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+
+  /* move the payload in blocks up to and including each pair of zero bytes,
+   * only the byte following such a pair can be an emulation_prevention_three_byte */
+  while (readPos < size)
   {
-    CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
-    if (zeroCount == 2 && *it_read == 0x03)
+    const uint8_t* zeros = buf + readPos;
+    while ((zeros = (const uint8_t*) memchr(zeros, 0, buf + size - zeros)) != NULL && zeros + 1 < buf + size && zeros[1] != 0)
+    {
+      zeros += 2;
+    }
+
+    const std::size_t blockEnd = (zeros == NULL || zeros + 1 >= buf + size) ? size : std::size_t(zeros - buf) + 2;
+    if (dst + writePos != buf + readPos)
+    {
+      memmove(dst + writePos, buf + readPos, blockEnd - readPos);
+    }
+    writePos += blockEnd - readPos;
+    readPos   = blockEnd;
+
+    if (readPos == size)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      break;
+    }
+
+    CHECK(buf[readPos] < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (buf[readPos] == 0x03)
+    {
+      bitstream->pushEmulationPreventionByteLocation( UInt( readPos ) );
+      readPos++;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
+      if (readPos == size)
       {
+        endsWithEmulationPrevention = true;
         break;
       }
-      CHECK(*it_read > 0x03, "Read a value bigger than '3'");
+      CHECK(buf[readPos] > 0x03, "Read a value bigger than '3'");
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
   }
-  CHECK(zeroCount != 0, "Zero count not '0'");
+  CHECK(!endsWithEmulationPrevention && writePos > 0 && dst[writePos - 1] == 0x00, "Zero count not '0'");
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     Int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (dst[writePos - 1] == 0x00)
     {
-      it_write--;
+      writePos--;
       n++;
     }
 
@@ -103,7 +134,7 @@ static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(writePos);
 }
 
 #if ENABLE_TRACING
@@ -184,7 +215,21 @@ Void read(InputNALUnit& nalu)
   InputBitstream &bitstream = nalu.getBitstream();
   vector<uint8_t>& nalUnitBuf=bitstream.getFifo();
   // perform anti-emulation prevention
-  convertPayloadToRBSP(nalUnitBuf, &bitstream, (nalUnitBuf[0] & 64) == 0);
+  convertPayloadToRBSP(nalUnitBuf.data(), nalUnitBuf.size(), nalUnitBuf, &bitstream, (nalUnitBuf[0] & 64) == 0);
+  bitstream.resetToStart();
+  readNalUnitHeader(nalu);
+}
+
+/**
+ * create a NALunit structure from a NAL unit payload that is not owned by
+ * the bitstream, e.g. located in a memory mapped byte stream; the payload is
+ * copied only once, while removing the emulation prevention bytes
+ */
+Void read(InputNALUnit& nalu, const uint8_t* nalUnitData, std::size_t nalUnitSize)
+{
+  InputBitstream &bitstream = nalu.getBitstream();
+  // perform anti-emulation prevention
+  convertPayloadToRBSP(nalUnitData, nalUnitSize, bitstream.getFifo(), &bitstream, (nalUnitData[0] & 64) == 0);
   bitstream.resetToStart();
   readNalUnitHeader(nalu);
 }
@@ -66,6 +66,7 @@ class InputNALUnit : public NALUnit
 };
 
 Void read(InputNALUnit& nalu);
+Void read(InputNALUnit& nalu, const uint8_t* nalUnitData, std::size_t nalUnitSize);
 Void readNalUnitHeader(InputNALUnit& nalu);
 
 //! \}
@@ -0,0 +1,144 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/** \file     CtuStats.cpp
+    \brief    per-CTU encoder statistics and their asynchronous writer
+*/
+
+#include "CtuStats.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+const char* CtuStats::getCsvHeader()
+{
+  return "poc,ctu,x,y,time_us,num_cus,max_depth,skip_area,merge_area,inter_area,intra_area,bg_ref_area,bg_ctu,bg_blocks,bg_blocks_pending,bg_blocks_coded\n";
+}
+
+std::string CtuStats::toCsv() const
+{
+  char line[256];
+  snprintf( line, sizeof( line ), "%d,%u,%d,%d,%lld,%d,%d,%u,%u,%u,%u,%u,%d,%d,%d,%d\n", poc, ctuRsAddr, posX, posY, (long long) timeUs, numCUs, maxDepth,
+            skipArea, mergeArea, interArea, intraArea, bgRefArea, bgCtu, bgBlocks, bgBlocksPending, bgBlocksCoded );
+  return std::string( line );
+}
+
+CtuStatsWriter::CtuStatsWriter()
+  : m_file( nullptr )
+  , m_done( false )
+{
+}
+
+CtuStatsWriter::~CtuStatsWriter()
+{
+  close();
+}
+
+Bool CtuStatsWriter::open( const std::string& fileName )
+{
+  CHECK( m_file, "CTU statistics file already open" );
+
+  m_file = fopen( fileName.c_str(), "w" );
+  if( !m_file )
+  {
+    return false;
+  }
+
+  // the writer thread issues large writes, one per queued picture
+  setvbuf( m_file, nullptr, _IOFBF, 1 << 16 );
+  fputs( CtuStats::getCsvHeader(), m_file );
+
+  m_done   = false;
+  m_thread = std::thread( &CtuStatsWriter::xWriteLoop, this );
+  return true;
+}
+
+Void CtuStatsWriter::close()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_done = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  if( m_file )
+  {
+    fclose( m_file );
+    m_file = nullptr;
+  }
+}
+
+Void CtuStatsWriter::write( std::string& records )
+{
+  if( records.empty() )
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_queue.push_back( std::string() );
+    m_queue.back().swap( records );
+  }
+  m_cond.notify_one();
+}
+
+Void CtuStatsWriter::xWriteLoop()
+{
+  while( true )
+  {
+    std::string records;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cond.wait( lock, [&] { return !m_queue.empty() || m_done; } );
+      if( m_queue.empty() )
+      {
+        break;
+      }
+      records.swap( m_queue.front() );
+      m_queue.pop_front();
+    }
+
+    fwrite( records.data(), 1, records.size(), m_file );
+  }
+
+  fflush( m_file );
+}
+
+//! \}
@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     CtuStats.h
+    \brief    per-CTU encoder statistics and their asynchronous writer (header)
+*/
+
+#ifndef __CTUSTATS__
+#define __CTUSTATS__
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "CommonLib/CommonDef.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// encoding time, decisions and background state of one CTU, areas are given in luma samples
+struct CtuStats
+{
+  Int     poc;
+  UInt    ctuRsAddr;
+  Int     posX;
+  Int     posY;
+  Int64   timeUs;              ///< wall time spent in compressCtu
+  Int     numCUs;
+  Int     maxDepth;            ///< largest split depth of the chosen CUs
+  UInt    skipArea;
+  UInt    mergeArea;           ///< merge CUs that are not skipped
+  UInt    interArea;           ///< inter CUs with explicitly coded motion
+  UInt    intraArea;
+  UInt    bgRefArea;           ///< inter CUs predicted from the reference picture carrying the background blocks
+  Int     bgCtu;               ///< BgCTU state of the CTU
+  Int     bgBlocks;            ///< background generation blocks in the CTU
+  Int     bgBlocksPending;     ///< blocks with a background count (0 < BgBlock < 2000)
+  Int     bgBlocksCoded;       ///< blocks coded into the background picture (BgBlock >= 2000)
+
+  static const char* getCsvHeader();
+  std::string        toCsv       () const;
+};
+
+/// appends text records to a file on a separate thread
+class CtuStatsWriter
+{
+public:
+  CtuStatsWriter();
+  ~CtuStatsWriter();
+
+  Bool open   ( const std::string& fileName );                                         ///< create the file and start the writer thread
+  Void close  ();                                                                      ///< write all queued records and close the file
+  Bool isOpen () const { return m_file != nullptr; }
+
+  Void write  ( std::string& records );                                                ///< queue the records for writing, the string is emptied
+
+private:
+  Void xWriteLoop();
+
+  FILE*                   m_file;
+  std::deque<std::string> m_queue;
+  std::thread             m_thread;
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  Bool                    m_done;
+};
+
+//! \}
+
+#endif // __CTUSTATS__
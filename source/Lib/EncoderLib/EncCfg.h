@@ -131,6 +131,7 @@ protected:
   Bool      m_printMSEBasedSequencePSNR;
   Bool      m_printFrameMSE;
   Bool      m_printSequenceMSE;
+  Bool      m_asyncMetrics;
   Bool      m_cabacZeroWordPaddingEnabled;
 
 
@@ -195,6 +196,7 @@ protected:
   bool      m_useFastLCTU;
   bool      m_useFastMrg;
   bool      m_usePbIntraFast;
+  bool      m_useFastIntraGradient;
   bool      m_useAMaxBT;
   bool      m_useSaveLoadEncInfo;
   bool      m_useSaveLoadSplitDecision;
@@ -226,6 +228,7 @@ protected:
 
   //====== Motion search ========
   Bool      m_bDisableIntraPUsInInterSlices;
+  Bool      m_bgSkipIntra;
   MESearchMethod m_motionEstimationSearchMethod;
   Int       m_iSearchRange;                     //  0:Full frame
   Int       m_bipredSearchRange;
@@ -233,6 +236,7 @@ protected:
   Bool      m_bFastMEAssumingSmootherMVEnabled;
   Int       m_minSearchWindow;
   Bool      m_bRestrictMESampling;
+  Bool      m_useHierarchicalME;
 
   //====== Quality control ========
   Int       m_iMaxDeltaQP;                      //  Max. absolute delta QP (1:default)
@@ -270,12 +274,15 @@ protected:
 #if T0196_SELECTIVE_RDOQ
   Bool      m_useSelectiveRDOQ;
 #endif
+  Int       m_fastRDOQ;
   UInt      m_rdPenalty;
   FastInterSearchMode m_fastInterSearchMode;
   Bool      m_bUseEarlyCU;
   Bool      m_useFastDecisionForMerge;
   Bool      m_bUseCbfFastMode;
   Bool      m_useEarlySkipDetection;
+  Bool      m_useSpeedGovernor;
+  Double    m_speedGovernorFps;
   Bool      m_crossComponentPredictionEnabledFlag;
   Bool      m_reconBasedCrossCPredictionEstimate;
   UInt      m_log2SaoOffsetScale[MAX_NUM_CHANNEL_TYPE];
@@ -474,6 +481,7 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  std::string m_ctuStatsFileName;                             ///< filename of the per-CTU statistics, no statistics if empty.
   std::string m_decodeBitstreams[2];                          ///< filename for decode bitstreams.
   bool        m_forceDecodeBitstream1;                        ///< guess what it means
   int         m_switchPOC;                                    ///< dbg poc.
@@ -531,6 +539,9 @@ public:
   Bool      getPrintSequenceMSE             ()         const { return m_printSequenceMSE;           }
   Void      setPrintSequenceMSE             (Bool value)     { m_printSequenceMSE = value;          }
 
+  Bool      getAsyncMetrics                 ()         const { return m_asyncMetrics;               }
+  Void      setAsyncMetrics                 (Bool value)     { m_asyncMetrics = value;              }
+
   Bool      getCabacZeroWordPaddingEnabled()           const { return m_cabacZeroWordPaddingEnabled;  }
   Void      setCabacZeroWordPaddingEnabled(Bool value)       { m_cabacZeroWordPaddingEnabled = value; }
 
@@ -605,6 +616,8 @@ public:
   bool      getUseFastMerge                 () const         { return m_useFastMrg; }
   Void      setUsePbIntraFast               ( bool  n )      { m_usePbIntraFast = n; }
   bool      getUsePbIntraFast               () const         { return m_usePbIntraFast; }
+  Void      setUseFastIntraGradient         ( bool  b )      { m_useFastIntraGradient = b; }
+  bool      getUseFastIntraGradient         () const         { return m_useFastIntraGradient; }
   Void      setUseAMaxBT                    ( bool  n )      { m_useAMaxBT = n; }
   bool      getUseAMaxBT                    () const         { return m_useAMaxBT; }
   Void      setUseSaveLoadEncInfo           ( bool  b )      { m_useSaveLoadEncInfo = b; }
@@ -637,6 +650,7 @@ public:
 #endif
   //====== Motion search ========
   Void      setDisableIntraPUsInInterSlices ( Bool  b )      { m_bDisableIntraPUsInInterSlices = b; }
+  Void      setBgSkipIntra                  ( Bool  b )      { m_bgSkipIntra = b; }
   Void      setMotionEstimationSearchMethod ( MESearchMethod e ) { m_motionEstimationSearchMethod = e; }
   Void      setSearchRange                  ( Int   i )      { m_iSearchRange = i; }
   Void      setBipredSearchRange            ( Int   i )      { m_bipredSearchRange = i; }
@@ -644,6 +658,7 @@ public:
   Void      setFastMEAssumingSmootherMVEnabled ( Bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   Void      setMinSearchWindow              ( Int   i )      { m_minSearchWindow = i; }
   Void      setRestrictMESampling           ( Bool  b )      { m_bRestrictMESampling = b; }
+  Void      setUseHierarchicalME            ( Bool  b )      { m_useHierarchicalME = b; }
 
   //====== Quality control ========
   Void      setMaxDeltaQP                   ( Int   i )      { m_iMaxDeltaQP = i; }
@@ -753,12 +768,14 @@ public:
 
   //==== Motion search ========
   Bool      getDisableIntraPUsInInterSlices    () const { return m_bDisableIntraPUsInInterSlices; }
+  Bool      getBgSkipIntra                     () const { return m_bgSkipIntra; }
   MESearchMethod getMotionEstimationSearchMethod ( ) const { return m_motionEstimationSearchMethod; }
   Int       getSearchRange                     () const { return m_iSearchRange; }
   Bool      getClipForBiPredMeEnabled          () const { return m_bClipForBiPredMeEnabled; }
   Bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   Int       getMinSearchWindow                 () const { return m_minSearchWindow; }
   Bool      getRestrictMESampling              () const { return m_bRestrictMESampling; }
+  Bool      getUseHierarchicalME               () const { return m_useHierarchicalME; }
 
   //==== Quality control ========
   Int       getMaxDeltaQP                   () const { return m_iMaxDeltaQP; }
@@ -780,12 +797,15 @@ public:
 #if T0196_SELECTIVE_RDOQ
   Void      setUseSelectiveRDOQ             ( Bool b )      { m_useSelectiveRDOQ = b; }
 #endif
+  Void      setFastRDOQ                     ( Int   i )     { m_fastRDOQ = i; }
   Void      setRDpenalty                    ( UInt  u )     { m_rdPenalty  = u; }
   Void      setFastInterSearchMode          ( FastInterSearchMode m ) { m_fastInterSearchMode = m; }
   Void      setUseEarlyCU                   ( Bool  b )     { m_bUseEarlyCU = b; }
   Void      setUseFastDecisionForMerge      ( Bool  b )     { m_useFastDecisionForMerge = b; }
   Void      setUseCbfFastMode               ( Bool  b )     { m_bUseCbfFastMode = b; }
   Void      setUseEarlySkipDetection        ( Bool  b )     { m_useEarlySkipDetection = b; }
+  Void      setUseSpeedGovernor             ( Bool  b )     { m_useSpeedGovernor = b; }
+  Void      setSpeedGovernorFps             ( Double d )    { m_speedGovernorFps = d; }
   Void      setUseConstrainedIntraPred      ( Bool  b )     { m_bUseConstrainedIntraPred = b; }
   Void      setFastUDIUseMPMEnabled         ( Bool  b )     { m_bFastUDIUseMPMEnabled = b; }
   Void      setFastMEForGenBLowDelayEnabled ( Bool  b )     { m_bFastMEForGenBLowDelayEnabled = b; }
@@ -808,12 +828,15 @@ public:
 #if T0196_SELECTIVE_RDOQ
   Bool      getUseSelectiveRDOQ             ()      { return m_useSelectiveRDOQ; }
 #endif
+  Int       getFastRDOQ                     () const { return m_fastRDOQ; }
   Int       getRDpenalty                    ()      { return m_rdPenalty;  }
   FastInterSearchMode getFastInterSearchMode() const{ return m_fastInterSearchMode;  }
   Bool      getUseEarlyCU                   () const{ return m_bUseEarlyCU; }
   Bool      getUseFastDecisionForMerge      () const{ return m_useFastDecisionForMerge; }
   Bool      getUseCbfFastMode               () const{ return m_bUseCbfFastMode; }
   Bool      getUseEarlySkipDetection        () const{ return m_useEarlySkipDetection; }
+  Bool      getUseSpeedGovernor             () const{ return m_useSpeedGovernor; }
+  Double    getSpeedGovernorFps             () const{ return m_speedGovernorFps; }
   Bool      getUseConstrainedIntraPred      ()      { return m_bUseConstrainedIntraPred; }
   Bool      getFastUDIUseMPMEnabled         ()      { return m_bFastUDIUseMPMEnabled; }
   Bool      getFastMEForGenBLowDelayEnabled ()      { return m_bFastMEForGenBLowDelayEnabled; }
@@ -1215,6 +1238,8 @@ public:
 
   Void         setSummaryVerboseness(UInt v)                         { m_summaryVerboseness = v; }
   UInt         getSummaryVerboseness( ) const                        { return m_summaryVerboseness; }
+  Void         setCtuStatsFileName(const std::string &s)             { m_ctuStatsFileName = s; }
+  const std::string& getCtuStatsFileName() const                     { return m_ctuStatsFileName; }
   Void         setDecodeBitstream( int i, const std::string& s )     { m_decodeBitstreams[i] = s; }
   const std::string& getDecodeBitstream( int i )               const { return m_decodeBitstreams[i]; }
   bool         getForceDecodeBitstream1()                      const { return m_forceDecodeBitstream1; }
@@ -44,6 +44,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/Profiler.h"
 
 
 #include "CommonLib/dtrace_buffer.h"
@@ -210,6 +211,8 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
 #if BLOCK_SELECT
 void EncCu::compressCtuSel(CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[], vector<int>& BgSelect)
 {
+	PROF_SCOPE( P_CTU_LEVEL );
+
 	m_modeCtrl->initCTUEncoding(*cs.slice);
 
 #if ENABLE_SPLIT_PARALLELISM
@@ -290,6 +293,8 @@ void EncCu::compressCtuSel(CodingStructure& cs, const UnitArea& area, const unsi
 
 void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[] )
 {
+  PROF_SCOPE( P_CTU_LEVEL );
+
   m_modeCtrl->initCTUEncoding( *cs.slice );
 
 #if ENABLE_SPLIT_PARALLELISM
@@ -1056,6 +1061,8 @@ void EncCu::xCompressCUSel(CodingStructure *&tempCS, CodingStructure *&bestCS, P
 }
 void EncCu::xCheckModeSplitSel(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode, vector<int>& BgSelect)
 {
+	PROF_SCOPE( P_MODE_SPLIT );
+
 	const Int qp = encTestMode.qp;
 	const PPS &pps = *tempCS->pps;
 	const Slice &slice = *tempCS->slice;
@@ -1217,6 +1224,8 @@ void EncCu::xCheckModeSplitSel(CodingStructure *&tempCS, CodingStructure *&bestC
 
 void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  PROF_SCOPE( P_MODE_SPLIT );
+
   const Int qp                = encTestMode.qp;
   const PPS &pps              = *tempCS->pps;
   const Slice &slice          = *tempCS->slice;
@@ -1378,6 +1387,8 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
 
 void EncCu::xCheckRDCostIntra( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  PROF_SCOPE( P_MODE_INTRA );
+
   const PPS &pps              = *tempCS->pps;
   const CodingUnit *bestCU    = bestCS->getCU( partitioner.chType );
 
@@ -1653,6 +1664,8 @@ void EncCu::xFillPCMBuffer( CodingUnit &cu )
 
 void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  PROF_SCOPE( P_MODE_MERGE );
+
   const Slice &slice = *tempCS->slice;
 
   CHECK( slice.getSliceType() == I_SLICE, "Merge modes not available for I-slices" );
@@ -1878,6 +1891,8 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
 #if BLOCK_SELECT
 void EncCu::xCheckRDCostInterSel(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode, vector<int>& BgSelect)
 {
+	PROF_SCOPE( P_MODE_INTER );
+
 
 	tempCS->initStructData(encTestMode.qp, encTestMode.lossless);
 
@@ -1909,6 +1924,8 @@ void EncCu::xCheckRDCostInterSel(CodingStructure *&tempCS, CodingStructure *&bes
 
 void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  PROF_SCOPE( P_MODE_INTER );
+
 	
   tempCS->initStructData( encTestMode.qp, encTestMode.lossless );
 
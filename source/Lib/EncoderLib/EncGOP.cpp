@@ -54,12 +54,13 @@
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/Profiler.h"
 
 #include "DecoderLib/DecLib.h"
 
 #define ENCODE_SUB_SET 0
 
-#if PRINT_UPDATEBG_RESI || PRINT_UPDATE_TRCOEFF || PRINT_OrgDIFF
+#if PRINT_UPDATEBG_RESI || PRINT_UPDATE_TRCOEFF
 #include <fstream>
 #endif
 #if GENERATE_BG_PIC
@@ -116,11 +117,13 @@ EncGOP::EncGOP()
 #endif
 
   m_bInitAMaxBT         = true;
+
+  m_metricsPic          = NULL;
 }
 
 EncGOP::~EncGOP()
 {
-  if( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() )
+  if( m_pcCfg && ( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() ) )
   {
     // reset potential decoder resources
     tryDecodePicture( NULL, 0, std::string("") );
@@ -137,6 +140,12 @@ Void  EncGOP::create()
 
 Void  EncGOP::destroy()
 {
+  if( m_metricsThread.joinable() )
+  {
+    m_metricsThread.join();
+  }
+  m_metricsPic = NULL;
+
 #if W0038_DB_OPT
   if (m_pcDeblockingTempPicYuv)
   {
@@ -162,10 +171,6 @@ Void EncGOP::init ( EncLib* pcEncLib )
   m_totalCoded         = 0;
 
   m_AUWriterIf = pcEncLib->getAUWriterIf();
-  
-#if WCG_EXT
-  pcEncLib->getRdCost()->initLumaLevelToWeightTable();
-#endif
 }
 
 #if HEVC_VPS
@@ -1180,7 +1185,7 @@ void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Pict
   // check if we should decode a leading bitstream
   if( !cfg.getDecodeBitstream( 0 ).empty() )
   {
-    static bool bDecode1stPart = true; /* TODO: MT */
+    static thread_local bool bDecode1stPart = true;
     if( bDecode1stPart )
     {
       if( cfg.getForceDecodeBitstream1() )
@@ -1264,7 +1269,7 @@ void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Pict
   }
 
   // this is the forward to poc section
-  static bool bHitFastForwardPOC = false; /* TODO: MT */
+  static thread_local bool bHitFastForwardPOC = false;
   if( bHitFastForwardPOC || isPicEncoded( cfg.getFastForwardToPOC(), pcPic->getPOC(), pcPic->layer, cfg.getGOPSize(), cfg.getIntraPeriod() ) )
   {
     bHitFastForwardPOC |= cfg.getFastForwardToPOC() == pcPic->getPOC(); // once we hit the poc we continue encoding
@@ -1287,11 +1292,7 @@ void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Pict
 
 
 #if HIERARCHY_GENETATE_OrgBGP
-Void EncGOP::CompDiffOrg(Int uiWidth, Int uiHeight, Picture* pcPic, /*double& diff,*/ Int lev, Bool divflag
-#if PRINT_OrgDIFF
-	, ofstream &os
-#endif
-)
+Void EncGOP::CompDiffOrg(Int uiWidth, Int uiHeight, Picture* pcPic, /*double& diff,*/ Int lev, Bool divflag)
 {
 
 	Int uiPartitionNum = 1;
@@ -1332,17 +1333,6 @@ Void EncGOP::CompDiffOrg(Int uiWidth, Int uiHeight, Picture* pcPic, /*double& di
 			Th = 7;
 		}*/
 
-#if PRINT_OrgDIFF
-		if (level == 0)
-		{
-			if (os.is_open())
-			{
-				if (uiW % 128 == 0 && uiW != 0)
-					os << endl;
-				os << setiosflags(ios::right) << setw(5) << diff;
-			}
-		}
-#endif
 
 		switch (level)
 		{
@@ -1389,11 +1379,7 @@ Void EncGOP::CompDiffOrg(Int uiWidth, Int uiHeight, Picture* pcPic, /*double& di
 				divflag = true;
 				level += 1;
 
-				CompDiffOrg(uiW, uiH, pcPic, level, divflag
-#if PRINT_OrgDIFF
-					, os
-#endif
-				);
+				CompDiffOrg(uiW, uiH, pcPic, level, divflag);
 
 			}
 			else
@@ -1443,11 +1429,7 @@ Void EncGOP::CompDiffOrg(Int uiWidth, Int uiHeight, Picture* pcPic, /*double& di
 				divflag = true;
 				level += 1;
 
-				CompDiffOrg(uiW, uiH, pcPic, level, divflag
-#if PRINT_OrgDIFF
-					, os
-#endif
-				);
+				CompDiffOrg(uiW, uiH, pcPic, level, divflag);
 
 			}
 			else
@@ -1495,11 +1477,7 @@ Void EncGOP::CompDiffOrg(Int uiWidth, Int uiHeight, Picture* pcPic, /*double& di
 				divflag = true;
 				level += 1;
 
-				CompDiffOrg(uiW, uiH, pcPic, level, divflag
-#if PRINT_OrgDIFF
-					, os
-#endif
-				);
+				CompDiffOrg(uiW, uiH, pcPic, level, divflag);
 
 			}
 			else
@@ -2638,6 +2616,8 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
                           std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                           Bool isField, Bool isTff, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE )
 {
+  PROF_SCOPE( P_GOP_LEVEL );
+
   // TODO: Split this function up.
 #if GENERATE_OrgBG_PIC
 	Picture* bg_NewPicYuvOrgSli = getbgNewPicYuvOrgGop();
@@ -2677,6 +2657,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
   {
+    PROF_SCOPE( P_PIC_LEVEL );
 
 #if OrgBG_BLOCK_SUBSTITUTION
 	  m_pcNablaY = NULL;
@@ -2743,7 +2724,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     // th this is a hot fix for the choma qp control
     if( m_pcEncLib->getWCGChromaQPControl().isEnabled() && m_pcEncLib->getSwitchPOC() != -1 )
     {
-      static int usePPS = 0; /* TODO: MT */
+      static thread_local int usePPS = 0;
       if( pocCurr == m_pcEncLib->getSwitchPOC() )
       {
         usePPS = 1;
@@ -3067,6 +3048,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 		cout << "add Rec:" << endl;
 		pcSlice->setRefPicListaddbgBlockRec(rcListPic, m_bgNewBlocksOrgGop, m_rcPicYuvTempGop, SetRefPoc, BgBlock);
 	}*/
+	m_pcSliceEncoder->setBgCtuState( SetRefPoc != -999 ? pcSlice->getPOC() + SetRefPoc : MAX_INT, BgBlock, BgCTU );
 #else
 	pcSlice->setRefPicList(rcListPic);
 #endif // BG_REFERENCE_SUBSTITUTION
@@ -3209,7 +3191,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     }
 
     // set adaptive search range for non-intra-slices
-    if (m_pcCfg->getUseASR() && pcSlice->getSliceType()!=I_SLICE)
+    if ((m_pcCfg->getUseASR() || m_pcEncLib->getSpeedGovernor()->isEnabled()) && pcSlice->getSliceType()!=I_SLICE)
     {
       m_pcSliceEncoder->setSearchRange(pcSlice);
     }
@@ -3400,32 +3382,19 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
 			const Int  iWidth = pcPic->getOrigBuf().Y().width;
 			const Int  iHeight = pcPic->getOrigBuf().Y().height;
-#if PRINT_OrgDIFF
-			ofstream os("test.txt", ofstream::app);
-#endif
 			for (Int i = 0; i < iHeight; i += UNIT_LEN)
 			{
 				for (Int j = 0; j < iWidth; j += UNIT_LEN)
 				{
 					Int level = 0; //ּ
 					Bool divflag = false; //Ƿٷ
-					CompDiffOrg(j, i, pcPic, level, divflag
-#if PRINT_OrgDIFF
-						, os
-#endif
-					);
+					CompDiffOrg(j, i, pcPic, level, divflag);
 
 
 				}
-#if PRINT_OrgDIFF
-				os << endl;
-#endif
 			}
 
 
-#if PRINT_OrgDIFF
-			os.close();
-#endif
 #if israndom
 		}
 #endif // israndom
@@ -4711,6 +4680,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 	Int maxencodenum = numsx*numsy / 12;
 	Int num = 0;
 	Int num_block = 0;
+	PROF_START( P_BG_IMPORTANCE_MAP );
 	for (Int i = 0; i < pcPic->getOrigBuf().Y().height; i += BLOCK_GEN_LEN)
 	{
 		for (Int j = 0; j < pcPic->getOrigBuf().Y().width; j += BLOCK_GEN_LEN)
@@ -4729,6 +4699,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 			num_block++;
 		}
 	}
+	PROF_STOP( P_BG_IMPORTANCE_MAP );
 	if (num > maxencodenum / 4) //СΪ/4
 	{
 		isoktoen = true;
@@ -4739,12 +4710,10 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 			//cout << Bgselect[i] << "-";
 		}
 	}
-	double minwd = Bgselect[maxencodenum];
-	cout <<endl<< isoktoen<<" "<<minwd <<"  "<<maxencodenum<<"  "<<num<< endl;
+	double minwd = Bgselect[m_pcEncLib->getSpeedGovernor()->getBgBlockBudget( maxencodenum )];
 	
 	if (pcPic->getPOC()==1000)
 	{
-		cout << "===" << endl;
 		//pcPic->DeleteOrg(pcPic);
 		//pcPic->DeleteReco(pcPic);
 		//pcPic->CopyOrg(m_bgNewPicYuvOrgGop, pcPic);
@@ -4755,7 +4724,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 		{
 			for (Int j = 0; j < pcPic->getOrigBuf().Y().width; j += BLOCK_GEN_LEN)
 			{
-				cout << Bgselect1[num_block] << " ";
 				/*if (BgBlock[num_block] > 2000)// && BgBlock[num_block] < 2000 && Bgselect1[num_block]>minwd)
 				{
 					num++;
@@ -4766,7 +4734,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 				num_block++;
 			}
 		}
-		cout << num << "num" << endl;
 	}
 
 
@@ -4779,7 +4746,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 	{
 		
 #if ifif
-		cout << pcPic->getPOC() << "---------------------------------------" << endl;
 		//pcSlice->setRefPicListaddRecbg(rcListPic, m_bgNewPicYuvRecGop, m_rcPicYuvTempGop,j);//Recο֡ԤOrg
 		/*pcSlice->setRefPicListaddbgBlockRec(rcListPic, m_bgNewPicYuvRecGop, m_bgNewBlockRecoGop, SetRefPoc, BgBlock);
 		pcSlice->setRefPOCList();
@@ -4835,7 +4801,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 				num_block++;
 			}
 		}
-		cout << "" << numMax << endl;
 		//if (numMax < 100)
 			//isencode = false;
 
@@ -4863,6 +4828,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 		{
 			DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", pocCurr)));
 
+			m_pcSliceEncoder->resetPicAnalysis();
 			pcSlice->setSliceCurStartCtuTsAddr(0);
 #if HEVC_DEPENDENT_SLICES
 			pcSlice->setSliceSegmentCurStartCtuTsAddr(0);
@@ -4897,7 +4863,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 			pcSlice = pcPic->slices[0];
 
 			// SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
-			if (pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary())
+			if (pcSlice->getSPS()->getUseSAO() && m_pcEncLib->getSpeedGovernor()->getUseSAO() && m_pcCfg->getSaoCtuBoundary())
 			{
 				m_pcSAO->getPreDBFStatistics(cs);
 			}
@@ -4919,15 +4885,19 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 #endif
 			}
 
+			PROF_START( P_LOOP_FILTER );
 			m_pcLoopFilter->loopFilterPic(cs);
+			PROF_STOP( P_LOOP_FILTER );
 
 			DTRACE_UPDATE(g_trace_ctx, (std::make_pair("final", 1)));
 
-			if (pcSlice->getSPS()->getUseSAO())
+			if (pcSlice->getSPS()->getUseSAO() && m_pcEncLib->getSpeedGovernor()->getUseSAO())
 			{
 				Bool sliceEnabled[MAX_NUM_COMPONENT];
 				m_pcSAO->initCABACEstimator(m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice);
+				PROF_START( P_SAO );
 				m_pcSAO->SAOProcess(cs, sliceEnabled, pcSlice->getLambdas(), m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoCtuBoundary());
+				PROF_STOP( P_SAO );
 				//assign SAO slice header
 				for (Int s = 0; s< uiNumSliceSegments; s++)
 				{
@@ -4936,6 +4906,15 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 					pcPic->slices[s]->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
 				}
 			}
+			else if (pcSlice->getSPS()->getUseSAO())
+			{
+				// SAO estimation skipped by the speed governor
+				for (Int s = 0; s < uiNumSliceSegments; s++)
+				{
+					pcPic->slices[s]->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, false);
+					pcPic->slices[s]->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, false);
+				}
+			}
 
 		}
 		else // skip enc picture
@@ -5039,6 +5018,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 				pcSlice->clearSubstreamSizes();
 				{
 					UInt numBinsCoded = 0;
+					PROF_SCOPE( P_ENTROPY_CODING );
 					m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
 					binCountsInNalUnits += numBinsCoded;
 				}
@@ -5275,6 +5255,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
 		DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", pocCurr)));
 
+		m_pcSliceEncoder->resetPicAnalysis();
 		pcSlice->setSliceCurStartCtuTsAddr(0);
 #if HEVC_DEPENDENT_SLICES
 		pcSlice->setSliceSegmentCurStartCtuTsAddr(0);
@@ -5715,7 +5696,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       pcSlice = pcPic->slices[0];
 
       // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
-      if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
+      if( pcSlice->getSPS()->getUseSAO() && m_pcEncLib->getSpeedGovernor()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
       {
         m_pcSAO->getPreDBFStatistics( cs );
       }
@@ -5736,14 +5717,18 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
   #endif
       }
 
+      PROF_START( P_LOOP_FILTER );
       m_pcLoopFilter->loopFilterPic( cs );
+      PROF_STOP( P_LOOP_FILTER );
       DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 1 ) ) );
 
-      if( pcSlice->getSPS()->getUseSAO() )
+      if( pcSlice->getSPS()->getUseSAO() && m_pcEncLib->getSpeedGovernor()->getUseSAO() )
       {
         Bool sliceEnabled[MAX_NUM_COMPONENT];
         m_pcSAO->initCABACEstimator( m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice );
+        PROF_START( P_SAO );
         m_pcSAO->SAOProcess(cs, sliceEnabled, pcSlice->getLambdas(), m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoCtuBoundary());
+        PROF_STOP( P_SAO );
         //assign SAO slice header
         for(Int s=0; s< uiNumSliceSegments; s++)
         {
@@ -5752,6 +5737,15 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
           pcPic->slices[s]->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
         }
       }
+      else if( pcSlice->getSPS()->getUseSAO() )
+      {
+        // SAO estimation skipped by the speed governor
+        for( Int s = 0; s < uiNumSliceSegments; s++ )
+        {
+          pcPic->slices[s]->setSaoEnabledFlag( CHANNEL_TYPE_LUMA,   false );
+          pcPic->slices[s]->setSaoEnabledFlag( CHANNEL_TYPE_CHROMA, false );
+        }
+      }
     }
     else // skip enc picture
     {
@@ -5775,6 +5769,12 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
     }
     if( encPic || decPic )
     {
+      if( m_pcCfg->getAsyncMetrics() )
+      {
+        // the reconstruction is final, its distortion is computed while the picture is written
+        xStartPictureMetrics( pcPic );
+      }
+
       pcSlice = pcPic->slices[0];
 
       /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
@@ -5911,6 +5911,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 #if HIERARCHY_GENETATE_OrgBGP
 		if (pcPic->getPOC() != 0)  
 		{
+			PROF_SCOPE( P_BG_DIFF );
 
 #if israndom  //32ʱûвο֡
 			if (pcPic->getPOC() % 32 != 0)
@@ -5919,32 +5920,19 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
 				const Int  iWidth = pcPic->getOrigBuf().Y().width;
 				const Int  iHeight = pcPic->getOrigBuf().Y().height;
-#if PRINT_OrgDIFF
-				ofstream os("test.txt", ofstream::app);
-#endif
 				for (Int i = 0; i < iHeight; i += UNIT_LEN)
 				{
 					for (Int j = 0; j < iWidth; j += UNIT_LEN)
 					{
 						Int level = 0; //ּ
 						Bool divflag = false; //Ƿٷ
-						CompDiffOrg(j, i, pcPic, level, divflag
-#if PRINT_OrgDIFF
-							, os
-#endif
-						);
+						CompDiffOrg(j, i, pcPic, level, divflag);
 
 
 					}
-#if PRINT_OrgDIFF
-					os << endl;
-#endif
 				}
 				
 
-#if PRINT_OrgDIFF
-				os.close();
-#endif
 #if israndom
 			}
 #endif // israndom
@@ -6126,6 +6114,8 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 
 		if (pcPic->getPOC() > 5 && pcPic->getPOC() < 300)
 		{
+			PROF_SCOPE( P_BG_BLOCK_GEN );
+
 			int num_block = 0;
 			for (UInt uiH = 0; uiH < pcPic->getOrigBuf().Y().height; uiH += BLOCK_GEN_LEN)
 			{
@@ -6138,7 +6128,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 						//pcPic->CompBlockDiff(uiW, uiH, pcPic, diff);  //get  block diff
 						pcPic->CompBlockPicOrgDiff(uiW, uiH, pcPic, m_bgNewPicYuvOrgGop, diff);//жϱ֡뵱ǰ֡õ
 						//pcPic->CompBlockPicRecoDiff(uiW, uiH, pcPic, m_bgNewPicYuvRecGop, diff);//RecPicRecdiff
-						cout << "diff" << diff;
 						if (diff < 8)//if(pcPic->CompBlockOrgIsFull(uiW, uiH, m_bgNewPicYuvOrgGop))//жϱ֡ÿǷ
 						{
 							BgBlock[num_block]++;
@@ -6197,30 +6186,6 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 				}
 			}
 			//BgBlock[num_block] = -1;
-			cout << "num_block" << num_block << endl;
-
-			{ // cout
-				Int i = 0;
-				Int j = 0;
-				//ofstream bgBlock;
-				//bgBlock.open("D://2//BgBlock32_5_850.txt", ios::app);
-				//bgBlock << pcPic->getPOC()<<" ";
-				cout << endl;
-				while (i < num_block)
-				{
-					cout << BgBlock[i] << " ";// << BlockDPP[i] << " ";
-										  //bgBlock << BgBlock[i] <<" ";					
-					if (BgBlock[i] > 0)
-					{
-						j++;
-					}
-					i++;
-				}
-				//bgBlock << endl;
-				//bgBlock <<" j "<< j << endl;
-				cout << endl;
-				cout << " ɵı " << j << endl;
-			}
 
 		}
 		
@@ -6839,6 +6804,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
         pcSlice->clearSubstreamSizes(  );
         {
           UInt numBinsCoded = 0;
+          PROF_SCOPE( P_ENTROPY_CODING );
           m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
           binCountsInNalUnits+=numBinsCoded;
         }
@@ -6912,6 +6878,10 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       //-- For time output for each slice
       auto elapsed = std::chrono::steady_clock::now() - beforeTime;
       auto encTime = std::chrono::duration_cast<std::chrono::seconds>( elapsed ).count();
+      if( m_pcEncLib->getSpeedGovernor()->isEnabled() )
+      {
+        m_pcEncLib->getSpeedGovernor()->addPicture( std::chrono::duration<Double>( elapsed ).count() );
+      }
 
       std::string digestStr;
       if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
@@ -7266,6 +7236,35 @@ static inline double calcWeightedSquaredError(const CPelBuf& org,    const CPelB
 }
 #endif // ENABLE_QPA
 
+static UInt64 getPlaneSSD( const CPelBuf& pic0, const CPelBuf& pic1 )
+{
+  const  Pel*  pSrc0 = pic0.bufAt(0, 0);
+  const  Pel*  pSrc1 = pic1.bufAt(0, 0);
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  const  Int   widthSimd   = pic0.width & ~7;
+  UInt64       uiTotalDiff = widthSimd > 0 ? g_pelBufOP.ssd8( pSrc0, pic0.stride, pSrc1, pic1.stride, widthSimd, pic0.height ) : 0;
+#else
+  const  Int   widthSimd   = 0;
+  UInt64       uiTotalDiff = 0;
+#endif
+
+  if( widthSimd < pic0.width )
+  {
+    for (Int y = 0; y < pic0.height; y++)
+    {
+      for (Int x = widthSimd; x < pic0.width; x++)
+      {
+        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
+        uiTotalDiff += UInt64(iTemp * iTemp);
+      }
+      pSrc0 += pic0.stride;
+      pSrc1 += pic1.stride;
+    }
+  }
+
+  return uiTotalDiff;
+}
+
 UInt64 EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const UInt rshift
 #if ENABLE_QPA
                                   , const UInt chromaShift /*= 0*/
@@ -7294,18 +7293,7 @@ UInt64 EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, co
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        uiTotalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            register Int64 iDiff = (Int64)pSrc0[x] - (Int64)pSrc1[x];
-            uiTotalDiff += UInt64(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return uiTotalDiff;
+        return getPlaneSSD( pic0, pic1 );
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -7350,17 +7338,7 @@ UInt64 EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, co
   }
   else
   {
-    uiTotalDiff = 0;
-    for (Int y = 0; y < pic0.height; y++)
-    {
-      for (Int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += UInt64(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    uiTotalDiff = getPlaneSSD( pic0, pic1 );
   }
 
   return uiTotalDiff;
@@ -7419,6 +7397,71 @@ Double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
 }
 #endif
 
+Void EncGOP::xFindDistortionPicture( const Picture* pcPic, const CPelUnitBuf& cPicD, UInt64* uiSSD, Double* uiSSDWeighted )
+{
+  const SPS&         sps     = *pcPic->cs->sps;
+  const CPelUnitBuf& org     = pcPic->getOrigBuf();
+  const ChromaFormat formatD = cPicD.chromaFormat;
+  const ChromaFormat format  = sps.getChromaFormatIdc();
+#if ENABLE_QPA
+  const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
+#endif
+
+  for (Int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf&    p = cPicD.get(compID);
+    const CPelBuf&    o = org.get(compID);
+
+    CHECK(!( p.width  == o.width), "Unspecified error");
+    CHECK(!( p.height == o.height), "Unspecified error");
+
+    const UInt   width  = p.width  - (m_pcEncLib->getPad(0) >> ::getComponentScaleX(compID, format));
+    const UInt   height = p.height - (m_pcEncLib->getPad(1) >> (!!pcPic->fieldPic+::getComponentScaleY(compID,format)));
+
+    // create new buffers with correct dimensions
+    const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
+    const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
+#if ENABLE_QPA
+    uiSSD[comp] = xFindDistortionPlane(recPB, orgPB, useWPSNR ? sps.getBitDepth(toChannelType(compID)) : 0, ::getComponentScaleX(compID, format));
+#else
+    uiSSD[comp] = xFindDistortionPlane(recPB, orgPB, 0);
+#endif
+#if WCG_WPSNR
+    uiSSDWeighted[comp] = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
+#endif
+  }
+}
+
+Void EncGOP::xStartPictureMetrics( const Picture* pcPic )
+{
+  xFinishPictureMetrics( NULL );
+
+  m_metricsPic    = pcPic;
+  m_metricsThread = std::thread( [this, pcPic]
+  {
+#if WCG_WPSNR
+    xFindDistortionPicture( pcPic, pcPic->getRecoBuf(), m_metricsSSD, m_metricsSSDWeighted );
+#else
+    xFindDistortionPicture( pcPic, pcPic->getRecoBuf(), m_metricsSSD, NULL );
+#endif
+  } );
+}
+
+Bool EncGOP::xFinishPictureMetrics( const Picture* pcPic )
+{
+  if( !m_metricsThread.joinable() )
+  {
+    return false;
+  }
+
+  m_metricsThread.join();
+
+  const Bool isPic = m_metricsPic == pcPic;
+  m_metricsPic = NULL;
+  return isPic;
+}
+
 Void EncGOP::xCalculateAddPSNRs( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, Picture* pcPic, const AccessUnit&accessUnit, PicList &rcListPic, const int64_t dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, Double* PSNR_Y )
 {
   xCalculateAddPSNR( pcPic, pcPic->getRecoBuf(), accessUnit, (double) dEncTime, snr_conversion, printFrameMSE, PSNR_Y );
@@ -7528,6 +7571,20 @@ Void EncGOP::xCalculateAddPSNR( Picture* pcPic, PelUnitBuf cPicD, const AccessUn
 
   const bool bPicIsField     = pcPic->fieldPic;
   const Slice*  pcSlice      = pcPic->slices[0];
+
+  UInt64 uiSSD        [MAX_NUM_COMPONENT];
+  Double uiSSDWeighted[MAX_NUM_COMPONENT];
+  if( xFinishPictureMetrics( pcPic ) )
+  {
+    std::copy( m_metricsSSD, m_metricsSSD + MAX_NUM_COMPONENT, uiSSD );
+#if WCG_WPSNR
+    std::copy( m_metricsSSDWeighted, m_metricsSSDWeighted + MAX_NUM_COMPONENT, uiSSDWeighted );
+#endif
+  }
+  else
+  {
+    xFindDistortionPicture( pcPic, picC, uiSSD, uiSSDWeighted );
+  }
 #if ENABLE_QPA && FRAME_WEIGHTING
   const UInt    currDQP      = (pcSlice->getPOC() % m_pcEncLib->getIntraPeriod()) == 0 ? 0 : DQP[pcSlice->getPOC() % m_pcEncLib->getGOPSize()];
   const double  frameWeight  = pow(2.0, (double)currDQP / -3.0);
@@ -7546,18 +7603,14 @@ Void EncGOP::xCalculateAddPSNR( Picture* pcPic, PelUnitBuf cPicD, const AccessUn
     const UInt   width  = p.width  - (m_pcEncLib->getPad(0) >> ::getComponentScaleX(compID, format));
     const UInt   height = p.height - (m_pcEncLib->getPad(1) >> (!!bPicIsField+::getComponentScaleY(compID,format)));
 
-    // create new buffers with correct dimensions
-    const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
-    const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
     const UInt    bitDepth = sps.getBitDepth(toChannelType(compID));
+    const UInt64 uiSSDtemp = uiSSD[comp];
+#if WCG_WPSNR
+    const Double uiSSDtempWeighted = uiSSDWeighted[comp];
+#endif
 #if ENABLE_QPA
-    const UInt64 uiSSDtemp = xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format));
     const UInt maxval = /*useWPSNR ? (1 << bitDepth) - 1 :*/ 255 << (bitDepth - 8); // fix with WPSNR: 1023 (4095) instead of 1020 (4080) for bit-depth 10 (12)
 #else
-    const UInt64 uiSSDtemp = xFindDistortionPlane(recPB, orgPB, 0);
-#if WCG_WPSNR
-  const Double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
-#endif
     const UInt maxval = 255 << (bitDepth - 8);
 #endif
     const UInt size   = width * height;
@@ -7662,6 +7715,18 @@ Void EncGOP::xCalculateAddPSNR( Picture* pcPic, PelUnitBuf cPicD, const AccessUn
     }
 #endif
     msg( NOTICE, " [ET %5.0f ]", dEncTime );
+    if( m_pcEncLib->getSpeedGovernor()->isEnabled() )
+    {
+      const SpeedGovernor* governor = m_pcEncLib->getSpeedGovernor();
+      if( governor->getLevel() != governor->getPictureLevel() )
+      {
+        msg( NOTICE, " [SG %d->%d load %3.0f%%]", governor->getPictureLevel(), governor->getLevel(), governor->getLoad() * 100 );
+      }
+      else
+      {
+        msg( NOTICE, " [SG %d load %3.0f%%]", governor->getLevel(), governor->getLoad() * 100 );
+      }
+    }
 
     // msg( SOME, " [WP %d]", pcSlice->getUseWeightedPrediction());
 
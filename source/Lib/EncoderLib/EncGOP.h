@@ -39,6 +39,7 @@
 #define __ENCGOP__
 
 #include <list>
+#include <thread>
 
 #include <stdlib.h>
 
@@ -232,6 +233,14 @@ private:
 
   AUWriterIf*             m_AUWriterIf;
 
+  // distortion of a finalised picture, computed on a worker thread with AsyncMetrics
+  std::thread             m_metricsThread;
+  const Picture*          m_metricsPic;
+  UInt64                  m_metricsSSD[MAX_NUM_COMPONENT];
+#if WCG_WPSNR
+  Double                  m_metricsSSDWeighted[MAX_NUM_COMPONENT];
+#endif
+
 public:
   EncGOP();
   virtual ~EncGOP();
@@ -318,11 +327,7 @@ public:
 #endif
 
 #if HIERARCHY_GENETATE_OrgBGP
-  Void CompDiffOrg(Int uiW, Int uiH, Picture* pcPic, Int level, Bool divflag
-#if PRINT_OrgDIFF
-	  , ofstream &ocout
-#endif
-  );
+  Void CompDiffOrg(Int uiW, Int uiH, Picture* pcPic, Int level, Bool divflag);
 #endif
 
 #if OrgBG_BLOCK_SUBSTITUTION
@@ -369,6 +374,10 @@ protected:
                                      PelUnitBuf cPicRecFirstField, PelUnitBuf cPicRecSecondField,
                                      const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, Double* PSNR_Y );
 
+  Void  xFindDistortionPicture     ( const Picture* pcPic, const CPelUnitBuf& cPicD, UInt64* uiSSD, Double* uiSSDWeighted );
+  Void  xStartPictureMetrics       ( const Picture* pcPic );                           ///< compute the distortion of the reconstruction on the metrics thread
+  Bool  xFinishPictureMetrics      ( const Picture* pcPic );                           ///< wait for the metrics thread, true if its results belong to pcPic
+
   UInt64 xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const UInt rshift
 #if ENABLE_QPA
                             , const UInt chromaShift = 0
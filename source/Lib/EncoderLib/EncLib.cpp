@@ -150,6 +150,8 @@ Void EncLib::destroy ()
   m_cEncSAO.            destroy();
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
+  m_cHierarchicalME.    destroy();
+  m_cGradientAnalysis.  destroy();
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
@@ -257,6 +259,7 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
                           m_useTransformSkipFast
                           , m_QTBT
     );
+    m_cTrQuant[jId].getQuant()->setFastRDOQ( m_fastRDOQ );
 
     // initialize encoder search class
     CABACWriter* cabacEstimator = m_CABACEncoder[jId].getCABACEstimator( &sps0 );
@@ -274,6 +277,8 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
 
     // link temporary buffets from intra search with inter search to avoid unnecessary memory overhead
     m_cInterSearch[jId].setTempBuffers( m_cIntraSearch[jId].getSplitCSBuf(), m_cIntraSearch[jId].getFullCSBuf(), m_cIntraSearch[jId].getSaveCSBuf() );
+    m_cInterSearch[jId].setHierarchicalME( m_useHierarchicalME ? &m_cHierarchicalME : nullptr );
+    m_cIntraSearch[jId].setGradientAnalysis( m_useFastIntraGradient ? &m_cGradientAnalysis : nullptr );
   }
 #else  // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_cCuEncoder.   init( this, sps0 );
@@ -290,6 +295,7 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
                    m_useTransformSkipFast
                    , m_QTBT
   );
+  m_cTrQuant.getQuant()->setFastRDOQ( m_fastRDOQ );
 
   // initialize encoder search class
   CABACWriter* cabacEstimator = m_CABACEncoder.getCABACEstimator(&sps0);
@@ -307,10 +313,15 @@ Void EncLib::init( Bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
+  m_cInterSearch.setHierarchicalME( m_useHierarchicalME ? &m_cHierarchicalME : nullptr );
+  m_cIntraSearch.setGradientAnalysis( m_useFastIntraGradient ? &m_cGradientAnalysis : nullptr );
 #endif // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
   m_iMaxRefPicNum = 0;
 
+  m_cSpeedGovernor.init( this );
+  m_cHierarchicalME.init( this, getRdCost() );
+
 #if HEVC_USE_SCALING_LISTS
 #if ER_CHROMA_QP_WCG_PPS
   if( m_wcgChromaQpControl.isEnabled() )
@@ -454,7 +465,6 @@ Void EncLib::deletePicBuffer()
 Void EncLib::encode( Bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTrueOrg, const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                      Int& iNumEncoded )
 {
-  //PROF_ACCUM_AND_START_NEW_SET( getProfilerPic(), P_GOP_LEVEL );
   if (pcPicYuvOrg != NULL)
   {
     // get original YUV
@@ -1663,7 +1673,7 @@ Int EncCfg::getQPForPicture(const UInt gopIndex, const Slice *pSlice
     qp = getBaseQP();
 
     // switch at specific qp and keep this qp offset
-    static int appliedSwitchDQQ = 0; /* TODO: MT */
+    static thread_local int appliedSwitchDQQ = 0;
     if( pSlice->getPOC() == getSwitchPOC() )
     {
       appliedSwitchDQQ = getSwitchDQP();
@@ -54,6 +54,9 @@
 #include "IntraSearch.h"
 #include "EncSampleAdaptiveOffset.h"
 #include "RateCtrl.h"
+#include "SpeedGovernor.h"
+#include "HierarchicalME.h"
+#include "GradientAnalysis.h"
 
 
 //! \ingroup EncoderLib
@@ -157,6 +160,9 @@ private:
 #endif
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
+  SpeedGovernor             m_cSpeedGovernor;                     ///< run-time effort control
+  HierarchicalME            m_cHierarchicalME;                    ///< coarse motion field for the integer motion search
+  GradientAnalysis          m_cGradientAnalysis;                  ///< gradient directions for the intra mode pre-selection
 
   AUWriterIf*               m_AUWriterIf;
 
@@ -292,6 +298,9 @@ public:
   CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
 #endif
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+  SpeedGovernor*          getSpeedGovernor      ()              { return  &m_cSpeedGovernor;       }
+  HierarchicalME*         getHierarchicalME     ()              { return  &m_cHierarchicalME;      }
+  GradientAnalysis*       getGradientAnalysis   ()              { return  &m_cGradientAnalysis;    }
 
   Void selectReferencePictureSet(Slice* slice, Int POCCurr, Int GOPid );
   Int getReferencePictureSetIdxForSOP(Int POCCurr, Int GOPid );
@@ -55,6 +55,8 @@ Void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
   m_pcRateCtrl    = pRateCtrl;
   m_pcRdCost      = pRdCost;
   m_fastDeltaQP   = false;
+  m_mtDepthReduction = 0;
+  m_skipIntra        = false;
 #if SHARP_LUMA_DELTA_QP
   m_lumaQPOffset  = 0;
 
@@ -318,90 +320,55 @@ void CacheBlkInfoCtrl::create()
   m_numWidths  = gp_sizeIdxInfo->numWidths();
   m_numHeights = gp_sizeIdxInfo->numHeights();
 
+  m_blkIdxX = new int[numPos * m_numWidths];
+  m_blkIdxY = new int[numPos * m_numHeights];
+  m_numBlkX = 0;
+  m_numBlkY = 0;
+
   for( unsigned x = 0; x < numPos; x++ )
   {
-    for( unsigned y = 0; y < numPos; y++ )
+    for( int wIdx = 0; wIdx < m_numWidths; wIdx++ )
     {
-      m_codedCUInfo[x][y] = new CodedCUInfo**[m_numWidths];
-
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( wIdx ) ) && x + ( gp_sizeIdxInfo->sizeFrom( wIdx ) >> MIN_CU_LOG2 ) <= ( MAX_CU_SIZE >> MIN_CU_LOG2 ) )
-        {
-          m_codedCUInfo[x][y][wIdx] = new CodedCUInfo*[gp_sizeIdxInfo->numHeights()];
+      const unsigned width = gp_sizeIdxInfo->sizeFrom( wIdx );
 
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-          {
-            if( gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( hIdx ) ) && y + ( gp_sizeIdxInfo->sizeFrom( hIdx ) >> MIN_CU_LOG2 ) <= ( MAX_CU_SIZE >> MIN_CU_LOG2 ) )
-            {
-              m_codedCUInfo[x][y][wIdx][hIdx] = new CodedCUInfo;
-            }
-            else
-            {
-              m_codedCUInfo[x][y][wIdx][hIdx] = nullptr;
-            }
-          }
-        }
-        else
-        {
-          m_codedCUInfo[x][y][wIdx] = nullptr;
-        }
-      }
+      m_blkIdxX[x * m_numWidths + wIdx] = gp_sizeIdxInfo->isCuSize( width ) && x + ( width >> MIN_CU_LOG2 ) <= numPos ? m_numBlkX++ : -1;
     }
   }
-}
 
-void CacheBlkInfoCtrl::destroy()
-{
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
-
-  for( unsigned x = 0; x < numPos; x++ )
+  for( unsigned y = 0; y < numPos; y++ )
   {
-    for( unsigned y = 0; y < numPos; y++ )
+    for( int hIdx = 0; hIdx < m_numHeights; hIdx++ )
     {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_codedCUInfo[x][y][wIdx] )
-        {
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-          {
-            if( m_codedCUInfo[x][y][wIdx][hIdx] )
-            {
-              delete m_codedCUInfo[x][y][wIdx][hIdx];
-            }
-          }
+      const unsigned height = gp_sizeIdxInfo->sizeFrom( hIdx );
 
-          delete[] m_codedCUInfo[x][y][wIdx];
-        }
-      }
-
-      delete[] m_codedCUInfo[x][y];
+      m_blkIdxY[y * m_numHeights + hIdx] = gp_sizeIdxInfo->isCuSize( height ) && y + ( height >> MIN_CU_LOG2 ) <= numPos ? m_numBlkY++ : -1;
     }
   }
+
+  m_codedCUInfo = new CodedCUInfo[m_numBlkX * m_numBlkY];
+  memset( m_codedCUInfo, 0, m_numBlkX * m_numBlkY * sizeof( CodedCUInfo ) );
+
+  m_generation = 0;
 }
 
-void CacheBlkInfoCtrl::init( const Slice &slice )
+void CacheBlkInfoCtrl::destroy()
 {
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
+  delete[] m_codedCUInfo;
+  delete[] m_blkIdxX;
+  delete[] m_blkIdxY;
 
-  for( unsigned x = 0; x < numPos; x++ )
+  m_codedCUInfo = nullptr;
+  m_blkIdxX     = nullptr;
+  m_blkIdxY     = nullptr;
+}
+
+void CacheBlkInfoCtrl::init( const Slice &slice )
+{
+  // invalidate all entries at once instead of clearing them, stale entries are reset on first access
+  if( ++m_generation == 0 )
   {
-    for( unsigned y = 0; y < numPos; y++ )
-    {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_codedCUInfo[x][y][wIdx] )
-        {
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-          {
-            if( m_codedCUInfo[x][y][wIdx][hIdx] )
-            {
-              memset( m_codedCUInfo[x][y][wIdx][hIdx], 0, sizeof( CodedCUInfo ) );
-            }
-          }
-        }
-      }
-    }
+    memset( m_codedCUInfo, 0, m_numBlkX * m_numBlkY * sizeof( CodedCUInfo ) );
+    m_generation = 1;
   }
 
   m_slice_chblk = &slice;
@@ -410,6 +377,39 @@ void CacheBlkInfoCtrl::init( const Slice &slice )
   m_currTemporalId = 0;
 #endif
 }
+
+unsigned CacheBlkInfoCtrl::xGetBlkIdx( const UnitArea& area ) const
+{
+  unsigned idx1, idx2, idx3, idx4;
+  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+
+  const int blkIdxX = m_blkIdxX[idx1 * m_numWidths  + idx3];
+  const int blkIdxY = m_blkIdxY[idx2 * m_numHeights + idx4];
+
+  CHECK( blkIdxX < 0 || blkIdxY < 0, "Accessing block info outside of the CTU" );
+
+  return blkIdxX * m_numBlkY + blkIdxY;
+}
+
+CodedCUInfo& CacheBlkInfoCtrl::xGetBlkInfo( const unsigned blkIdx )
+{
+  CodedCUInfo& cuInfo = m_codedCUInfo[blkIdx];
+
+  if( cuInfo.generation != m_generation )
+  {
+    memset( &cuInfo, 0, sizeof( CodedCUInfo ) );
+    cuInfo.generation = m_generation;
+  }
+
+  return cuInfo;
+}
+
+const CodedCUInfo* CacheBlkInfoCtrl::xGetBlkInfoIfValid( const unsigned blkIdx ) const
+{
+  const CodedCUInfo& cuInfo = m_codedCUInfo[blkIdx];
+
+  return cuInfo.generation == m_generation ? &cuInfo : nullptr;
+}
 #if ENABLE_SPLIT_PARALLELISM
 
 void CacheBlkInfoCtrl::touch( const UnitArea& area )
@@ -437,27 +437,34 @@ void CacheBlkInfoCtrl::copyState( const CacheBlkInfoCtrl &other, const UnitArea&
   {
     for( unsigned y = minPosY; y <= maxPosY; y++ )
     {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
+      for( int wIdx = 0; wIdx < m_numWidths; wIdx++ )
       {
-        const int width = gp_sizeIdxInfo->sizeFrom( wIdx );
+        const int width   = gp_sizeIdxInfo->sizeFrom( wIdx );
+        const int blkIdxX = m_blkIdxX[x * m_numWidths + wIdx];
 
-        if( m_codedCUInfo[x][y][wIdx] && width <= area.lwidth() && x + ( width >> MIN_CU_LOG2 ) <= ( maxPosX + 1 ) )
+        if( blkIdxX >= 0 && width <= area.lwidth() && x + ( width >> MIN_CU_LOG2 ) <= ( maxPosX + 1 ) )
         {
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
+          for( int hIdx = 0; hIdx < m_numHeights; hIdx++ )
           {
-            const int height = gp_sizeIdxInfo->sizeFrom( hIdx );
+            const int height  = gp_sizeIdxInfo->sizeFrom( hIdx );
+            const int blkIdxY = m_blkIdxY[y * m_numHeights + hIdx];
 
-            if( gp_sizeIdxInfo->isCuSize( height ) && height <= area.lheight() && y + ( height >> MIN_CU_LOG2 ) <= ( maxPosY + 1 ) )
+            if( blkIdxY >= 0 && height <= area.lheight() && y + ( height >> MIN_CU_LOG2 ) <= ( maxPosY + 1 ) )
             {
-              if( other.m_codedCUInfo[x][y][wIdx][hIdx]->temporalId > m_codedCUInfo[x][y][wIdx][hIdx]->temporalId )
+              const unsigned     blkIdx     = blkIdxX * m_numBlkY + blkIdxY;
+              const CodedCUInfo* otherInfo  = other.xGetBlkInfoIfValid( blkIdx );
+              CodedCUInfo&       cuInfo     = xGetBlkInfo( blkIdx );
+
+              if( otherInfo && otherInfo->temporalId > cuInfo.temporalId )
               {
-                *m_codedCUInfo[x][y][wIdx][hIdx] = *other.m_codedCUInfo[x][y][wIdx][hIdx];
-                m_codedCUInfo[x][y][wIdx][hIdx]->temporalId = m_currTemporalId;
+                cuInfo            = *otherInfo;
+                cuInfo.generation = m_generation;
+                cuInfo.temporalId = m_currTemporalId;
               }
             }
             else if( y + ( height >> MIN_CU_LOG2 ) > maxPosY + 1 )
             {
-              break;;
+              break;
             }
           }
         }
@@ -473,29 +480,24 @@ void CacheBlkInfoCtrl::copyState( const CacheBlkInfoCtrl &other, const UnitArea&
 
 CodedCUInfo& CacheBlkInfoCtrl::getBlkInfo( const UnitArea& area )
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
-
-  return *m_codedCUInfo[idx1][idx2][idx3][idx4];
+  return xGetBlkInfo( xGetBlkIdx( area ) );
 }
 
 bool CacheBlkInfoCtrl::isSkip( const UnitArea& area )
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const CodedCUInfo* cuInfo = xGetBlkInfoIfValid( xGetBlkIdx( area ) );
 
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->isSkip;
+  return cuInfo && cuInfo->isSkip;
 }
 
 void CacheBlkInfoCtrl::setMv( const UnitArea& area, const RefPicList refPicList, const int iRefIdx, const Mv& rMv )
 {
   if( iRefIdx >= MAX_STORED_CU_INFO_REFS ) return;
 
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  CodedCUInfo& cuInfo = xGetBlkInfo( xGetBlkIdx( area ) );
 
-  m_codedCUInfo[idx1][idx2][idx3][idx4]->saveMv [refPicList][iRefIdx] = rMv;
-  m_codedCUInfo[idx1][idx2][idx3][idx4]->validMv[refPicList][iRefIdx] = true;
+  cuInfo.saveMv [refPicList][iRefIdx] = rMv;
+  cuInfo.validMv[refPicList][iRefIdx] = true;
 #if ENABLE_SPLIT_PARALLELISM
 
   touch( area );
@@ -504,44 +506,46 @@ void CacheBlkInfoCtrl::setMv( const UnitArea& area, const RefPicList refPicList,
 
 bool CacheBlkInfoCtrl::getMv( const UnitArea& area, const RefPicList refPicList, const int iRefIdx, Mv& rMv ) const
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const CodedCUInfo* cuInfo = xGetBlkInfoIfValid( xGetBlkIdx( area ) );
+
+  if( !cuInfo )
+  {
+    rMv = Mv();
+    return false;
+  }
 
   if( iRefIdx >= MAX_STORED_CU_INFO_REFS )
   {
-    rMv = m_codedCUInfo[idx1][idx2][idx3][idx4]->saveMv[refPicList][0];
+    rMv = cuInfo->saveMv[refPicList][0];
     return false;
   }
 
-  rMv = m_codedCUInfo[idx1][idx2][idx3][idx4]->saveMv[refPicList][iRefIdx];
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->validMv[refPicList][iRefIdx];
+  rMv = cuInfo->saveMv[refPicList][iRefIdx];
+  return cuInfo->validMv[refPicList][iRefIdx];
 }
 
 void SaveLoadEncInfoCtrl::create()
 {
-  m_saveLoadInfo = new SaveLoadStruct*[gp_sizeIdxInfo->numWidths()];
+  m_numHeights_sls = gp_sizeIdxInfo->numHeights();
 
-  for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-  {
-    m_saveLoadInfo[wIdx] = new SaveLoadStruct[gp_sizeIdxInfo->numHeights()];
-  }
+  m_saveLoadInfo = new SaveLoadStruct[gp_sizeIdxInfo->numWidths() * m_numHeights_sls];
+  memset( m_saveLoadInfo, 0, gp_sizeIdxInfo->numWidths() * m_numHeights_sls * sizeof( SaveLoadStruct ) );
+
+  m_generation_sls = 0;
 }
 
 void SaveLoadEncInfoCtrl::destroy()
 {
-  for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-  {
-    delete[] m_saveLoadInfo[wIdx];
-  }
-
   delete[] m_saveLoadInfo;
+  m_saveLoadInfo = nullptr;
 }
 
 void SaveLoadEncInfoCtrl::init( const Slice &slice )
 {
-  for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
+  if( ++m_generation_sls == 0 )
   {
-    memset( m_saveLoadInfo[wIdx], 0, gp_sizeIdxInfo->numHeights() * sizeof( SaveLoadStruct ) );
+    memset( m_saveLoadInfo, 0, gp_sizeIdxInfo->numWidths() * m_numHeights_sls * sizeof( SaveLoadStruct ) );
+    m_generation_sls = 1;
   }
 
   m_slice_sls = &slice;
@@ -550,21 +554,32 @@ void SaveLoadEncInfoCtrl::init( const Slice &slice )
 
 void SaveLoadEncInfoCtrl::copyState( const SaveLoadEncInfoCtrl &other, const UnitArea& area )
 {
-  for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
+  memcpy( m_saveLoadInfo, other.m_saveLoadInfo, gp_sizeIdxInfo->numWidths() * m_numHeights_sls * sizeof( SaveLoadStruct ) );
+
+  m_generation_sls = other.m_generation_sls;
+  m_slice_sls      = other.m_slice_sls;
+}
+#endif
+
+SaveLoadStruct& SaveLoadEncInfoCtrl::xGetSaveLoadStruct( const unsigned wIdx, const unsigned hIdx )
+{
+  SaveLoadStruct& sls = m_saveLoadInfo[wIdx * m_numHeights_sls + hIdx];
+
+  if( sls.generation != m_generation_sls )
   {
-    memcpy( m_saveLoadInfo[wIdx], other.m_saveLoadInfo[wIdx], gp_sizeIdxInfo->numHeights() * sizeof( SaveLoadStruct ) );
+    memset( &sls, 0, sizeof( SaveLoadStruct ) );
+    sls.generation = m_generation_sls;
   }
 
-  m_slice_sls = other.m_slice_sls;
+  return sls;
 }
-#endif
 
 SaveLoadStruct& SaveLoadEncInfoCtrl::getSaveLoadStruct( const UnitArea& area )
 {
   unsigned idx1, idx2, idx3, idx4;
   getAreaIdx( area.Y(), *m_slice_sls->getPPS()->pcv, idx1, idx2, idx3, idx4 );
 
-  return m_saveLoadInfo[idx3][idx4];
+  return xGetSaveLoadStruct( idx3, idx4 );
 }
 
 SaveLoadStruct& SaveLoadEncInfoCtrl::getSaveLoadStructQuad( const UnitArea& area )
@@ -572,7 +587,7 @@ SaveLoadStruct& SaveLoadEncInfoCtrl::getSaveLoadStructQuad( const UnitArea& area
   unsigned idx1, idx2, idx3, idx4;
   getAreaIdx( Area( area.lx(), area.ly(), area.lwidth() / 2, area.lheight() / 2 ), *m_slice_sls->getPPS()->pcv, idx1, idx2, idx3, idx4 );
 
-  return m_saveLoadInfo[idx3][idx4];
+  return xGetSaveLoadStruct( idx3, idx4 );
 }
 
 SaveLoadTag SaveLoadEncInfoCtrl::getSaveLoadTag( const UnitArea& area )
@@ -580,8 +595,10 @@ SaveLoadTag SaveLoadEncInfoCtrl::getSaveLoadTag( const UnitArea& area )
   unsigned idx1, idx2, idx3, idx4;
   getAreaIdx( area.Y(), *m_slice_sls->getPPS()->pcv, idx1, idx2, idx3, idx4 );
 
+  const SaveLoadStruct& sls = xGetSaveLoadStruct( idx3, idx4 );
+
   unsigned PartIdx = ( ( idx1 << 8 ) | idx2 );
-  SaveLoadTag uc   = ( PartIdx == m_saveLoadInfo[idx3][idx4].partIdx ) ? m_saveLoadInfo[idx3][idx4].tag : SAVE_LOAD_INIT;
+  SaveLoadTag uc   = ( PartIdx == sls.partIdx ) ? sls.tag : SAVE_LOAD_INIT;
   return uc;
 }
 unsigned SaveLoadEncInfoCtrl::getSaveLoadInterDir( const UnitArea& area )
@@ -589,7 +606,7 @@ unsigned SaveLoadEncInfoCtrl::getSaveLoadInterDir( const UnitArea& area )
   unsigned idx1, idx2, idx3, idx4;
   getAreaIdx( area.Y(), *m_slice_sls->getPPS()->pcv, idx1, idx2, idx3, idx4 );
 
-  return m_saveLoadInfo[idx3][idx4].interDir;
+  return xGetSaveLoadStruct( idx3, idx4 ).interDir;
 }
 
 
@@ -1652,6 +1669,11 @@ Bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
       return false;
     }
 
+    if( m_skipIntra && !slice.isIntra() && cuECtx.bestCU && CU::isInter( *cuECtx.bestCU ) )
+    {
+      return false; // background CTU, the inter prediction from the background reference is kept
+    }
+
     // INTRA MODES
     CHECK( !slice.isIntra() && !cuECtx.bestTU, "No possible non-intra encoding for a P- or B-slice found" );
 
@@ -1798,6 +1820,23 @@ Bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
       return false;
     }
 
+    // depths removed from the multi-type tree search by the speed governor
+    if( m_mtDepthReduction > 0 && split != CU_QUAD_SPLIT )
+    {
+#if !HM_QTBT_ONLY_QT_IMPLICIT
+      const int maxMtD = cs.pcv->getMaxBtDepth( *cs.slice, partitioner.chType ) + partitioner.currImplicitBtDepth;
+#else
+      const int maxMtD = cs.pcv->getMaxBtDepth( *cs.slice, partitioner.chType );
+#endif
+      if( int( partitioner.currMtDepth ) + m_mtDepthReduction >= maxMtD )
+      {
+        if( split == CU_HORZ_SPLIT ) cuECtx.set( DID_HORZ_SPLIT, false );
+        if( split == CU_VERT_SPLIT ) cuECtx.set( DID_VERT_SPLIT, false );
+
+        return false;
+      }
+    }
+
     if( m_pcEncCfg->getUseContentBasedFastQtbt() )
     {
       const CompArea& currArea = partitioner.currArea().Y();
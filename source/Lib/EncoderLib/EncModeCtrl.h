@@ -228,6 +228,8 @@ protected:
   int                   m_lumaQPOffset;
 #endif
   bool                  m_fastDeltaQP;
+  int                   m_mtDepthReduction;
+  bool                  m_skipIntra;
   static_vector<ComprCUCtx, ( MAX_CU_DEPTH << 2 )> m_ComprCUCtxList;
 #if ENABLE_SPLIT_PARALLELISM
   int                   m_runNextInParallel;
@@ -274,6 +276,8 @@ public:
 #endif
   void setFastDeltaQp                 ( bool b )                {        m_fastDeltaQP = b;                               }
   bool getFastDeltaQp                 ()                  const { return m_fastDeltaQP;                                   }
+  void setMtDepthReduction            ( int d )                 {        m_mtDepthReduction = d;                          }
+  void setSkipIntra                   ( bool b )                {        m_skipIntra = b;                                 }
 
   double getBestInterCost             ()                  const { return m_ComprCUCtxList.back().bestInterCost;           }
   Distortion getInterHad              ()                  const { return m_ComprCUCtxList.back().interHad;                }
@@ -297,6 +301,8 @@ struct SaveLoadStruct
   unsigned        interDir;
   bool            mergeFlag;
   unsigned        partIdx;
+
+  unsigned        generation;
 };
 
 class SaveLoadEncInfoCtrl
@@ -316,7 +322,12 @@ protected:
 private:
 
   Slice const     *m_slice_sls;
-  SaveLoadStruct **m_saveLoadInfo;
+  // width, height packed into one array, entries older than the current generation are treated as cleared
+  SaveLoadStruct  *m_saveLoadInfo;
+  unsigned         m_numHeights_sls;
+  unsigned         m_generation_sls;
+
+  SaveLoadStruct& xGetSaveLoadStruct   ( const unsigned wIdx, const unsigned hIdx );
 
 public:
 
@@ -336,6 +347,9 @@ struct CodedCUInfo
 
   bool validMv[NUM_REF_PIC_LIST_01][MAX_STORED_CU_INFO_REFS];
   Mv   saveMv [NUM_REF_PIC_LIST_01][MAX_STORED_CU_INFO_REFS];
+
+  unsigned
+       generation;
 #if ENABLE_SPLIT_PARALLELISM
 
   uint64_t
@@ -349,8 +363,17 @@ private:
 
   unsigned         m_numWidths, m_numHeights;
   Slice const     *m_slice_chblk;
-  // x in CTU, y in CTU, width, height
-  CodedCUInfo   ***m_codedCUInfo[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2];
+  // packed index of the valid (x in CTU, width) and (y in CTU, height) combinations, -1 if the block does not fit into the CTU
+  int             *m_blkIdxX, *m_blkIdxY;
+  unsigned         m_numBlkX,  m_numBlkY;
+  // one flat array over all valid blocks, entries older than the current generation are treated as cleared
+  CodedCUInfo     *m_codedCUInfo;
+  unsigned         m_generation;
+
+  unsigned           xGetBlkIdx ( const UnitArea& area ) const;
+  CodedCUInfo&       xGetBlkInfo( const unsigned blkIdx );
+  const CodedCUInfo* xGetBlkInfoIfValid
+                                ( const unsigned blkIdx ) const;
 
 protected:
 
@@ -260,13 +260,6 @@ Void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats
   const PreCalcValues& pcv = *cs.pcv;
   const Int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
 
-  size_t lineBufferSize = pcv.maxCUWidth + 1;
-  if (m_signLineBuf1.size() != lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   int ctuRsAddr = 0;
   for( UInt yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
@@ -895,8 +888,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                         , Bool isCalculatePreDeblockSamples
                         )
 {
-  Int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  SChar signLeft, signRight, signDown;
+  Int startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   Int64 *diff, *count;
   Pel *srcLine, *orgLine;
   Int* skipLinesR = m_skipLinesR[compIdx];
@@ -924,21 +916,8 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
         endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  : (isRightAvail ? width : (width - 1))
                                                  ;
-        for (y=0; y<endY; y++)
-        {
-          signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
+        m_statsLinesEO( srcLine, srcStride, orgLine, orgStride, startX, endX, endY, -1, 1, diff, count );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -946,21 +925,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = isLeftAvail  ? 0 : 1;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_statsLinesEO( srcLine + endY * srcStride, srcStride, orgLine + endY * orgStride, orgStride, startX, endX, skipLinesB[typeIdx], -1, 1, diff, count );
           }
         }
       }
@@ -969,7 +934,6 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine = &m_signLineBuf1[0];
 
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
@@ -979,35 +943,9 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  : width
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
-        if (!isAboveAvail)
-        {
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
-
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-        }
-
-        Pel* srcLineBelow;
-        for (y=startY; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
 
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
+        m_statsLinesEO( srcLine + startY * srcStride, srcStride, orgLine + startY * orgStride, orgStride, startX, endX, endY - startY, -srcStride, srcStride, diff, count );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1015,20 +953,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = 0;
             endX   = width;
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_statsLinesEO( srcLine + endY * srcStride, srcStride, orgLine + endY * orgStride, orgStride, startX, endX, skipLinesB[typeIdx], -srcStride, srcStride, diff, count );
           }
         }
 
@@ -1038,10 +963,8 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = &m_signLineBuf1[0];
-        signDownLine= &m_signLineBuf2[0];
+        const Int posA = -srcStride - 1;
+        const Int posB =  srcStride + 1;
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1052,50 +975,14 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-        srcLine  += srcStride;
-        orgLine  += orgStride;
-
+        m_statsLinesEO( srcLine, srcStride, orgLine, orgStride, firstLineStartX, firstLineEndX, 1, posA, posB, diff, count );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
+        m_statsLinesEO( srcLine + srcStride, srcStride, orgLine + orgStride, orgStride, startX, endX, endY - 1, posA, posB, diff, count );
 
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x+1]);
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
-
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1103,20 +990,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_statsLinesEO( srcLine + endY * srcStride, srcStride, orgLine + endY * orgStride, orgStride, startX, endX, skipLinesB[typeIdx], posA, posB, diff, count );
           }
         }
       }
@@ -1125,7 +999,8 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine = &m_signLineBuf1[1];
+        const Int posA = -srcStride + 1;
+        const Int posB =  srcStride - 1;
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1135,51 +1010,18 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
-        srcLine += srcStride;
-        orgLine += orgStride;
+        m_statsLinesEO( srcLine, srcStride, orgLine, orgStride, firstLineStartX, firstLineEndX, 1, posA, posB, diff, count );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
+        m_statsLinesEO( srcLine + srcStride, srcStride, orgLine + orgStride, orgStride, startX, endX, endY - 1, posA, posB, diff, count );
 
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-            edgeType = signDown + signUpLine[x];
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1187,20 +1029,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
 
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            m_statsLinesEO( srcLine + endY * srcStride, srcStride, orgLine + endY * orgStride, orgStride, startX, endX, skipLinesB[typeIdx], posA, posB, diff, count );
           }
         }
       }
@@ -1215,18 +1044,9 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                 ;
         endY = isBelowAvail ? (height- skipLinesB[typeIdx]) : height;
         Int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-        for (y=0; y< endY; y++)
-        {
-          for (x=startX; x< endX; x++)
-          {
 
-            Int bandIdx= srcLine[x] >> shiftBits;
-            diff [bandIdx] += (orgLine[x] - srcLine[x]);
-            count[bandIdx] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
+        m_statsLinesBO( srcLine, srcStride, orgLine, orgStride, startX, endX, endY, shiftBits, diff, count );
+
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
@@ -1234,19 +1054,7 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
             startX = 0;
             endX   = width;
 
-            for(y= 0; y< skipLinesB[typeIdx]; y++)
-            {
-              for (x=startX; x< endX; x++)
-              {
-                Int bandIdx= srcLine[x] >> shiftBits;
-                diff [bandIdx] += (orgLine[x] - srcLine[x]);
-                count[bandIdx] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-
-            }
-
+            m_statsLinesBO( srcLine + endY * srcStride, srcStride, orgLine + endY * orgStride, orgStride, startX, endX, skipLinesB[typeIdx], shiftBits, diff, count );
           }
         }
       }
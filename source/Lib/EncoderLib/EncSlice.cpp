@@ -40,6 +40,8 @@
 #include "EncLib.h"
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/Picture.h"
+#include "CommonLib/Profiler.h"
+#include "CommonLib/DiagLog.h"
 
 #if ENABLE_WPP_PARALLELISM
 #include <mutex>
@@ -47,6 +49,7 @@ extern recursive_mutex g_cache_mutex;
 #endif
 
 #include <math.h>
+#include <chrono>
 
 //! \ingroup EncoderLib
 //! \{
@@ -57,6 +60,9 @@ extern recursive_mutex g_cache_mutex;
 
 EncSlice::EncSlice()
  : m_encCABACTableIdx(I_SLICE)
+ , m_bgRefPoc        (MAX_INT)
+ , m_bgBlock         (nullptr)
+ , m_bgCtu           (nullptr)
 {
 }
 
@@ -75,6 +81,9 @@ Void EncSlice::destroy()
   m_vdRdPicLambda.clear();
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
+
+  m_ctuStatsWriter.close();
+  m_ctuStats.clear();
 }
 
 Void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
@@ -96,6 +105,14 @@ Void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
   m_vdRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_viRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_pcRateCtrl        = pcEncLib->getRateCtrl();
+
+  if( !m_pcCfg->getCtuStatsFileName().empty() && !m_ctuStatsWriter.isOpen() )
+  {
+    if( !m_ctuStatsWriter.open( m_pcCfg->getCtuStatsFileName() ) )
+    {
+      THROW( "Unable to open the CTU statistics file " << m_pcCfg->getCtuStatsFileName() );
+    }
+  }
 }
 
 Void
@@ -626,13 +643,13 @@ Void EncSlice::setbgQPSlice(Slice*& rpcSlice, Int Q, Int iGOPid, bool isField, D
 		dLambda = calculateLambda(rpcSlice, iGOPid, depth, dQP, dQP, iQP);
 
 
-		cout << "Lambda" << dLambda;
+		DIAG_LOG( DETAILS, "Lambda%f", dLambda );
 		double M = P;
 		double beta = 0.5;
 		double MM = M / (1 + (M - 1)*pow(M, beta));
 		MM = pow(MM, 1 / beta);
 		dLambda = dLambda*MM;
-		cout << "Lambda" << dLambda;
+		DIAG_LOG( DETAILS, "Lambda%f", dLambda );
 		
 
 		m_vdRdPicLambda[iDQpIdx] = dLambda;
@@ -1175,7 +1192,7 @@ Void EncSlice::setSearchRange( Slice* pcSlice )
     for (Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(e); iRefIdx++)
     {
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
-      Int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
+      Int newSearchRange = m_pcCfg->getUseASR() ? Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize) : iMaxSR;
       m_pcInterSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
 #if ENABLE_WPP_PARALLELISM
       for( int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++ )
@@ -1187,11 +1204,23 @@ Void EncSlice::setSearchRange( Slice* pcSlice )
   }
 }
 
+/**
+ - the original picture is replaced by the background update and the reference lists get the background picture in
+   place, so the same picture and POC can be trial encoded on different samples
+ .
+ */
+Void EncSlice::resetPicAnalysis()
+{
+  m_pcLib->getHierarchicalME()->invalidate();
+  m_pcLib->getGradientAnalysis()->invalidate();
+}
+
 /**
  Multi-loop slice encoding for different slice QP
 
  \param pcPic    picture class
  */
+
 Void EncSlice::precompressSlice( Picture* pcPic )
 {
   // if deltaQP RD is not used, simply return
@@ -1249,7 +1278,7 @@ Void EncSlice::precompressSlice( Picture* pcPic )
     setUpLambda(pcSlice, m_vdRdPicLambda[uiQpIdx], m_viRdPicQp    [uiQpIdx]);
 
     // try compress
-	cout << "inprecom" << endl;
+	DIAG_LOG( DETAILS, "inprecom\n" );
     compressSlice   ( pcPic, true, m_pcCfg->getFastDeltaQp());
 
     UInt64 uiPicDist        = m_uiPicDist; // Distortion, as calculated by compressSlice.
@@ -1588,8 +1617,7 @@ Void EncSlice::compressSliceRDO(Picture* pcPic, const Bool bCompressEntireSlice,
 
 Void EncSlice::encodeCtusRDO(Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP, UInt startCtuTsAddr, UInt boundingCtuTsAddr, EncLib* pEncLib, Int bgBlock[], Double BlockDPP[])
 	{
-		//PROF_ACCUM_AND_START_NEW_SET( getProfilerCTU( pcPic, 0, 0 ), P_PIC_LEVEL );
-		//PROF_START( getProfilerCTU( cs.slice->isIntra(), pcPic->scheduler.getWppThreadId() ), P_PIC_LEVEL, toWSizeIdx( cs.pcv->maxCUWidth ), toHSizeIdx( cs.pcv->maxCUHeight ) );
+		PROF_SCOPE( P_SLICE_LEVEL );
 		CodingStructure&  cs = *pcPic->cs;
 		Slice* pcSlice = cs.slice;
 		const PreCalcValues& pcv = *cs.pcv;
@@ -2171,8 +2199,7 @@ Void EncSlice::encodeCtusRDO(Picture* pcPic, const Bool bCompressEntireSlice, co
 
 	Void EncSlice::encodeCtusSel(Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP, UInt startCtuTsAddr, UInt boundingCtuTsAddr, EncLib* pEncLib, vector<int>& BgSelect)
 	{
-			//PROF_ACCUM_AND_START_NEW_SET( getProfilerCTU( pcPic, 0, 0 ), P_PIC_LEVEL );
-			//PROF_START( getProfilerCTU( cs.slice->isIntra(), pcPic->scheduler.getWppThreadId() ), P_PIC_LEVEL, toWSizeIdx( cs.pcv->maxCUWidth ), toHSizeIdx( cs.pcv->maxCUHeight ) );
+			PROF_SCOPE( P_SLICE_LEVEL );
 			CodingStructure&  cs = *pcPic->cs;
 			Slice* pcSlice = cs.slice;
 			const PreCalcValues& pcv = *cs.pcv;
@@ -2536,6 +2563,15 @@ Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, c
     xCheckWPEnable( pcSlice );
   }
 
+  if( m_pcCfg->getUseHierarchicalME() )
+  {
+    m_pcLib->getHierarchicalME()->build( *pcSlice );
+  }
+  if( m_pcCfg->getUseFastIntraGradient() )
+  {
+    m_pcLib->getGradientAnalysis()->analyze( *pcSlice );
+  }
+
 
 #if HEVC_DEPENDENT_SLICES
 #if HEVC_TILES_WPP
@@ -2726,8 +2762,7 @@ Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, c
 
 Void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP, UInt startCtuTsAddr, UInt boundingCtuTsAddr, EncLib* pEncLib )
 {
-  //PROF_ACCUM_AND_START_NEW_SET( getProfilerCTU( pcPic, 0, 0 ), P_PIC_LEVEL );
-  //PROF_START( getProfilerCTU( cs.slice->isIntra(), pcPic->scheduler.getWppThreadId() ), P_PIC_LEVEL, toWSizeIdx( cs.pcv->maxCUWidth ), toHSizeIdx( cs.pcv->maxCUHeight ) );
+  PROF_SCOPE( P_SLICE_LEVEL );
   CodingStructure&  cs            = *pcPic->cs;
   Slice* pcSlice                  = cs.slice;
   const PreCalcValues& pcv        = *cs.pcv;
@@ -2889,11 +2924,28 @@ Void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
     }
 #endif
 
+    if( pCfg->getBgSkipIntra() )
+    {
+      const Bool skipIntra = !pcSlice->isIntra() && xIsBgCtu( ctuArea, *cs.pcv );
+#if ENABLE_WPP_PARALLELISM
+      pEncLib->getCuEncoder( dataId )->getModeCtrl()->setSkipIntra( skipIntra );
+#else
+      m_pcCuEncoder->getModeCtrl()->setSkipIntra( skipIntra );
+#endif
+    }
 
 #if ENABLE_WPP_PARALLELISM
     pEncLib->getCuEncoder( dataId )->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
 #else
+    const Bool storeCtuStats = m_ctuStatsWriter.isOpen();
+    const auto ctuStartTime  = storeCtuStats ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
     m_pcCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+
+    if( storeCtuStats )
+    {
+      xStoreCtuStats( cs, ctuArea, ctuRsAddr, std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - ctuStartTime ).count() );
+    }
 #endif
 
 	
@@ -3132,6 +3184,11 @@ Void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, UI
 #endif
     m_CABACWriter->coding_tree_unit( cs, ctuArea, pcPic->m_prevQP, ctuRsAddr );
 
+    if( m_ctuStatsWriter.isOpen() && ctuRsAddr < m_ctuStats.size() && m_ctuStats[ctuRsAddr].poc == pcSlice->getPOC() )
+    {
+      m_ctuStatsRecords += m_ctuStats[ctuRsAddr].toCsv();
+    }
+
 #if HEVC_TILES_WPP
     // store probabilities of second CTU in line into buffer
     if( ctuXPosInCtus == tileXPosInCtus + 1 && wavefrontsEnabled )
@@ -3185,6 +3242,120 @@ Void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, UI
   }
   numBinsCoded = m_CABACWriter->getNumBins();
 
+  // the statistics of the final decisions are written once the slice is coded
+  m_ctuStatsWriter.write( m_ctuStatsRecords );
+}
+
+Void EncSlice::xStoreCtuStats( const CodingStructure& cs, const UnitArea& ctuArea, const UInt ctuRsAddr, const Int64 timeUs )
+{
+  const PreCalcValues& pcv   = *cs.pcv;
+  const Slice&         slice = *cs.slice;
+
+  if( m_ctuStats.size() != pcv.sizeInCtus )
+  {
+    m_ctuStats.resize( pcv.sizeInCtus );
+  }
+
+  CtuStats& stats = m_ctuStats[ctuRsAddr];
+  stats           = CtuStats();
+  stats.poc       = slice.getPOC();
+  stats.ctuRsAddr = ctuRsAddr;
+  stats.posX      = ctuArea.lx();
+  stats.posY      = ctuArea.ly();
+  stats.timeUs    = timeUs;
+
+  for( const CodingUnit &cu : cs.traverseCUs( ctuArea, CHANNEL_TYPE_LUMA ) )
+  {
+    const UInt area = cu.lumaSize().area();
+
+    stats.numCUs++;
+    stats.maxDepth = std::max<Int>( stats.maxDepth, cu.depth );
+
+    if( CU::isIntra( cu ) )
+    {
+      stats.intraArea += area;
+      continue;
+    }
+
+    if( cu.skip )
+    {
+      stats.skipArea += area;
+    }
+    else if( cu.firstPU->mergeFlag )
+    {
+      stats.mergeArea += area;
+    }
+    else
+    {
+      stats.interArea += area;
+    }
+
+    if( m_bgRefPoc != MAX_INT )
+    {
+      for( const PredictionUnit &pu : CU::traversePUs( cu ) )
+      {
+        for( UInt refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+        {
+          if( ( pu.interDir & ( 1 << refList ) ) && slice.getRefPOC( RefPicList( refList ), pu.refIdx[refList] ) == m_bgRefPoc )
+          {
+            stats.bgRefArea += pu.lumaSize().area();
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if( m_bgCtu )
+  {
+    stats.bgCtu = m_bgCtu[ctuRsAddr];
+  }
+
+  if( m_bgBlock )
+  {
+    // the background blocks are numbered in raster order over the picture
+    const Int blocksPerRow = ( pcv.lumaWidth + BLOCK_GEN_LEN - 1 ) / BLOCK_GEN_LEN;
+    const Int endY         = std::min<Int>( ctuArea.ly() + ctuArea.lheight(), pcv.lumaHeight );
+    const Int endX         = std::min<Int>( ctuArea.lx() + ctuArea.lwidth(),  pcv.lumaWidth  );
+
+    for( Int y = ctuArea.ly(); y < endY; y += BLOCK_GEN_LEN )
+    {
+      for( Int x = ctuArea.lx(); x < endX; x += BLOCK_GEN_LEN )
+      {
+        const Int bgBlock = m_bgBlock[( y / BLOCK_GEN_LEN ) * blocksPerRow + x / BLOCK_GEN_LEN];
+
+        stats.bgBlocks++;
+        stats.bgBlocksPending += bgBlock > 0 && bgBlock < 2000 ? 1 : 0;
+        stats.bgBlocksCoded   += bgBlock >= 2000 ? 1 : 0;
+      }
+    }
+  }
+}
+
+Bool EncSlice::xIsBgCtu( const UnitArea& ctuArea, const PreCalcValues& pcv ) const
+{
+  if( m_bgRefPoc == MAX_INT || !m_bgBlock )
+  {
+    return false;
+  }
+
+  // the CTU counts as background only if every block in it is already coded into the background reference
+  const Int blocksPerRow = ( pcv.lumaWidth + BLOCK_GEN_LEN - 1 ) / BLOCK_GEN_LEN;
+  const Int endY         = std::min<Int>( ctuArea.ly() + ctuArea.lheight(), pcv.lumaHeight );
+  const Int endX         = std::min<Int>( ctuArea.lx() + ctuArea.lwidth(),  pcv.lumaWidth  );
+
+  for( Int y = ctuArea.ly(); y < endY; y += BLOCK_GEN_LEN )
+  {
+    for( Int x = ctuArea.lx(); x < endX; x += BLOCK_GEN_LEN )
+    {
+      if( m_bgBlock[( y / BLOCK_GEN_LEN ) * blocksPerRow + x / BLOCK_GEN_LEN] < 2000 )
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
 }
 
 #if HEVC_TILES_WPP
@@ -42,6 +42,7 @@
 #include "EncCu.h"
 #include "WeightPredAnalysis.h"
 #include "RateCtrl.h"
+#include "CtuStats.h"
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
@@ -109,6 +110,14 @@ private:
   Int                     m_gopID;
 #endif
 
+  // per-CTU statistics
+  CtuStatsWriter          m_ctuStatsWriter;
+  std::vector<CtuStats>   m_ctuStats;                           ///< statistics of the last compression of each CTU of the picture
+  std::string             m_ctuStatsRecords;
+  Int                     m_bgRefPoc;                           ///< POC of the reference picture carrying the background blocks, MAX_INT if none
+  const Int*              m_bgBlock;
+  const Int*              m_bgCtu;
+
 #if SHARP_LUMA_DELTA_QP
 public:
   Int getGopId()        const { return m_gopID; }
@@ -152,6 +161,7 @@ public:
 #endif
 
   // compress and encode slice
+  Void    resetPicAnalysis    ();                                                          ///< drops the motion field and gradient histograms cached for the last trial encode
   Void    precompressSlice    ( Picture* pcPic                                     );      ///< precompress slice for multi-loop slice-level QP opt.
   Void    compressSlice       ( Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP );      ///< analysis stage of slice
   Void    calCostSliceI       ( Picture* pcPic );
@@ -181,6 +191,9 @@ public:
 
   SliceType getEncCABACTableIdx() const             { return m_encCABACTableIdx;        }
 
+  /// background state used for the per-CTU statistics of the next slices
+  Void    setBgCtuState       ( Int bgRefPoc, const Int* bgBlock, const Int* bgCtu ) { m_bgRefPoc = bgRefPoc; m_bgBlock = bgBlock; m_bgCtu = bgCtu; }
+
 #if GENERATE_OrgBG_PIC
   Void setNewPicYuvOrgSli(Picture* m) { m_bgPicYuvOrgSli = m; }
   Picture* getNewPicYuvOrgSli() { return m_bgPicYuvOrgSli; }
@@ -193,6 +206,8 @@ public:
 
 private:
   Double  xGetQPValueAccordingToLambda ( Double lambda );
+  Void    xStoreCtuStats      ( const CodingStructure& cs, const UnitArea& ctuArea, const UInt ctuRsAddr, const Int64 timeUs );
+  Bool    xIsBgCtu            ( const UnitArea& ctuArea, const PreCalcValues& pcv ) const;
 };
 
 //! \}
@@ -0,0 +1,240 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/** \file     GradientAnalysis.cpp
+    \brief    gradient orientation histograms of the original picture, used to pre-select angular intra modes
+*/
+
+#include "GradientAnalysis.h"
+
+#include "CommonLib/Picture.h"
+#include "CommonLib/Slice.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+static const Int g_gradBlockLog2      = 2;    ///< histograms are kept per 4x4 block
+static const Int g_gradMinMagnitude   = 16;   ///< smaller gradients (|gx| + |gy| at 8 bit) are not counted
+static const Int g_gradNumCandidates  = 3;    ///< dominant directions of an area
+
+// intra prediction angles of the even mode offsets 0, 2, ..., 16 from HOR_IDX and VER_IDX
+static const Int g_gradEvenAngles[]   = { 0, 2, 5, 9, 13, 17, 21, 26, 32 };
+
+GradientAnalysis::GradientAnalysis()
+  : m_pic           ( nullptr )
+  , m_poc           ( MAX_INT )
+  , m_widthInBlocks ( 0 )
+  , m_heightInBlocks( 0 )
+{
+  // the tangent of the edge direction is 64 * min( |gx|, |gy| ) / max( |gx|, |gy| ), the angles are in units of 1/32
+  for( Int q = 0; q <= 64; q++ )
+  {
+    Int best = 0;
+    for( Int i = 1; i < Int( sizeof( g_gradEvenAngles ) / sizeof( g_gradEvenAngles[0] ) ); i++ )
+    {
+      if( abs( 2 * g_gradEvenAngles[i] - q ) < abs( 2 * g_gradEvenAngles[best] - q ) )
+      {
+        best = i;
+      }
+    }
+    m_angleToIdx[q] = UChar( 2 * best );
+  }
+}
+
+Void GradientAnalysis::destroy()
+{
+  std::vector<UShort>().swap( m_hist );
+  std::vector<Pel>   ().swap( m_gradX );
+  std::vector<Pel>   ().swap( m_gradY );
+  m_pic = nullptr;
+  m_poc = MAX_INT;
+}
+
+Void GradientAnalysis::analyze( const Slice& slice )
+{
+  const Picture& pic = *slice.getPic();
+
+  if( &pic == m_pic && pic.getPOC() == m_poc )
+  {
+    return;
+  }
+
+  const CPelBuf org   = pic.getOrigBuf().Y();
+  const Int     shift = slice.getSPS()->getBitDepth( CHANNEL_TYPE_LUMA ) - 8;
+
+  m_pic            = &pic;
+  m_poc            = pic.getPOC();
+  m_widthInBlocks  = ( org.width  + ( 1 << g_gradBlockLog2 ) - 1 ) >> g_gradBlockLog2;
+  m_heightInBlocks = ( org.height + ( 1 << g_gradBlockLog2 ) - 1 ) >> g_gradBlockLog2;
+
+  m_hist.assign( m_widthInBlocks * m_heightInBlocks * NUM_BINS, 0 );
+  m_gradX.resize( org.width );
+  m_gradY.resize( org.width );
+
+  if( org.width < 3 || org.height < 3 )
+  {
+    return;
+  }
+
+  // the gradients are computed for the samples with all eight neighbours inside the picture
+  const Int width = Int( org.width ) - 2;
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+  const Int widthSimd = width & ~7;
+#else
+  const Int widthSimd = 0;
+#endif
+
+  for( Int y = 1; y < Int( org.height ) - 1; y++ )
+  {
+    const Pel* src   = org.bufAt( 1, y );
+    Pel*       gradX = &m_gradX[0];
+    Pel*       gradY = &m_gradY[0];
+
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
+    if( widthSimd > 0 )
+    {
+      g_pelBufOP.sobel8( src, org.stride, gradX, gradY, widthSimd );
+    }
+#endif
+    for( Int x = widthSimd; x < width; x++ )
+    {
+      const Pel* above = src + x - org.stride;
+      const Pel* below = src + x + org.stride;
+
+      gradX[x] = ( above[1] + 2 * src[x + 1] + below[1] ) - ( above[-1] + 2 * src[x - 1] + below[-1] );
+      gradY[x] = ( below[-1] + 2 * below[0] + below[1] ) - ( above[-1] + 2 * above[0] + above[1] );
+    }
+
+    UShort* histRow = &m_hist[( y >> g_gradBlockLog2 ) * m_widthInBlocks * NUM_BINS];
+
+    for( Int x = 0; x < width; x++ )
+    {
+      const Int absX = abs( gradX[x] );
+      const Int absY = abs( gradY[x] );
+
+      if( ( ( absX + absY ) >> shift ) < g_gradMinMagnitude )
+      {
+        continue;
+      }
+
+      // a horizontal edge has a vertical gradient, the edge is continued by the modes close to HOR_IDX
+      const Bool negative = ( gradX[x] < 0 ) != ( gradY[x] < 0 );
+      Int        mode;
+
+      if( absY >= absX )
+      {
+        const Int idx = m_angleToIdx[( absX << 6 ) / absY];
+        mode = negative ? HOR_IDX + idx : HOR_IDX - idx;
+      }
+      else
+      {
+        const Int idx = m_angleToIdx[( absY << 6 ) / absX];
+        mode = negative ? VER_IDX - idx : VER_IDX + idx;
+      }
+
+      histRow[( ( x + 1 ) >> g_gradBlockLog2 ) * NUM_BINS + ( ( mode - 2 ) >> 1 )] += ( absX + absY ) >> shift;
+    }
+  }
+}
+
+Bool GradientAnalysis::getCandidates( const Slice& slice, const CompArea& area, Bool modes[NUM_LUMA_MODE] ) const
+{
+  if( slice.getPic() != m_pic || slice.getPOC() != m_poc || m_hist.empty() )
+  {
+    return false;
+  }
+
+  const Int x0 = area.x >> g_gradBlockLog2;
+  const Int y0 = area.y >> g_gradBlockLog2;
+  const Int x1 = std::min<Int>( ( area.x + area.width  - 1 ) >> g_gradBlockLog2, m_widthInBlocks  - 1 );
+  const Int y1 = std::min<Int>( ( area.y + area.height - 1 ) >> g_gradBlockLog2, m_heightInBlocks - 1 );
+
+  UInt energy[NUM_BINS] = { 0 };
+
+  for( Int by = y0; by <= y1; by++ )
+  {
+    const UShort* hist = &m_hist[( by * m_widthInBlocks + x0 ) * NUM_BINS];
+
+    for( Int bx = x0; bx <= x1; bx++, hist += NUM_BINS )
+    {
+      for( Int b = 0; b < NUM_BINS; b++ )
+      {
+        energy[b] += hist[b];
+      }
+    }
+  }
+
+  ::memset( modes, 0, NUM_LUMA_MODE * sizeof( Bool ) );
+  modes[PLANAR_IDX] = true;
+  modes[DC_IDX]     = true;
+
+  Bool found = false;
+
+  for( Int c = 0; c < g_gradNumCandidates; c++ )
+  {
+    Int best = 0;
+    for( Int b = 1; b < NUM_BINS; b++ )
+    {
+      if( energy[b] > energy[best] )
+      {
+        best = b;
+      }
+    }
+    if( energy[best] == 0 )
+    {
+      break;
+    }
+    energy[best] = 0;
+    found        = true;
+
+    // the direction and its even neighbours
+    const Int mode = 2 * best + 2;
+    for( Int m = std::max( 2, mode - 2 ); m <= std::min( VDIA_IDX, mode + 2 ); m += 2 )
+    {
+      modes[m] = true;
+    }
+  }
+
+  // flat areas: the pure directions besides planar and DC
+  if( !found )
+  {
+    modes[HOR_IDX] = true;
+    modes[VER_IDX] = true;
+  }
+
+  return true;
+}
+
+//! \}
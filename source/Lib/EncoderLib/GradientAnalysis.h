@@ -0,0 +1,87 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     GradientAnalysis.h
+    \brief    gradient orientation histograms of the original picture, used to pre-select angular intra modes (header)
+*/
+
+#ifndef __GRADIENTANALYSIS__
+#define __GRADIENTANALYSIS__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+class Slice;
+class Picture;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Sobel gradients of the original luma picture, accumulated per 4x4 block into a magnitude weighted histogram over the
+/// even angular intra modes
+class GradientAnalysis
+{
+public:
+  GradientAnalysis();
+
+  Void  destroy             ();
+  Void  invalidate          ()                                        { m_pic = nullptr; }            ///< the next analyze recomputes the histograms, the original samples were rewritten
+
+  Void  analyze             ( const Slice& slice );                                                   ///< histograms of the picture of the slice, kept until invalidated
+  Bool  getCandidates       ( const Slice& slice, const CompArea& area, Bool modes[NUM_LUMA_MODE] ) const;  ///< planar, DC and the angular modes of the dominant directions inside the area
+
+private:
+  static const Int NUM_BINS = ( VDIA_IDX - 2 ) / 2 + 1;    ///< even angular modes 2, 4, ..., 66
+
+  UChar               m_angleToIdx[65];   ///< nearest even mode offset from HOR_IDX / VER_IDX for 64 * min( |g| ) / max( |g| )
+
+  const Picture*      m_pic;
+  Int                 m_poc;
+  Int                 m_widthInBlocks;
+  Int                 m_heightInBlocks;
+  std::vector<UShort> m_hist;             ///< NUM_BINS entries per 4x4 block
+  std::vector<Pel>    m_gradX;
+  std::vector<Pel>    m_gradY;
+};
+
+//! \}
+
+#endif // __GRADIENTANALYSIS__
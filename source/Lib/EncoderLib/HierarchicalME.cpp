@@ -0,0 +1,301 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/** \file     HierarchicalME.cpp
+    \brief    coarse motion field from downsampled pictures, used to start the integer motion search
+*/
+
+#include "HierarchicalME.h"
+#include "EncCfg.h"
+
+#include "CommonLib/Picture.h"
+#include "CommonLib/Slice.h"
+#include "CommonLib/Unit.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+static const Int g_hmeBlockSize       = 8;   ///< block size of the search at each level
+static const Int g_hmeHalfRange       = 2;   ///< refinement range at 1/2 resolution
+static const Int g_hmeFullRange       = 1;   ///< refinement range at full resolution
+static const Int g_hmeMinRefineRange  = 8;   ///< smallest integer search range around a start vector from the motion field
+
+HierarchicalME::HierarchicalME()
+  : m_pcEncCfg      ( nullptr )
+  , m_pcRdCost      ( nullptr )
+  , m_bitDepth      ( 8 )
+  , m_poc           ( MAX_INT )
+  , m_widthInBlocks ( 0 )
+  , m_heightInBlocks( 0 )
+{
+  ::memset( m_refPics,   0, sizeof( m_refPics ) );
+  ::memset( m_refPocs,   0, sizeof( m_refPocs ) );
+  ::memset( m_numRefIdx, 0, sizeof( m_numRefIdx ) );
+  ::memset( m_fieldIdx,  0, sizeof( m_fieldIdx ) );
+}
+
+Void HierarchicalME::init( EncCfg* pcEncCfg, RdCost* pcRdCost )
+{
+  m_pcEncCfg = pcEncCfg;
+  m_pcRdCost = pcRdCost;
+  m_poc      = MAX_INT;
+}
+
+Void HierarchicalME::destroy()
+{
+  for( Int l = 0; l < NUM_LEVELS; l++ )
+  {
+    m_curPyramid.level[l].destroy();
+    for( auto& pyramid : m_refPyramids )
+    {
+      pyramid.level[l].destroy();
+    }
+  }
+  for( auto& field : m_fields )
+  {
+    std::vector<Mv>().swap( field );
+  }
+  m_poc = MAX_INT;
+}
+
+Int HierarchicalME::getRefineRange( Int searchRange )
+{
+  return std::min( searchRange, std::max( g_hmeMinRefineRange, searchRange >> 2 ) );
+}
+
+Void HierarchicalME::build( const Slice& slice )
+{
+  Bool unchanged = slice.getPOC() == m_poc;
+
+  for( Int l = 0; l < NUM_REF_PIC_LIST_01 && unchanged; l++ )
+  {
+    const RefPicList refList = RefPicList( l );
+    unchanged = slice.getNumRefIdx( refList ) == m_numRefIdx[l];
+
+    for( Int r = 0; r < m_numRefIdx[l] && unchanged; r++ )
+    {
+      unchanged = slice.getRefPic( refList, r ) == m_refPics[l][r] && slice.getRefPic( refList, r )->getPOC() == m_refPocs[l][r];
+    }
+  }
+  if( unchanged )
+  {
+    return;
+  }
+
+  const CPelBuf cur = slice.getPic()->getOrigBuf().Y();
+
+  m_poc            = slice.getPOC();
+  m_bitDepth       = slice.getSPS()->getBitDepth( CHANNEL_TYPE_LUMA );
+  m_widthInBlocks  = ( cur.width  + g_hmeBlockSize - 1 ) / g_hmeBlockSize;
+  m_heightInBlocks = ( cur.height + g_hmeBlockSize - 1 ) / g_hmeBlockSize;
+  ::memset( m_numRefIdx, 0, sizeof( m_numRefIdx ) );
+
+  // the search at 1/4 resolution needs at least one full block
+  if( slice.isIntra() || ( cur.width >> NUM_LEVELS ) < g_hmeBlockSize || ( cur.height >> NUM_LEVELS ) < g_hmeBlockSize )
+  {
+    return;
+  }
+
+  xBuildPyramid( cur, m_curPyramid );
+
+  Int numFields = 0;
+  for( Int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    const RefPicList refList = RefPicList( l );
+
+    for( Int r = 0; r < slice.getNumRefIdx( refList ); r++ )
+    {
+      const Picture* refPic = slice.getRefPic( refList, r );
+
+      m_refPics  [l][r] = refPic;
+      m_refPocs  [l][r] = refPic->getPOC();
+      m_fieldIdx [l][r] = -1;
+
+      // a picture in both lists is searched once
+      for( Int ll = 0; ll <= l && m_fieldIdx[l][r] < 0; ll++ )
+      {
+        for( Int rr = 0; rr < ( ll < l ? slice.getNumRefIdx( RefPicList( ll ) ) : r ); rr++ )
+        {
+          if( m_refPics[ll][rr] == refPic )
+          {
+            m_fieldIdx[l][r] = m_fieldIdx[ll][rr];
+            break;
+          }
+        }
+      }
+
+      if( m_fieldIdx[l][r] < 0 )
+      {
+        const CPelBuf ref = refPic->getRecoBuf( COMPONENT_Y );
+
+        xBuildPyramid( ref, m_refPyramids[numFields] );
+        xEstimateField( cur, m_curPyramid, ref, m_refPyramids[numFields], m_fields[numFields] );
+        m_fieldIdx[l][r] = numFields++;
+      }
+    }
+    m_numRefIdx[l] = slice.getNumRefIdx( refList );
+  }
+}
+
+Bool HierarchicalME::getMv( const PredictionUnit& pu, RefPicList refList, Int refIdx, Mv& mv ) const
+{
+  const Slice& slice = *pu.cu->slice;
+
+  if( slice.getPOC() != m_poc || refIdx >= m_numRefIdx[refList] || slice.getRefPic( refList, refIdx ) != m_refPics[refList][refIdx] )
+  {
+    return false;
+  }
+
+  const Int bx = std::min<Int>( ( pu.lx() + ( pu.lwidth()  >> 1 ) ) / g_hmeBlockSize, m_widthInBlocks  - 1 );
+  const Int by = std::min<Int>( ( pu.ly() + ( pu.lheight() >> 1 ) ) / g_hmeBlockSize, m_heightInBlocks - 1 );
+
+  mv = m_fields[m_fieldIdx[refList][refIdx]][by * m_widthInBlocks + bx];
+  return true;
+}
+
+Void HierarchicalME::xBuildPyramid( const CPelBuf& src, Pyramid& pyramid )
+{
+  for( Int l = 0; l < NUM_LEVELS; l++ )
+  {
+    const CPelBuf in     = l == 0 ? src : CPelBuf( pyramid.level[l - 1].Y() );
+    const Int     width  = src.width  >> ( l + 1 );
+    const Int     height = src.height >> ( l + 1 );
+
+    if( pyramid.level[l].bufs.empty() || pyramid.level[l].Y().width != width || pyramid.level[l].Y().height != height )
+    {
+      pyramid.level[l].destroy();
+      pyramid.level[l].create( CHROMA_400, Area( 0, 0, width, height ) );
+    }
+
+    PelBuf out = pyramid.level[l].Y();
+
+    for( Int y = 0; y < height; y++ )
+    {
+      const Pel* src0 = in.bufAt( 0, 2 * y );
+      const Pel* src1 = src0 + in.stride;
+      Pel*       dst  = out.bufAt( 0, y );
+
+      for( Int x = 0; x < width; x++ )
+      {
+        dst[x] = ( src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2 ) >> 2;
+      }
+    }
+  }
+}
+
+Void HierarchicalME::xEstimateField( const CPelBuf& cur, const Pyramid& curPyr, const CPelBuf& ref, const Pyramid& refPyr, std::vector<Mv>& field )
+{
+  const CPelBuf curHalf    = curPyr.level[0].Y();
+  const CPelBuf refHalf    = refPyr.level[0].Y();
+  const CPelBuf curQuarter = curPyr.level[1].Y();
+  const CPelBuf refQuarter = refPyr.level[1].Y();
+
+  const Int quarterRange = std::max( g_hmeHalfRange, ( m_pcEncCfg->getSearchRange() + 3 ) >> 2 );
+
+  // full search at 1/4 resolution
+  const Int quarterW = ( curQuarter.width  + g_hmeBlockSize - 1 ) / g_hmeBlockSize;
+  const Int quarterH = ( curQuarter.height + g_hmeBlockSize - 1 ) / g_hmeBlockSize;
+  std::vector<Mv> quarterField( quarterW * quarterH );
+
+  for( Int by = 0; by < quarterH; by++ )
+  {
+    for( Int bx = 0; bx < quarterW; bx++ )
+    {
+      xSearchBlock( curQuarter, refQuarter, bx * g_hmeBlockSize, by * g_hmeBlockSize, Mv(), quarterRange, quarterField[by * quarterW + bx] );
+    }
+  }
+
+  // refinement at 1/2 resolution, each 1/4 resolution block covers 2x2 blocks
+  const Int halfW = ( curHalf.width  + g_hmeBlockSize - 1 ) / g_hmeBlockSize;
+  const Int halfH = ( curHalf.height + g_hmeBlockSize - 1 ) / g_hmeBlockSize;
+  std::vector<Mv> halfField( halfW * halfH );
+
+  for( Int by = 0; by < halfH; by++ )
+  {
+    for( Int bx = 0; bx < halfW; bx++ )
+    {
+      const Mv& parent = quarterField[std::min( by >> 1, quarterH - 1 ) * quarterW + std::min( bx >> 1, quarterW - 1 )];
+      xSearchBlock( curHalf, refHalf, bx * g_hmeBlockSize, by * g_hmeBlockSize, Mv( parent.hor << 1, parent.ver << 1 ), g_hmeHalfRange, halfField[by * halfW + bx] );
+    }
+  }
+
+  // refinement at full resolution
+  field.resize( m_widthInBlocks * m_heightInBlocks );
+
+  for( Int by = 0; by < m_heightInBlocks; by++ )
+  {
+    for( Int bx = 0; bx < m_widthInBlocks; bx++ )
+    {
+      const Mv& parent = halfField[std::min( by >> 1, halfH - 1 ) * halfW + std::min( bx >> 1, halfW - 1 )];
+      xSearchBlock( cur, ref, bx * g_hmeBlockSize, by * g_hmeBlockSize, Mv( parent.hor << 1, parent.ver << 1 ), g_hmeFullRange, field[by * m_widthInBlocks + bx] );
+    }
+  }
+}
+
+Void HierarchicalME::xSearchBlock( const CPelBuf& cur, const CPelBuf& ref, const Int x, const Int y, const Mv& start, const Int range, Mv& best )
+{
+  // blocks at the right and bottom border are moved inside the picture
+  const Int posX = std::min( x, Int( cur.width  ) - g_hmeBlockSize );
+  const Int posY = std::min( y, Int( cur.height ) - g_hmeBlockSize );
+
+  const Int minX = -posX, maxX = Int( ref.width  ) - g_hmeBlockSize - posX;
+  const Int minY = -posY, maxY = Int( ref.height ) - g_hmeBlockSize - posY;
+
+  const Int startX = Clip3( minX, maxX, Int( start.hor ) );
+  const Int startY = Clip3( minY, maxY, Int( start.ver ) );
+
+  m_pcRdCost->setDistParam( m_distParam, CPelBuf( cur.bufAt( posX, posY ), cur.stride, g_hmeBlockSize, g_hmeBlockSize ), ref.buf, ref.stride, m_bitDepth, COMPONENT_Y );
+
+  Distortion bestCost = std::numeric_limits<Distortion>::max();
+
+  for( Int dy = std::max( minY, startY - range ); dy <= std::min( maxY, startY + range ); dy++ )
+  {
+    for( Int dx = std::max( minX, startX - range ); dx <= std::min( maxX, startX + range ); dx++ )
+    {
+      m_distParam.cur.buf = ref.bufAt( posX + dx, posY + dy );
+
+      // small penalty on the distance to the start keeps the field smooth in flat areas
+      const Distortion cost = m_distParam.distFunc( m_distParam ) + ( abs( dx - startX ) + abs( dy - startY ) );
+
+      if( cost < bestCost )
+      {
+        bestCost = cost;
+        best     = Mv( dx, dy );
+      }
+    }
+  }
+}
+
+//! \}
@@ -0,0 +1,111 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     HierarchicalME.h
+    \brief    coarse motion field from downsampled pictures, used to start the integer motion search (header)
+*/
+
+#ifndef __HIERARCHICALME__
+#define __HIERARCHICALME__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/Mv.h"
+#include "CommonLib/RdCost.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+class EncCfg;
+class Slice;
+class Picture;
+struct PredictionUnit;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// builds 1/2 and 1/4 resolution pyramids of the current picture and its reference pictures (including the background
+/// reference) and estimates a coarse-to-fine integer motion field per 8x8 block for each reference
+class HierarchicalME
+{
+public:
+  HierarchicalME();
+
+  Void  init                ( EncCfg* pcEncCfg, RdCost* pcRdCost );
+  Void  destroy             ();
+  Void  invalidate          ()                                    { m_poc = MAX_INT; }            ///< the next build re-estimates the field, pixels of the picture or its references were rewritten
+
+  Void  build               ( const Slice& slice );                                               ///< motion field of the slice, kept if the slice and its references did not change
+  Bool  getMv               ( const PredictionUnit& pu, RefPicList refList, Int refIdx, Mv& mv ) const;   ///< integer-pel vector at the centre of the PU
+
+  static Int getRefineRange ( Int searchRange );                                                  ///< search range around a start vector taken from the motion field
+
+private:
+  static const Int NUM_LEVELS = 2;
+
+  struct Pyramid
+  {
+    PelStorage level[NUM_LEVELS];   ///< luma at 1/2 and 1/4 resolution
+  };
+
+  Void  xBuildPyramid       ( const CPelBuf& src, Pyramid& pyramid );
+  Void  xEstimateField      ( const CPelBuf& cur, const Pyramid& curPyr, const CPelBuf& ref, const Pyramid& refPyr, std::vector<Mv>& field );
+  Void  xSearchBlock        ( const CPelBuf& cur, const CPelBuf& ref, const Int x, const Int y, const Mv& start, const Int range, Mv& best );
+
+  EncCfg*       m_pcEncCfg;
+  RdCost*       m_pcRdCost;
+  DistParam     m_distParam;
+  Int           m_bitDepth;
+
+  // identification of the slice the field was estimated for
+  Int           m_poc;
+  const Picture* m_refPics[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+  Int           m_refPocs[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+  Int           m_numRefIdx[NUM_REF_PIC_LIST_01];
+
+  Int           m_widthInBlocks;
+  Int           m_heightInBlocks;
+  Pyramid       m_curPyramid;
+  Pyramid       m_refPyramids[NUM_REF_PIC_LIST_01 * MAX_NUM_REF];
+  std::vector<Mv> m_fields   [NUM_REF_PIC_LIST_01 * MAX_NUM_REF];
+  Int           m_fieldIdx   [NUM_REF_PIC_LIST_01][MAX_NUM_REF];     ///< field of each reference, references present in both lists share one
+};
+
+//! \}
+
+#endif // __HIERARCHICALME__
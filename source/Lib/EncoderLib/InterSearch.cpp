@@ -36,6 +36,7 @@
  */
 
 #include "InterSearch.h"
+#include "HierarchicalME.h"
 
 
 #include "CommonLib/CommonDef.h"
@@ -45,6 +46,8 @@
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/Profiler.h"
+#include "CommonLib/DiagLog.h"
 
 
 #include "EncModeCtrl.h"
@@ -90,6 +93,7 @@ InterSearch::InterSearch()
   , m_pFullCS                     (nullptr)
   , m_pcEncCfg                    (nullptr)
   , m_pcTrQuant                   (nullptr)
+  , m_pcHierarchicalME            (nullptr)
   , m_iSearchRange                (0)
   , m_bipredSearchRange           (0)
   , m_motionEstimationSearchMethod(MESEARCH_FULL)
@@ -868,6 +872,8 @@ Void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner, Bool
 Void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 #endif
 {
+  PROF_SCOPE( P_MOTION_ESTIMATION );
+
   CodingStructure& cs = *cu.cs;
 
   AMVPInfo     amvp[2];
@@ -1079,7 +1085,7 @@ Void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
       //  Bi-predictive Motion estimation
       if ( (cs.slice->isInterB()) && ( PU::isBipredRestriction(pu) == false)  && !bFastSkipBi )
       {
-		  cout << "inB";
+		  DIAG_LOG( DETAILS, "inB" );
         cMvBi[0] = cMv[0];
         cMvBi[1] = cMv[1];
         iRefIdxBi[0] = iRefIdx[0];
@@ -1390,6 +1396,8 @@ Void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 Void InterSearch::predInterSearchSel(CodingUnit& cu, Partitioner& partitioner,vector<int>& BgSelect)
 
 {
+	PROF_SCOPE( P_MOTION_ESTIMATION );
+
 	CodingStructure& cs = *cu.cs;
 
 	AMVPInfo     amvp[2];
@@ -2171,6 +2179,9 @@ Void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
   cStruct.pcPatternKey  = pcPatternKey;
   cStruct.iRefStride    = buf.stride;
   cStruct.piRefY        = buf.buf;
+
+  Mv cHierarchicalMv;
+  cStruct.pcHierarchicalMv = !bBi && m_pcHierarchicalME && m_pcHierarchicalME->getMv( pu, eRefPicList, iRefIdxPred, cHierarchicalMv ) ? &cHierarchicalMv : NULL;
   auto blkCache = dynamic_cast<CacheBlkInfoCtrl*>( m_modeCtrl );
 
   bool bQTBTMV  = false;
@@ -2462,6 +2473,25 @@ Void InterSearch::xTZSearch( const PredictionUnit& pu,
     xSetSearchRange( pu, currBestMv, m_iSearchRange>>(bFastSettings?1:0), sr );
   }
 
+  if( cStruct.pcHierarchicalMv )
+  {
+    Mv hierarchicalMv = *cStruct.pcHierarchicalMv;
+    hierarchicalMv <<= 2;
+    clipMv( hierarchicalMv, pu.cu->lumaPos(), *pu.cs->sps );
+    hierarchicalMv.divideByPowerOf2(2);
+
+    if( hierarchicalMv.getHor() != cStruct.iBestX || hierarchicalMv.getVer() != cStruct.iBestY )
+    {
+      xTZSearchHelp( cStruct, hierarchicalMv.getHor(), hierarchicalMv.getVer(), 0, 0 );
+    }
+
+    // the coarse search already covered the full range, only a narrow window around the best start is searched
+    iSearchRange = HierarchicalME::getRefineRange( m_iSearchRange );
+    Mv currBestMv( cStruct.iBestX, cStruct.iBestY );
+    currBestMv <<= 2;
+    xSetSearchRange( pu, currBestMv, iSearchRange, sr );
+  }
+
   // start search
   Int  iDist = 0;
   Int  iStartX = cStruct.iBestX;
@@ -2692,6 +2722,16 @@ Void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     xTZSearchHelp( cStruct, 0, 0, 0, 0 );
   }
 
+  if( cStruct.pcHierarchicalMv )
+  {
+    Mv hierarchicalMv = *cStruct.pcHierarchicalMv;
+    hierarchicalMv <<= 2;
+    clipMv( hierarchicalMv, pu.cu->lumaPos(), *pu.cs->sps );
+    hierarchicalMv.divideByPowerOf2(2);
+
+    xTZSearchHelp( cStruct, hierarchicalMv.getHor(), hierarchicalMv.getVer(), 0, 0 );
+  }
+
 #if HM_ME_SR_VIOLATION
   SearchRange sr = cStruct.searchRange;
 #else
@@ -62,6 +62,7 @@ static const UInt MAX_IDX_ADAPT_SR          = 33;
 static const UInt NUM_MV_PREDICTORS         = 3;
 
 class EncModeCtrl;
+class HierarchicalME;
 
 /// encoder search class
 class InterSearch : public InterPrediction, CrossComponentPrediction
@@ -89,6 +90,7 @@ protected:
 
   // interface to classes
   TrQuant*        m_pcTrQuant;
+  const HierarchicalME* m_pcHierarchicalME;
 
   // ME parameters
   Int             m_iSearchRange;
@@ -132,6 +134,7 @@ public:
   Void destroy                      ();
 
   Void setTempBuffers               (CodingStructure ****pSlitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS );
+  Void setHierarchicalME            ( const HierarchicalME* pcHierarchicalME ) { m_pcHierarchicalME = pcHierarchicalME; }
 
 #if ENABLE_SPLIT_PARALLELISM
   Void copyState                    ( const InterSearch& other );
@@ -163,6 +166,7 @@ protected:
     Distortion  uiBestSad;
     UChar       ucPointNr;
     Int         subShiftMode;
+    const Mv*   pcHierarchicalMv;   ///< integer-pel start from the hierarchical ME, NULL if not available
   } IntTZSearchStruct;
 
   // sub-functions for ME
@@ -38,6 +38,7 @@
 #include "IntraSearch.h"
 
 #include "EncModeCtrl.h"
+#include "GradientAnalysis.h"
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Rom.h"
@@ -55,6 +56,7 @@
 
 IntraSearch::IntraSearch()
   : m_modeCtrl      (nullptr)
+  , m_pcGradientAnalysis(nullptr)
   , m_pSplitCS      (nullptr)
   , m_pFullCS       (nullptr)
   , m_pBestCS       (nullptr)
@@ -364,6 +366,20 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
         bool bSatdChecked[NUM_INTRA_MODE];
         memset( bSatdChecked, 0, sizeof( bSatdChecked ) );
 
+        // restrict the angular modes to the dominant gradient directions of the original
+        Bool gradientModes[NUM_LUMA_MODE];
+        Bool useGradientModes = m_pcGradientAnalysis && m_pcGradientAnalysis->getCandidates( *cs.slice, area, gradientModes );
+
+        if( useGradientModes )
+        {
+          Int numGradientModes = 0;
+          for( Int mode = 0; mode < NUM_LUMA_MODE; mode++ )
+          {
+            numGradientModes += gradientModes[mode] ? 1 : 0;
+          }
+          useGradientModes = numGradientModes >= numModesForFullRD;
+        }
+
         {
           for( Int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
           {
@@ -375,6 +391,10 @@ Void IntraSearch::estIntraPredLumaQT( CodingUnit &cu, Partitioner &partitioner )
             {
               continue;
             }
+            if( useGradientModes && !gradientModes[uiMode] )
+            {
+              continue;
+            }
 
             bSatdChecked[uiMode] = true;
 
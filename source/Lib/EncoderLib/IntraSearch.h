@@ -57,12 +57,14 @@
 // ====================================================================================================================
 
 class EncModeCtrl;
+class GradientAnalysis;
 
 /// encoder search class
 class IntraSearch : public IntraPrediction, CrossComponentPrediction
 {
 private:
   EncModeCtrl    *m_modeCtrl; //we need this to call the saveLoadTag functions for the EMT
+  const GradientAnalysis* m_pcGradientAnalysis;
   Pel*            m_pSharedPredTransformSkip[MAX_NUM_TBLOCKS];
 
   XUCache         m_unitCache;
@@ -111,6 +113,7 @@ public:
   CodingStructure  **getSaveCSBuf () { return m_pSaveCS; }
 
   void setModeCtrl                (EncModeCtrl *modeCtrl) { m_modeCtrl = modeCtrl; }
+  void setGradientAnalysis        ( const GradientAnalysis* pcGradientAnalysis ) { m_pcGradientAnalysis = pcGradientAnalysis; }
 
 public:
 
@@ -34,6 +34,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "CommonLib/NAL.h"
 #include "CommonLib/BitStream.h"
@@ -89,25 +90,28 @@ Void write(ostream& out, OutputNALUnit& nalu)
   vector<uint8_t> outputBuffer;
   outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
   std::size_t outputAmount = 0;
-  Int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+
+  /* copy the payload in blocks up to and including each pair of zero bytes,
+   * only such a pair followed by a byte <= 3 needs an emulation_prevention_three_byte */
+  const uint8_t* src = rbsp.data();
+  const uint8_t* end = src + rbsp.size();
+  while (src < end)
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
+    const uint8_t* zeros = src;
+    while ((zeros = (const uint8_t*) memchr(zeros, 0, end - zeros)) != NULL && zeros + 1 < end && zeros[1] != 0)
     {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-      zeroCount=0;
+      zeros += 2;
     }
 
-    if (v==0)
-    {
-      zeroCount++;
-    }
-    else
+    const uint8_t* blockEnd = (zeros == NULL || zeros + 1 >= end) ? end : zeros + 2;
+    memcpy(&outputBuffer[outputAmount], src, blockEnd - src);
+    outputAmount += blockEnd - src;
+    src           = blockEnd;
+
+    if (src < end && *src <= 3)
     {
-      zeroCount=0;
+      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
     }
-    outputBuffer[outputAmount++]=v;
   }
 
   /* 7.4.1.1
@@ -115,7 +119,7 @@ Void write(ostream& out, OutputNALUnit& nalu)
    * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
    * to 0x03 is appended to the end of the data.
    */
-  if (zeroCount>0)
+  if (!rbsp.empty() && rbsp.back() == 0)
   {
     outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
   }
@@ -0,0 +1,157 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2017, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+/** \file     SpeedGovernor.cpp
+    \brief    run-time adaptation of the encoder effort to a target frame rate
+*/
+
+#include "SpeedGovernor.h"
+#include "EncLib.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+static const SpeedLevelParams g_speedLevelParams[] =
+{
+  // SR shift, fast, MTT reduction, dQP RD, RDOQ,  SAO,   BG shift
+  { 0,         false, 0,            true,   true,  true,  0 },
+  { 1,         true,  0,            false,  true,  true,  0 },
+  { 1,         true,  1,            false,  true,  true,  1 },
+  { 2,         true,  1,            false,  false, true,  1 },
+  { 3,         true,  2,            false,  false, false, 2 },
+};
+
+static const Int    g_speedMaxLevel       = sizeof( g_speedLevelParams ) / sizeof( g_speedLevelParams[0] ) - 1;
+static const Double g_speedSmoothWeight   = 0.25;   ///< weight of the newest picture in the smoothed encoding time
+static const Double g_speedRaiseLoad      = 1.0;    ///< lower the effort above this load
+static const Double g_speedLowerLoad      = 0.75;   ///< raise the effort below this load
+static const Int    g_speedHoldPictures   = 4;      ///< pictures between two level changes
+
+SpeedGovernor::SpeedGovernor()
+  : m_pcEncLib    ( nullptr )
+  , m_enabled     ( false )
+  , m_targetFps   ( 0 )
+  , m_level       ( 0 )
+  , m_pictureLevel( 0 )
+  , m_avgTime     ( 0 )
+  , m_numPictures ( 0 )
+  , m_holdPictures( 0 )
+{
+}
+
+Void SpeedGovernor::init( EncLib* pcEncLib )
+{
+  m_pcEncLib     = pcEncLib;
+  m_enabled      = pcEncLib->getUseSpeedGovernor();
+  m_targetFps    = pcEncLib->getSpeedGovernorFps() > 0 ? pcEncLib->getSpeedGovernorFps() : Double( pcEncLib->getFrameRate() ) / pcEncLib->getTemporalSubsampleRatio();
+  m_level        = 0;
+  m_pictureLevel = 0;
+  m_avgTime      = 0;
+  m_numPictures  = 0;
+  m_holdPictures = 0;
+
+  m_searchRange             = pcEncLib->getSearchRange();
+  m_useEarlySkipDetection   = pcEncLib->getUseEarlySkipDetection();
+  m_useEarlyCU              = pcEncLib->getUseEarlyCU();
+  m_useFastDecisionForMerge = pcEncLib->getUseFastDecisionForMerge();
+  m_useCbfFastMode          = pcEncLib->getUseCbfFastMode();
+  m_usePbIntraFast          = pcEncLib->getUsePbIntraFast();
+  m_useContentBasedFastQtbt = pcEncLib->getUseContentBasedFastQtbt();
+  m_deltaQpRD               = pcEncLib->getDeltaQpRD();
+  m_useRDOQ                 = pcEncLib->getUseRDOQ();
+}
+
+Void SpeedGovernor::addPicture( Double encTime )
+{
+  m_pictureLevel = m_level;
+  m_avgTime      = m_numPictures++ == 0 ? encTime : ( 1.0 - g_speedSmoothWeight ) * m_avgTime + g_speedSmoothWeight * encTime;
+
+  if( m_holdPictures > 0 )
+  {
+    m_holdPictures--;
+    return;
+  }
+
+  const Double load = getLoad();
+  if( load > g_speedRaiseLoad && m_level < g_speedMaxLevel )
+  {
+    xApplyLevel( m_level + 1 );
+  }
+  else if( load < g_speedLowerLoad && m_level > 0 )
+  {
+    xApplyLevel( m_level - 1 );
+  }
+}
+
+Bool SpeedGovernor::getUseSAO() const
+{
+  return g_speedLevelParams[m_level].sao;
+}
+
+Int SpeedGovernor::getBgBlockBudget( Int configured ) const
+{
+  return configured >> g_speedLevelParams[m_level].bgBlockBudgetShift;
+}
+
+Void SpeedGovernor::xApplyLevel( Int level )
+{
+  const SpeedLevelParams& params = g_speedLevelParams[level];
+
+  m_level        = level;
+  m_holdPictures = g_speedHoldPictures;
+
+  m_pcEncLib->setSearchRange            ( std::max( m_searchRange >> params.searchRangeShift, std::min( m_searchRange, m_pcEncLib->getMinSearchWindow() ) ) );
+  m_pcEncLib->setUseEarlySkipDetection  ( m_useEarlySkipDetection   || params.fastDecisions );
+  m_pcEncLib->setUseEarlyCU             ( m_useEarlyCU              || params.fastDecisions );
+  m_pcEncLib->setUseFastDecisionForMerge( m_useFastDecisionForMerge || params.fastDecisions );
+  m_pcEncLib->setUseCbfFastMode         ( m_useCbfFastMode          || params.fastDecisions );
+  m_pcEncLib->setUsePbIntraFast         ( m_usePbIntraFast          || params.fastDecisions );
+  m_pcEncLib->setUseContentBasedFastQtbt( m_useContentBasedFastQtbt || params.fastDecisions );
+  m_pcEncLib->setDeltaQpRD              ( params.deltaQpRD ? m_deltaQpRD : 0 );
+  m_pcEncLib->setUseRDOQ                ( m_useRDOQ && params.rdoq );
+
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for( Int jId = 0; jId < m_pcEncLib->getNumCuEncStacks(); jId++ )
+  {
+    m_pcEncLib->getTrQuant( jId )->getQuant()->setUseRDOQ( m_useRDOQ && params.rdoq );
+    m_pcEncLib->getCuEncoder( jId )->getModeCtrl()->setMtDepthReduction( params.mtDepthReduction );
+  }
+#else
+  m_pcEncLib->getTrQuant()->getQuant()->setUseRDOQ( m_useRDOQ && params.rdoq );
+  m_pcEncLib->getCuEncoder()->getModeCtrl()->setMtDepthReduction( params.mtDepthReduction );
+#endif
+}
+
+//! \}
@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     SpeedGovernor.h
+    \brief    run-time adaptation of the encoder effort to a target frame rate (header)
+*/
+
+#ifndef __SPEEDGOVERNOR__
+#define __SPEEDGOVERNOR__
+
+#include "CommonLib/CommonDef.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+class EncLib;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// encoder effort of one speed level, level 0 is the configured effort
+struct SpeedLevelParams
+{
+  Int   searchRangeShift;      ///< search range divided by 2^searchRangeShift
+  Bool  fastDecisions;         ///< force the fast mode decision switches on
+  Int   mtDepthReduction;      ///< multi-type tree depths not searched
+  Bool  deltaQpRD;             ///< keep the slice level delta QP RD passes
+  Bool  rdoq;                  ///< keep RDOQ
+  Bool  sao;                   ///< keep the SAO estimation
+  Int   bgBlockBudgetShift;    ///< background block budget divided by 2^bgBlockBudgetShift
+};
+
+/// measures the encoding time of each picture and lowers or raises the encoder effort to keep up with the target frame rate
+class SpeedGovernor
+{
+public:
+  SpeedGovernor();
+
+  Void  init                ( EncLib* pcEncLib );
+  Bool  isEnabled           () const { return m_enabled; }
+
+  Void  addPicture          ( Double encTime );                                        ///< account the encoding time of a picture in seconds, may change the level
+
+  Int   getLevel            () const { return m_level; }
+  Int   getPictureLevel     () const { return m_pictureLevel; }                       ///< level the last accounted picture was coded with
+  Double getLoad            () const { return m_avgTime * m_targetFps; }              ///< smoothed encoding time relative to the frame period
+
+  Bool  getUseSAO           () const;
+  Int   getBgBlockBudget    ( Int configured ) const;
+
+private:
+  Void  xApplyLevel         ( Int level );
+
+  EncLib* m_pcEncLib;
+  Bool    m_enabled;
+  Double  m_targetFps;
+  Int     m_level;
+  Int     m_pictureLevel;
+  Double  m_avgTime;
+  Int     m_numPictures;
+  Int     m_holdPictures;
+
+  // configured effort restored at level 0
+  Int     m_searchRange;
+  Bool    m_useEarlySkipDetection;
+  Bool    m_useEarlyCU;
+  Bool    m_useFastDecisionForMerge;
+  Bool    m_useCbfFastMode;
+  Bool    m_usePbIntraFast;
+  Bool    m_useContentBasedFastQtbt;
+  UInt    m_deltaQpRD;
+  Bool    m_useRDOQ;
+};
+
+//! \}
+
+#endif // __SPEEDGOVERNOR__
@@ -41,6 +41,14 @@
 #include <fstream>
 #include <iostream>
 #include <memory.h>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
 
 #include "CommonLib/Rom.h"
 #include "VideoIOYuv.h"
@@ -54,6 +62,113 @@ using namespace std;
 // Local Functions
 // ====================================================================================================================
 
+/**
+ * Read-only stream buffer over a memory mapped file. The whole file is the get
+ * area, so reading a line is a plain copy out of the page cache without a
+ * system call, and seeking only moves the read pointer.
+ */
+class MappedFileBuf : public std::streambuf
+{
+public:
+  MappedFileBuf() : m_data( nullptr ), m_size( 0 ) {}
+  ~MappedFileBuf() { close(); }
+
+  Bool open ( const std::string &fileName );
+  Void close();
+
+protected:
+  virtual pos_type seekoff( off_type off, ios_base::seekdir dir, ios_base::openmode which );
+  virtual pos_type seekpos( pos_type pos, ios_base::openmode which ) { return seekoff( off_type( pos ), ios_base::beg, which ); }
+
+private:
+  char*       m_data;
+  std::size_t m_size;
+};
+
+Bool MappedFileBuf::open( const std::string &fileName )
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+  if( file == INVALID_HANDLE_VALUE )
+  {
+    return false;
+  }
+
+  LARGE_INTEGER fileSize;
+  Bool ok = GetFileSizeEx( file, &fileSize ) != 0;
+  if( ok && fileSize.QuadPart > 0 )
+  {
+    // the view keeps the mapping alive after the handles are closed
+    HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    m_data = mapping ? ( char* ) MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+    m_size = m_data ? std::size_t( fileSize.QuadPart ) : 0;
+    ok     = m_data != nullptr;
+    if( mapping )
+    {
+      CloseHandle( mapping );
+    }
+  }
+  CloseHandle( file );
+#else
+  const int file = ::open( fileName.c_str(), O_RDONLY );
+  if( file < 0 )
+  {
+    return false;
+  }
+
+  struct stat fileStat;
+  Bool ok = fstat( file, &fileStat ) == 0;
+  if( ok && fileStat.st_size > 0 )
+  {
+    // the mapping stays valid after the file is closed
+    void* data = mmap( NULL, std::size_t( fileStat.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+    ok = data != MAP_FAILED;
+    if( ok )
+    {
+      madvise( data, std::size_t( fileStat.st_size ), MADV_SEQUENTIAL );
+      m_data = ( char* ) data;
+      m_size = std::size_t( fileStat.st_size );
+    }
+  }
+  ::close( file );
+#endif
+
+  setg( m_data, m_data, m_data + m_size );
+  return ok;
+}
+
+Void MappedFileBuf::close()
+{
+  if( m_data )
+  {
+#ifdef _WIN32
+    UnmapViewOfFile( m_data );
+#else
+    munmap( m_data, m_size );
+#endif
+  }
+
+  m_data = nullptr;
+  m_size = 0;
+  setg( nullptr, nullptr, nullptr );
+}
+
+MappedFileBuf::pos_type MappedFileBuf::seekoff( off_type off, ios_base::seekdir dir, ios_base::openmode which )
+{
+  const off_type base = dir == ios_base::beg ? 0 : ( dir == ios_base::cur ? off_type( gptr() - eback() ) : off_type( m_size ) );
+  const off_type pos  = base + off;
+
+  if( !( which & ios_base::in ) || pos < 0 || pos > off_type( m_size ) )
+  {
+    return pos_type( off_type( -1 ) );
+  }
+
+  setg( m_data, m_data + pos, m_data + m_size );
+  return pos_type( pos );
+}
+
 /**
  * Scale all pixels in img depending upon sign of shiftbits by a factor of
  * 2<sup>shiftbits</sup>.
@@ -124,7 +239,7 @@ static Void scalePlane( PelBuf& areaBuf, const Int shiftbits, const Pel minval,
  * \param MSBExtendedBitDepth
  * \param internalBitDepth bit-depth array to scale image data to/from when reading/writing.
  */
-Void VideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] )
+Void VideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE], const Bool bMemoryMapped )
 {
   //NOTE: files cannot have bit depth greater than 16
   for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
@@ -155,6 +270,26 @@ Void VideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int f
       EXIT( "failed to write reconstructed YUV file" );
     }
   }
+  else if( fileName == "-" )
+  {
+#ifdef _WIN32
+    _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+    // read from stdin through the same stream, frames are skipped by consuming the input as it is not seekable
+    static_cast<std::ios&>( m_cHandle ).rdbuf( std::cin.rdbuf() );
+  }
+  else if( bMemoryMapped )
+  {
+    m_mappedBuf = new MappedFileBuf;
+
+    if( !m_mappedBuf->open( fileName ) )
+    {
+      EXIT( "failed to map Input YUV file");
+    }
+
+    // redirect the stream to the mapping, all reading and seeking below is unchanged
+    static_cast<std::ios&>( m_cHandle ).rdbuf( m_mappedBuf );
+  }
   else
   {
     m_cHandle.open( fileName.c_str(), ios::binary | ios::in );
@@ -168,11 +303,42 @@ Void VideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int f
   return;
 }
 
+VideoIOYuv::~VideoIOYuv()
+{
+  if( xIsRedirected() )
+  {
+    close();
+  }
+}
+
+Bool VideoIOYuv::xIsRedirected()
+{
+  return static_cast<std::ios&>( m_cHandle ).rdbuf() != m_cHandle.rdbuf();
+}
+
 Void VideoIOYuv::close()
 {
+  if( xIsRedirected() )
+  {
+    // restore the file buffer of the stream after reading from a mapping or stdin
+    static_cast<std::ios&>( m_cHandle ).rdbuf( m_cHandle.rdbuf() );
+    delete m_mappedBuf;
+    m_mappedBuf = nullptr;
+    return;
+  }
+
   m_cHandle.close();
 }
 
+Bool VideoIOYuv::isNullDevice( const std::string &fileName )
+{
+#ifdef _WIN32
+  return fileName == "NUL" || fileName == "nul";
+#else
+  return fileName == "/dev/null";
+#endif
+}
+
 Bool VideoIOYuv::isEof()
 {
   return m_cHandle.eof();
@@ -50,20 +50,25 @@ using namespace std;
 // Class definition
 // ====================================================================================================================
 
+class MappedFileBuf;
+
 /// YUV file I/O class
 class VideoIOYuv
 {
 private:
   fstream   m_cHandle;                                      ///< file handle
+  MappedFileBuf* m_mappedBuf;                               ///< memory mapped input file, replaces the file buffer of m_cHandle
   Int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   Int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   Int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
 
+  Bool      xIsRedirected();                                ///< the stream reads from a mapping or stdin instead of its file buffer
+
 public:
-  VideoIOYuv()           {}
-  virtual ~VideoIOYuv()  {}
+  VideoIOYuv() : m_mappedBuf( nullptr ) {}
+  virtual ~VideoIOYuv();
 
-  Void  open  ( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
+  Void  open  ( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE], const Bool bMemoryMapped = false ); ///< open or create file, input files can be memory mapped, "-" reads from stdin
   Void  close ();                                           ///< close file
 
   Void skipFrames(UInt numFrames, UInt width, UInt height, ChromaFormat format);
@@ -80,6 +85,7 @@ public:
 
   // If fileFormat=NUM_CHROMA_FORMAT, use the format defined by pPicYuvTop and pPicYuvBottom
   Bool  write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot, const InputColourSpaceConversion ipCSC, Int confLeft=0, Int confRight=0, Int confTop=0, Int confBottom=0, ChromaFormat fileFormat=NUM_CHROMA_FORMAT, const Bool isTff=false, const Bool bClipToRec709=false);
+  static Bool isNullDevice( const std::string &fileName );   ///< check for the null device, writing to it can be skipped entirely
   static Void ColourSpaceConvert(const CPelUnitBuf &src, PelUnitBuf &dest, const InputColourSpaceConversion conversion, Bool bIsForwards);
 
   Bool  isEof ();                                           ///< check for end-of-file
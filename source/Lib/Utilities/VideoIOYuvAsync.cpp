@@ -0,0 +1,333 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     VideoIOYuvAsync.cpp
+    \brief    asynchronous YUV file reading and writing
+*/
+
+#include "VideoIOYuvAsync.h"
+
+VideoIOYuvAsyncReader::VideoIOYuvAsyncReader()
+  : m_numQueued( 0 )
+  , m_numInUse ( 0 )
+  , m_readIdx  ( 0 )
+  , m_writeIdx ( 0 )
+  , m_done     ( true )
+  , m_abort    ( false )
+{
+}
+
+VideoIOYuvAsyncReader::~VideoIOYuvAsyncReader()
+{
+  stop();
+}
+
+Void VideoIOYuvAsyncReader::start( const UnitArea& area, Int numBuffers, Int numFrames, ReadFunc readFunc )
+{
+  CHECK( m_thread.joinable(), "Asynchronous reader already started" );
+  CHECK( numBuffers < 2, "Asynchronous reading needs at least two buffers" );
+
+  m_frames.resize( numBuffers );
+  for( auto &frame : m_frames )
+  {
+    frame = new Frame;
+    frame->pic       .create( area );
+    frame->picTrueOrg.create( area );
+    frame->valid = false;
+  }
+
+  m_readFunc  = readFunc;
+  m_numQueued = 0;
+  m_numInUse  = 0;
+  m_readIdx   = 0;
+  m_writeIdx  = 0;
+  m_done      = false;
+  m_abort     = false;
+
+  m_thread = std::thread( &VideoIOYuvAsyncReader::xReadLoop, this, numFrames );
+}
+
+Void VideoIOYuvAsyncReader::stop()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_abort = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  for( auto &frame : m_frames )
+  {
+    frame->pic       .destroy();
+    frame->picTrueOrg.destroy();
+    delete frame;
+  }
+  m_frames.clear();
+}
+
+Void VideoIOYuvAsyncReader::xReadLoop( Int numFrames )
+{
+  const Int numBuffers = Int( m_frames.size() );
+
+  for( Int i = 0; i < numFrames; i++ )
+  {
+    Frame* frame = nullptr;
+    {
+      // the acquired frame may still be referenced by the caller
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cond.wait( lock, [&] { return m_abort || m_numQueued + m_numInUse < numBuffers; } );
+      if( m_abort )
+      {
+        break;
+      }
+      frame = m_frames[m_writeIdx];
+    }
+
+    // the file is only accessed from this thread while reading
+    frame->valid = m_readFunc( frame->pic, frame->picTrueOrg );
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_writeIdx = ( m_writeIdx + 1 ) % numBuffers;
+      m_numQueued++;
+    }
+    m_cond.notify_all();
+
+    if( !frame->valid )
+    {
+      break;
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_done = true;
+  }
+  m_cond.notify_all();
+}
+
+Bool VideoIOYuvAsyncReader::acquire( PelStorage*& pic, PelStorage*& picTrueOrg )
+{
+  CHECK( m_numInUse > 0, "Previous picture has not been released" );
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [&] { return m_numQueued > 0 || m_done; } );
+
+  if( m_numQueued == 0 )
+  {
+    // more pictures were requested than have been read
+    pic        = nullptr;
+    picTrueOrg = nullptr;
+    return false;
+  }
+
+  Frame* frame = m_frames[m_readIdx];
+  m_readIdx    = ( m_readIdx + 1 ) % Int( m_frames.size() );
+  m_numQueued--;
+  m_numInUse++;
+
+  pic        = &frame->pic;
+  picTrueOrg = &frame->picTrueOrg;
+  return frame->valid;
+}
+
+Void VideoIOYuvAsyncReader::release()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if( m_numInUse == 0 )
+    {
+      return;
+    }
+    m_numInUse--;
+  }
+  m_cond.notify_all();
+}
+
+VideoIOYuvAsyncWriter::VideoIOYuvAsyncWriter()
+  : m_numQueued( 0 )
+  , m_readIdx  ( 0 )
+  , m_writeIdx ( 0 )
+  , m_done     ( false )
+{
+}
+
+VideoIOYuvAsyncWriter::~VideoIOYuvAsyncWriter()
+{
+  stop();
+}
+
+Void VideoIOYuvAsyncWriter::start( Int numBuffers )
+{
+  CHECK( m_thread.joinable(), "Asynchronous writer already started" );
+
+  if( numBuffers <= 0 )
+  {
+    return;
+  }
+
+  // the buffers are allocated with the first picture written into them
+  m_frames.resize( numBuffers );
+  for( auto &frame : m_frames )
+  {
+    frame = new Frame;
+    frame->isField = false;
+  }
+
+  m_numQueued = 0;
+  m_readIdx   = 0;
+  m_writeIdx  = 0;
+  m_done      = false;
+
+  m_thread = std::thread( &VideoIOYuvAsyncWriter::xWriteLoop, this );
+}
+
+Void VideoIOYuvAsyncWriter::stop()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_done = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  for( auto &frame : m_frames )
+  {
+    frame->pic      .destroy();
+    frame->picBottom.destroy();
+    delete frame;
+  }
+  m_frames.clear();
+}
+
+Void VideoIOYuvAsyncWriter::xCopy( PelStorage& dst, const CPelUnitBuf& src )
+{
+  if( dst.bufs.empty() || dst.chromaFormat != src.chromaFormat || dst.Y().width != src.Y().width || dst.Y().height != src.Y().height )
+  {
+    dst.destroy();
+    dst.create( src.chromaFormat, Area( Position(), src.Y() ) );
+  }
+
+  dst.copyFrom( src );
+}
+
+Void VideoIOYuvAsyncWriter::write( const CPelUnitBuf& pic, WriteFunc writeFunc )
+{
+  if( m_frames.empty() )
+  {
+    writeFunc( pic, CPelUnitBuf() );
+    return;
+  }
+
+  Frame* frame = nullptr;
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [&] { return m_numQueued < Int( m_frames.size() ); } );
+    frame = m_frames[m_writeIdx];
+  }
+
+  // the copy is taken on the calling thread, the picture can be reused as soon as this returns
+  xCopy( frame->pic, pic );
+  frame->isField   = false;
+  frame->writeFunc = writeFunc;
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_writeIdx = ( m_writeIdx + 1 ) % Int( m_frames.size() );
+    m_numQueued++;
+  }
+  m_cond.notify_all();
+}
+
+Void VideoIOYuvAsyncWriter::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom, WriteFunc writeFunc )
+{
+  if( m_frames.empty() )
+  {
+    writeFunc( picTop, picBottom );
+    return;
+  }
+
+  Frame* frame = nullptr;
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [&] { return m_numQueued < Int( m_frames.size() ); } );
+    frame = m_frames[m_writeIdx];
+  }
+
+  xCopy( frame->pic,       picTop );
+  xCopy( frame->picBottom, picBottom );
+  frame->isField   = true;
+  frame->writeFunc = writeFunc;
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_writeIdx = ( m_writeIdx + 1 ) % Int( m_frames.size() );
+    m_numQueued++;
+  }
+  m_cond.notify_all();
+}
+
+Void VideoIOYuvAsyncWriter::xWriteLoop()
+{
+  const Int numBuffers = Int( m_frames.size() );
+
+  while( true )
+  {
+    Frame* frame = nullptr;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cond.wait( lock, [&] { return m_numQueued > 0 || m_done; } );
+      if( m_numQueued == 0 )
+      {
+        break;
+      }
+      frame = m_frames[m_readIdx];
+    }
+
+    frame->writeFunc( frame->pic, frame->isField ? CPelUnitBuf( frame->picBottom ) : CPelUnitBuf() );
+    frame->writeFunc = nullptr;
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_readIdx = ( m_readIdx + 1 ) % numBuffers;
+      m_numQueued--;
+    }
+    m_cond.notify_all();
+  }
+}
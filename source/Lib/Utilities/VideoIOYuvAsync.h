@@ -0,0 +1,132 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     VideoIOYuvAsync.h
+    \brief    asynchronous YUV file reading and writing (header)
+*/
+
+#ifndef __VIDEOIOYUVASYNC__
+#define __VIDEOIOYUVASYNC__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+#include "CommonLib/Buffer.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reads input pictures ahead of the encoder on a separate thread into a ring of picture buffers
+class VideoIOYuvAsyncReader
+{
+public:
+  /// reads the next picture, returns false at the end of the input
+  typedef std::function<Bool( PelStorage& pic, PelStorage& picTrueOrg )> ReadFunc;
+
+  VideoIOYuvAsyncReader();
+  ~VideoIOYuvAsyncReader();
+
+  Void start  ( const UnitArea& area, Int numBuffers, Int numFrames, ReadFunc readFunc ); ///< allocate the buffers and start reading
+  Void stop   ();                                                                      ///< stop the reader thread and free the buffers
+
+  Bool acquire( PelStorage*& pic, PelStorage*& picTrueOrg );                           ///< wait for the next picture, false at the end of the input
+  Void release();                                                                      ///< hand the acquired picture back for reading
+
+private:
+  struct Frame
+  {
+    PelStorage pic;
+    PelStorage picTrueOrg;
+    Bool       valid;
+  };
+
+  Void xReadLoop( Int numFrames );
+
+  std::vector<Frame*>     m_frames;
+  ReadFunc                m_readFunc;
+  std::thread             m_thread;
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  Int                     m_numQueued;    ///< frames read and not yet acquired
+  Int                     m_numInUse;     ///< frames acquired and not yet released
+  Int                     m_readIdx;      ///< next frame to be acquired
+  Int                     m_writeIdx;     ///< next frame to be read into
+  Bool                    m_done;         ///< no more frames are read
+  Bool                    m_abort;
+};
+
+/// writes output pictures on a separate thread from a bounded queue of picture copies
+class VideoIOYuvAsyncWriter
+{
+public:
+  /// writes a frame, or a pair of fields, the bottom field is empty for frames
+  typedef std::function<Void( const CPelUnitBuf& pic, const CPelUnitBuf& picBottom )> WriteFunc;
+
+  VideoIOYuvAsyncWriter();
+  ~VideoIOYuvAsyncWriter();
+
+  Void start  ( Int numBuffers );                                                      ///< start the writer thread, no thread is used for 0 buffers
+  Void stop   ();                                                                      ///< write all queued pictures and stop the writer thread
+
+  Void write  ( const CPelUnitBuf& pic, WriteFunc writeFunc );                         ///< queue a frame for writing
+  Void write  ( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom, WriteFunc writeFunc ); ///< queue a pair of fields for writing
+
+private:
+  struct Frame
+  {
+    PelStorage pic;
+    PelStorage picBottom;
+    Bool       isField;
+    WriteFunc  writeFunc;
+  };
+
+  Void xWriteLoop();
+  Void xCopy     ( PelStorage& dst, const CPelUnitBuf& src );
+
+  std::vector<Frame*>     m_frames;
+  std::thread             m_thread;
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  Int                     m_numQueued;    ///< frames copied and not yet written
+  Int                     m_readIdx;      ///< next frame to be written
+  Int                     m_writeIdx;     ///< next frame to be copied into
+  Bool                    m_done;         ///< no more frames are queued
+};
+
+#endif // __VIDEOIOYUVASYNC__